@@ -0,0 +1,153 @@
+// ZMEM Allocation Counting
+// Replaces the global operator new/delete with malloc-backed versions that count
+// allocations and bytes per thread, plus a std::pmr::memory_resource that counts what
+// goes through it. Include in exactly one translation unit per program (the
+// replacement operators are not inline).
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+
+namespace zmem {
+
+struct allocation_stats {
+   uint64_t allocations{};
+   uint64_t deallocations{};
+   uint64_t bytes{}; // Requested bytes, not counting deallocations
+
+   allocation_stats operator-(const allocation_stats& before) const noexcept {
+      return {allocations - before.allocations, deallocations - before.deallocations, bytes - before.bytes};
+   }
+};
+
+namespace detail {
+
+// Per-thread, so counting adds no contention of its own
+inline allocation_stats& thread_allocation_stats() noexcept {
+   static thread_local allocation_stats stats;
+   return stats;
+}
+
+inline void* counted_alloc(size_t size, size_t alignment) noexcept {
+   auto& stats = thread_allocation_stats();
+   ++stats.allocations;
+   stats.bytes += size;
+   if (size == 0) size = 1;
+   if (alignment <= alignof(std::max_align_t)) return std::malloc(size);
+#if defined(_WIN32)
+   return _aligned_malloc(size, alignment);
+#else
+   void* p = nullptr;
+   return ::posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+#endif
+}
+
+// The replacement operators free what they allocate with malloc; GCC 12 sees the free()
+// inlined after a call to operator new and reports a mismatch
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+inline void counted_free(void* p, bool aligned) noexcept {
+   if (!p) return;
+   ++thread_allocation_stats().deallocations;
+#if defined(_WIN32)
+   if (aligned) {
+      _aligned_free(p);
+      return;
+   }
+#else
+   (void)aligned;
+#endif
+   std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+} // namespace detail
+
+// Operator new/delete calls made by the calling thread so far
+inline allocation_stats thread_allocations() noexcept { return detail::thread_allocation_stats(); }
+
+// Counts allocations passed to `upstream`. Not thread-safe, like the pmr pool resources.
+class counting_resource : public std::pmr::memory_resource {
+  public:
+   explicit counting_resource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+      : upstream_(upstream) {}
+
+   const allocation_stats& stats() const noexcept { return stats_; }
+   void reset() noexcept { stats_ = {}; }
+
+  private:
+   void* do_allocate(size_t bytes, size_t alignment) override {
+      ++stats_.allocations;
+      stats_.bytes += bytes;
+      return upstream_->allocate(bytes, alignment);
+   }
+
+   void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+      ++stats_.deallocations;
+      upstream_->deallocate(p, bytes, alignment);
+   }
+
+   bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+   std::pmr::memory_resource* upstream_;
+   allocation_stats stats_{};
+};
+
+} // namespace zmem
+
+// ============================================================================
+// Replacement Operators
+// ============================================================================
+
+void* operator new(size_t size) {
+   if (void* p = zmem::detail::counted_alloc(size, 0)) return p;
+   throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size) {
+   if (void* p = zmem::detail::counted_alloc(size, 0)) return p;
+   throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+   if (void* p = zmem::detail::counted_alloc(size, size_t(alignment))) return p;
+   throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+   if (void* p = zmem::detail::counted_alloc(size, size_t(alignment))) return p;
+   throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return zmem::detail::counted_alloc(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return zmem::detail::counted_alloc(size, 0); }
+
+void operator delete(void* p) noexcept { zmem::detail::counted_free(p, false); }
+void operator delete[](void* p) noexcept { zmem::detail::counted_free(p, false); }
+void operator delete(void* p, size_t) noexcept { zmem::detail::counted_free(p, false); }
+void operator delete[](void* p, size_t) noexcept { zmem::detail::counted_free(p, false); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { zmem::detail::counted_free(p, false); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { zmem::detail::counted_free(p, false); }
+
+void operator delete(void* p, std::align_val_t alignment) noexcept {
+   zmem::detail::counted_free(p, size_t(alignment) > alignof(std::max_align_t));
+}
+void operator delete[](void* p, std::align_val_t alignment) noexcept {
+   zmem::detail::counted_free(p, size_t(alignment) > alignof(std::max_align_t));
+}
+void operator delete(void* p, size_t, std::align_val_t alignment) noexcept {
+   zmem::detail::counted_free(p, size_t(alignment) > alignof(std::max_align_t));
+}
+void operator delete[](void* p, size_t, std::align_val_t alignment) noexcept {
+   zmem::detail::counted_free(p, size_t(alignment) > alignof(std::max_align_t));
+}
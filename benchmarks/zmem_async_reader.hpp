@@ -0,0 +1,587 @@
+// ZMEM Asynchronous File Reader
+// Random lookups into large ZMEM files without page faults. Each lookup fetches only
+// the byte ranges a lazy view needs (the inline section once, then offset table
+// entries and the element) through io_uring, or a pread thread pool where io_uring
+// is unavailable. Linux io_uring is driven through raw syscalls (no liburing).
+
+#pragma once
+
+#include "zmem_layout.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define ZMEM_HAS_IO_URING 1
+#endif
+
+namespace zmem {
+
+enum class async_backend : uint32_t {
+   io_uring,
+   thread_pool,
+};
+
+inline const char* async_backend_name(async_backend backend) noexcept {
+   return backend == async_backend::io_uring ? "io_uring" : "thread_pool";
+}
+
+struct async_reader_options {
+   async_backend backend{async_backend::io_uring}; // Falls back to thread_pool if io_uring cannot be set up
+   uint32_t queue_depth{256}; // Maximum reads in flight
+   uint32_t buffer_count{256}; // Registered buffers
+   uint32_t buffer_size{64 * 1024};
+   uint32_t alignment{0}; // Offset/length alignment, e.g. 4096 for files opened with O_DIRECT
+   uint32_t threads{8}; // Workers of the thread_pool backend
+};
+
+struct read_completion {
+   uint64_t user_data{};
+   int64_t result{}; // Bytes read, or -errno
+};
+
+// ============================================================================
+// Read Queue
+// ============================================================================
+
+// Queue of positioned reads on one file descriptor. Not thread-safe: one thread
+// queues, submits and reaps.
+class async_file_reader {
+  public:
+   explicit async_file_reader(int fd, const async_reader_options& opts = {}) : fd_(fd), opts_(opts) {
+      opts_.queue_depth = std::max(opts_.queue_depth, 1u);
+      opts_.buffer_count = std::max(opts_.buffer_count, 1u);
+      opts_.buffer_size = std::max(opts_.buffer_size, std::max(opts_.alignment, 4096u));
+      opts_.threads = std::max(opts_.threads, 1u);
+
+      buffers_size_ = size_t(opts_.buffer_count) * opts_.buffer_size;
+      void* p = ::mmap(nullptr, buffers_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      buffers_ = p == MAP_FAILED ? nullptr : static_cast<char*>(p);
+
+      backend_ = async_backend::thread_pool;
+#if defined(ZMEM_HAS_IO_URING)
+      if (opts_.backend == async_backend::io_uring && buffers_ && setup_uring()) {
+         backend_ = async_backend::io_uring;
+      }
+#endif
+      if (backend_ == async_backend::thread_pool) {
+         for (uint32_t i = 0; i < opts_.threads; ++i) {
+            workers_.emplace_back([this] { worker(); });
+         }
+      }
+   }
+
+   ~async_file_reader() {
+      if (!workers_.empty()) {
+         {
+            std::lock_guard lock{mutex_};
+            stop_ = true;
+         }
+         work_cv_.notify_all();
+         for (auto& t : workers_) t.join();
+      }
+#if defined(ZMEM_HAS_IO_URING)
+      teardown_uring();
+#endif
+      if (buffers_) ::munmap(buffers_, buffers_size_);
+   }
+
+   async_file_reader(const async_file_reader&) = delete;
+   async_file_reader& operator=(const async_file_reader&) = delete;
+
+   async_backend backend() const noexcept { return backend_; }
+   bool registered_buffers() const noexcept { return registered_; }
+   bool valid() const noexcept { return buffers_ != nullptr; }
+   const async_reader_options& options() const noexcept { return opts_; }
+   uint32_t in_flight() const noexcept { return in_flight_; }
+
+   // Page-aligned, so usable with O_DIRECT
+   char* buffer(uint32_t index) const noexcept { return buffers_ + size_t(index) * opts_.buffer_size; }
+
+   // Queues a read into registered buffer `index` (length <= buffer_size). Returns false
+   // if queue_depth reads are already in flight.
+   bool read_fixed(uint64_t offset, uint32_t length, uint32_t index, uint64_t user_data) {
+      return queue(offset, length, buffer(index), int(index), user_data);
+   }
+
+   // Queues a read into caller-owned memory that outlives the completion
+   bool read(uint64_t offset, uint32_t length, char* dst, uint64_t user_data) {
+      return queue(offset, length, dst, -1, user_data);
+   }
+
+   // Hands queued reads to the kernel (or the worker threads) without waiting
+   void submit() {
+#if defined(ZMEM_HAS_IO_URING)
+      if (backend_ == async_backend::io_uring) {
+         if (to_submit_) (void)enter(0);
+         return;
+      }
+#endif
+      if (staged_.empty()) return;
+      {
+         std::lock_guard lock{mutex_};
+         for (auto& r : staged_) pending_.push_back(r);
+      }
+      staged_.clear();
+      work_cv_.notify_all();
+   }
+
+   // Submits, then blocks until at least `min_complete` reads (capped at the number in
+   // flight) have completed. Appends completions to `out` and returns how many.
+   size_t wait(std::vector<read_completion>& out, size_t min_complete = 1) {
+      min_complete = std::min<size_t>(min_complete, in_flight_);
+#if defined(ZMEM_HAS_IO_URING)
+      if (backend_ == async_backend::io_uring) {
+         size_t reaped = reap(out);
+         while (reaped < min_complete) {
+            if (enter(uint32_t(min_complete - reaped)) < 0) break;
+            reaped += reap(out);
+         }
+         if (to_submit_) (void)enter(0);
+         return reaped;
+      }
+#endif
+      submit();
+      std::unique_lock lock{mutex_};
+      done_cv_.wait(lock, [&] { return done_.size() >= min_complete; });
+      const size_t n = done_.size();
+      out.insert(out.end(), done_.begin(), done_.end());
+      done_.clear();
+      in_flight_ -= uint32_t(n);
+      return n;
+   }
+
+  private:
+   struct request {
+      uint64_t offset{};
+      uint32_t length{};
+      char* dst{};
+      uint64_t user_data{};
+   };
+
+   bool queue(uint64_t offset, uint32_t length, char* dst, int buffer_index, uint64_t user_data) {
+      if (in_flight_ >= opts_.queue_depth) return false;
+#if defined(ZMEM_HAS_IO_URING)
+      if (backend_ == async_backend::io_uring) {
+         const uint32_t tail = *sq_tail_;
+         const uint32_t index = tail & *sq_mask_;
+         io_uring_sqe& sqe = sqes_[index];
+         std::memset(&sqe, 0, sizeof(sqe));
+         sqe.fd = fd_;
+         sqe.off = offset;
+         sqe.addr = reinterpret_cast<uint64_t>(dst);
+         sqe.len = length;
+         sqe.user_data = user_data;
+         if (registered_ && buffer_index >= 0) {
+            sqe.opcode = IORING_OP_READ_FIXED;
+            sqe.buf_index = uint16_t(buffer_index);
+         }
+         else {
+            sqe.opcode = IORING_OP_READ;
+         }
+         sq_array_[index] = index;
+         __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+         ++to_submit_;
+         ++in_flight_;
+         return true;
+      }
+#endif
+      (void)buffer_index;
+      staged_.push_back({offset, length, dst, user_data});
+      ++in_flight_;
+      return true;
+   }
+
+   // ----------------------------------------------------------------------------
+   // Thread pool backend
+   // ----------------------------------------------------------------------------
+
+   void worker() {
+      std::unique_lock lock{mutex_};
+      while (true) {
+         work_cv_.wait(lock, [&] { return stop_ || !pending_.empty(); });
+         if (stop_) return;
+         const request r = pending_.front();
+         pending_.pop_front();
+         lock.unlock();
+
+         int64_t done = 0;
+         while (done < int64_t(r.length)) {
+            const ssize_t n = ::pread(fd_, r.dst + done, r.length - size_t(done), off_t(r.offset + uint64_t(done)));
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) {
+               done = -errno;
+               break;
+            }
+            if (n == 0) break; // End of file
+            done += n;
+         }
+
+         lock.lock();
+         done_.push_back({r.user_data, done});
+         done_cv_.notify_one();
+      }
+   }
+
+   // ----------------------------------------------------------------------------
+   // io_uring backend
+   // ----------------------------------------------------------------------------
+
+#if defined(ZMEM_HAS_IO_URING)
+   bool setup_uring() {
+      io_uring_params params{};
+      ring_fd_ = int(::syscall(__NR_io_uring_setup, opts_.queue_depth, &params));
+      if (ring_fd_ < 0) return false;
+
+      sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+      cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+      const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+      if (single_mmap) sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+      sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                        IORING_OFF_SQ_RING);
+      if (sq_ring_ == MAP_FAILED) return fail_uring();
+      cq_ring_ = single_mmap ? sq_ring_
+                             : ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                      ring_fd_, IORING_OFF_CQ_RING);
+      if (cq_ring_ == MAP_FAILED) return fail_uring();
+      sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+      void* sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                          IORING_OFF_SQES);
+      if (sqes == MAP_FAILED) return fail_uring();
+      sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+      char* sq = static_cast<char*>(sq_ring_);
+      char* cq = static_cast<char*>(cq_ring_);
+      sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+      sq_mask_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+      sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+      cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+      cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+      cq_mask_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+      cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+      // Registered buffers are pinned once, saving per-read page lookups. Registration
+      // fails when RLIMIT_MEMLOCK is too small; plain reads into the same memory still work.
+      std::vector<iovec> iovecs(opts_.buffer_count);
+      for (uint32_t i = 0; i < opts_.buffer_count; ++i) {
+         iovecs[i] = {buffer(i), opts_.buffer_size};
+      }
+      registered_ = opts_.buffer_count <= 16384 &&
+                    ::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS, iovecs.data(),
+                              opts_.buffer_count) == 0;
+      return true;
+   }
+
+   bool fail_uring() {
+      teardown_uring();
+      return false;
+   }
+
+   void teardown_uring() noexcept {
+      if (sqes_) ::munmap(sqes_, sqes_size_);
+      if (cq_ring_ && cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+      if (sq_ring_ && sq_ring_ != MAP_FAILED) ::munmap(sq_ring_, sq_ring_size_);
+      if (ring_fd_ >= 0) ::close(ring_fd_);
+      sqes_ = nullptr;
+      sq_ring_ = cq_ring_ = nullptr;
+      ring_fd_ = -1;
+      registered_ = false;
+   }
+
+   // Submits staged entries and optionally waits for `min_complete` completions
+   int enter(uint32_t min_complete) {
+      while (true) {
+         const unsigned flags = min_complete ? IORING_ENTER_GETEVENTS : 0;
+         const long ret = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit_, min_complete, flags, nullptr, 0);
+         if (ret < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EBUSY) {
+               // Out of submission resources or the completion queue is full. Block for
+               // a completion when submitted reads are outstanding, otherwise back off,
+               // so callers that retry do not spin.
+               if (in_flight_ > to_submit_) {
+                  (void)::syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+               }
+               else {
+                  std::this_thread::sleep_for(std::chrono::microseconds(50));
+               }
+               return 0; // Retried on the next call
+            }
+            return -errno;
+         }
+         to_submit_ -= uint32_t(ret);
+         return int(ret);
+      }
+   }
+
+   size_t reap(std::vector<read_completion>& out) {
+      uint32_t head = *cq_head_;
+      const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      size_t n = 0;
+      for (; head != tail; ++head, ++n) {
+         const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+         out.push_back({cqe.user_data, int64_t(cqe.res)});
+      }
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+      in_flight_ -= uint32_t(n);
+      return n;
+   }
+
+   int ring_fd_{-1};
+   void* sq_ring_{};
+   void* cq_ring_{};
+   size_t sq_ring_size_{};
+   size_t cq_ring_size_{};
+   size_t sqes_size_{};
+   io_uring_sqe* sqes_{};
+   uint32_t* sq_tail_{};
+   uint32_t* sq_mask_{};
+   uint32_t* sq_array_{};
+   uint32_t* cq_head_{};
+   uint32_t* cq_tail_{};
+   uint32_t* cq_mask_{};
+   io_uring_cqe* cqes_{};
+   uint32_t to_submit_{};
+#endif
+
+   int fd_{-1};
+   async_reader_options opts_{};
+   async_backend backend_{async_backend::thread_pool};
+   bool registered_{};
+   char* buffers_{};
+   size_t buffers_size_{};
+   uint32_t in_flight_{};
+
+   // Thread pool state
+   std::vector<request> staged_{};
+   std::mutex mutex_{};
+   std::condition_variable work_cv_{};
+   std::condition_variable done_cv_{};
+   std::deque<request> pending_{};
+   std::vector<read_completion> done_{};
+   bool stop_{};
+   std::vector<std::thread> workers_{};
+};
+
+// ============================================================================
+// Vector Element Lookups
+// ============================================================================
+
+enum class lookup_status : uint32_t {
+   ok = 0,
+   io_error,
+   out_of_range,
+   corrupt,
+};
+
+// Random element lookups into one vector field of a variable struct message stored
+// in a file, e.g. the `[Record]` field of a multi-GB dataset message.
+//
+//   open():   reads the size header and inline section up to the vector reference (once)
+//   lookup(): variable elements read their two offset table entries, then the element;
+//             fixed elements are read directly
+//
+// Every lookup owns one registered buffer from queue to callback, so up to
+// min(queue_depth, buffer_count) lookups are outstanding. Variable elements are
+// self-contained messages: the bytes passed to the callback go straight into
+// glz::lazy_zmem_view. Elements larger than a buffer fall back to a heap allocation.
+class async_vector_reader {
+  public:
+   async_vector_reader(async_file_reader& io, const vector_field& field, uint64_t message_offset = 0)
+      : io_(io), field_(field), message_offset_(message_offset) {
+      const auto& opts = io_.options();
+      slots_.resize(std::min(opts.queue_depth, opts.buffer_count));
+      free_.reserve(slots_.size());
+      for (uint32_t i = uint32_t(slots_.size()); i-- > 0;) free_.push_back(i);
+   }
+
+   lookup_status open() {
+      if (!io_.valid()) return lookup_status::io_error;
+      // The prefix read must be the only one in flight: its completion is the one awaited
+      if (free_.empty() || free_.size() != slots_.size()) return lookup_status::io_error;
+      const byte_range prefix = vector_ref_prefix(field_);
+      const uint32_t slot = free_.back();
+      free_.pop_back();
+      const lookup_status status = [&] {
+         if (!issue(slot, prefix)) return lookup_status::io_error;
+         std::vector<read_completion> completions;
+         io_.wait(completions, 1);
+         if (completions.empty()) return lookup_status::io_error;
+         const std::string_view bytes = fetched(slot, completions.front().result);
+         if (bytes.size() < prefix.size()) return lookup_status::io_error;
+         message_size_ = 8 + detail::load_u64(bytes.data());
+         if (!read_vector_ref(bytes, field_, ref_)) return lookup_status::corrupt;
+         return lookup_status::ok;
+      }();
+      free_.push_back(slot);
+      opened_ = status == lookup_status::ok;
+      return status;
+   }
+
+   uint64_t size() const noexcept { return ref_.count; }
+   uint32_t in_flight() const noexcept { return uint32_t(slots_.size() - free_.size()); }
+   uint32_t capacity() const noexcept { return uint32_t(slots_.size()); }
+
+   // Queues a lookup of element `index`. Returns false when every buffer is taken
+   // (poll first); out-of-range indices complete with lookup_status::out_of_range.
+   bool lookup(uint64_t index, uint64_t tag) {
+      if (free_.empty()) return false;
+      const uint32_t id = free_.back();
+      free_.pop_back();
+      slot& s = slots_[id];
+      s.tag = tag;
+      s.index = index;
+      s.status = lookup_status::ok;
+      if (!opened_ || index >= ref_.count) {
+         s.status = lookup_status::out_of_range;
+         finished_.push_back(id);
+         return true;
+      }
+      s.step = field_.element_size ? stage::element : stage::offsets;
+      const byte_range range =
+         field_.element_size ? fixed_element_range(field_, ref_, index) : offset_table_pair(field_, ref_, index);
+      if (!issue(id, range)) {
+         s.status = lookup_status::io_error;
+         finished_.push_back(id);
+      }
+      return true;
+   }
+
+   // Waits for at least `min_complete` lookups (capped at those outstanding) and calls
+   //    on_element(uint64_t tag, lookup_status status, std::string_view element)
+   // for each; the element bytes are valid until the callback returns. Returns the
+   // number of lookups finished.
+   template <class F>
+   size_t poll(F&& on_element, size_t min_complete = 1) {
+      min_complete = std::min<size_t>(min_complete, in_flight());
+      size_t finished = 0;
+      do {
+         completions_.clear();
+         if (finished_.empty()) {
+            io_.wait(completions_, 1);
+         }
+         else {
+            io_.submit();
+         }
+         for (const auto& c : completions_) advance(uint32_t(c.user_data), c.result);
+         io_.submit(); // Second-stage reads go out before the callbacks run
+
+         for (const uint32_t id : finished_) {
+            slot& s = slots_[id];
+            std::string_view element{};
+            if (s.status == lookup_status::ok) {
+               element = fetched(id, s.result).substr(0, s.wanted.size());
+            }
+            on_element(s.tag, s.status, element);
+            s.overflow.reset();
+            free_.push_back(id);
+         }
+         finished += finished_.size();
+         finished_.clear();
+      } while (finished < min_complete);
+      return finished;
+   }
+
+  private:
+   enum class stage : uint8_t { offsets, element };
+
+   struct free_deleter {
+      void operator()(char* p) const noexcept { std::free(p); }
+   };
+
+   struct slot {
+      uint64_t tag{};
+      uint64_t index{};
+      stage step{};
+      lookup_status status{};
+      byte_range wanted{}; // Message-relative range requested
+      uint64_t read_begin{}; // Absolute file offset actually read (aligned)
+      int64_t result{};
+      std::unique_ptr<char, free_deleter> overflow{};
+   };
+
+   // Reads `range` of the message into the slot's buffer, widened to the alignment
+   bool issue(uint32_t id, const byte_range& range) {
+      slot& s = slots_[id];
+      const uint64_t align = io_.options().alignment ? io_.options().alignment : 1;
+      const uint64_t begin = message_offset_ + range.begin;
+      const uint64_t end = message_offset_ + range.end;
+      s.wanted = range;
+      s.read_begin = begin / align * align;
+      const uint64_t length = (end + align - 1) / align * align - s.read_begin;
+      if (length > UINT32_MAX) return false;
+      if (length <= io_.options().buffer_size) {
+         s.overflow.reset();
+         return io_.read_fixed(s.read_begin, uint32_t(length), id, id);
+      }
+      s.overflow.reset(static_cast<char*>(std::aligned_alloc(std::max<uint64_t>(align, 64), (length + 63) / 64 * 64)));
+      if (!s.overflow) return false;
+      return io_.read(s.read_begin, uint32_t(length), s.overflow.get(), id);
+   }
+
+   // Bytes of the wanted range that arrived, given a read result
+   std::string_view fetched(uint32_t id, int64_t result) const noexcept {
+      const slot& s = slots_[id];
+      if (result < 0) return {};
+      const char* base = s.overflow ? s.overflow.get() : io_.buffer(id);
+      const uint64_t skip = message_offset_ + s.wanted.begin - s.read_begin;
+      if (uint64_t(result) <= skip) return {};
+      return {base + skip, size_t(std::min<uint64_t>(uint64_t(result) - skip, s.wanted.size()))};
+   }
+
+   void advance(uint32_t id, int64_t result) {
+      slot& s = slots_[id];
+      s.result = result;
+      const std::string_view bytes = fetched(id, result);
+      if (bytes.size() < s.wanted.size()) {
+         s.status = lookup_status::io_error;
+      }
+      else if (s.step == stage::offsets) {
+         const uint64_t offset_begin = detail::load_u64(bytes.data());
+         const uint64_t offset_end = detail::load_u64(bytes.data() + 8);
+         const byte_range range = variable_element_range(field_, ref_, offset_begin, offset_end);
+         if (offset_begin > offset_end || offset_end > message_size_ || range.end > message_size_) {
+            s.status = lookup_status::corrupt;
+         }
+         else {
+            s.step = stage::element;
+            if (issue(id, range)) return;
+            s.status = lookup_status::io_error;
+         }
+      }
+      finished_.push_back(id);
+   }
+
+   async_file_reader& io_;
+   vector_field field_{};
+   uint64_t message_offset_{};
+   uint64_t message_size_{};
+   vector_ref ref_{};
+   bool opened_{};
+   std::vector<slot> slots_{};
+   std::vector<uint32_t> free_{};
+   std::vector<uint32_t> finished_{};
+   std::vector<read_completion> completions_{};
+};
+
+} // namespace zmem
@@ -0,0 +1,94 @@
+// ZMEM Memory Bandwidth Kernels
+// Reference loops for a roofline: memcpy, a streaming read and a non-temporal
+// (cache-bypassing) write over the same byte counts as the ZMEM operations they are
+// compared against.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ZMEM_HAS_SSE2 1
+#endif
+
+namespace zmem {
+
+// Reads every byte once; returns a value derived from all of them so the loop is kept
+inline uint64_t stream_read(const char* data, size_t bytes) noexcept {
+   size_t i = 0;
+   uint64_t result = 0;
+#if defined(ZMEM_HAS_SSE2)
+   __m128i a = _mm_setzero_si128();
+   __m128i b = _mm_setzero_si128();
+   __m128i c = _mm_setzero_si128();
+   __m128i d = _mm_setzero_si128();
+   for (; i + 64 <= bytes; i += 64) {
+      a = _mm_add_epi64(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+      b = _mm_add_epi64(b, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16)));
+      c = _mm_add_epi64(c, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 32)));
+      d = _mm_add_epi64(d, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 48)));
+   }
+   alignas(16) uint64_t lanes[2];
+   _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(_mm_add_epi64(a, b), _mm_add_epi64(c, d)));
+   result = lanes[0] + lanes[1];
+#else
+   uint64_t a = 0, b = 0, c = 0, d = 0;
+   for (; i + 32 <= bytes; i += 32) {
+      uint64_t w[4];
+      std::memcpy(w, data + i, 32);
+      a += w[0];
+      b += w[1];
+      c += w[2];
+      d += w[3];
+   }
+   result = a + b + c + d;
+#endif
+   for (; i < bytes; ++i) result += uint8_t(data[i]);
+   return result;
+}
+
+// Fills with `value` using streaming stores that bypass the caches (no read for
+// ownership), the upper bound for producing `bytes` of new output
+inline void stream_write_nt(char* data, size_t bytes, char value) noexcept {
+#if defined(ZMEM_HAS_SSE2)
+   const size_t head = std::min(bytes, size_t((16 - reinterpret_cast<uintptr_t>(data) % 16) % 16));
+   std::memset(data, value, head);
+   const __m128i v = _mm_set1_epi8(value);
+   size_t i = head;
+   for (; i + 64 <= bytes; i += 64) {
+      _mm_stream_si128(reinterpret_cast<__m128i*>(data + i), v);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(data + i + 16), v);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(data + i + 32), v);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(data + i + 48), v);
+   }
+   for (; i + 16 <= bytes; i += 16) _mm_stream_si128(reinterpret_cast<__m128i*>(data + i), v);
+   _mm_sfence();
+   std::memset(data + i, value, bytes - i);
+#else
+   std::memset(data, value, bytes);
+#endif
+}
+
+// Best of `repetitions` timings of `func`, which processes `bytes` per call, in GB/s
+// (10^9 bytes). Small sizes are repeated so each timing covers at least 64 MB.
+template <class Func>
+double best_gb_per_s(Func&& func, size_t bytes, size_t repetitions) {
+   using clock = std::chrono::steady_clock;
+   const size_t calls = std::max<size_t>(1, (size_t(64) << 20) / std::max<size_t>(1, bytes));
+   func(); // Warm up: first touch, caches, buffer growth
+   double best = 0.0;
+   for (size_t r = 0; r < repetitions; ++r) {
+      const auto start = clock::now();
+      for (size_t i = 0; i < calls; ++i) func();
+      const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+      if (seconds > 0.0) best = std::max(best, static_cast<double>(bytes * calls) / seconds / 1e9);
+   }
+   return best;
+}
+
+} // namespace zmem
@@ -0,0 +1,180 @@
+// ZMEM Batched Encode Benchmark
+// Many small messages serialized into one buffer: a loop of glz::write_zmem_preallocated
+// calls appending to a log, against zmem::write_zmem_batch (zmem_batch_encode.hpp: one
+// glz::size_zmem pass, then glz::write_zmem into each message's slice of one presized
+// buffer; fixed structs are copied through their padding mask) on 1..N threads. The
+// array form is compared with glz::write_zmem of the whole std::vector. Quote has tail
+// padding holding garbage, Tick has none and Point3's 12 bytes are not a multiple of 8.
+// Batch output is checked byte for byte against glaze before timing.
+//
+// Usage: zmem_batch_bench [messages=1000000] [max_threads=8] [runs=5]
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_batch_encode.hpp"
+#include "zmem_fixtures.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Test Data Structures
+// ============================================================================
+
+struct Order {
+   uint64_t id{};
+   double price{};
+   uint32_t quantity{};
+   uint32_t side{};
+   std::string symbol{};
+};
+
+struct Point3 {
+   float x{};
+   float y{};
+   float z{};
+};
+
+// ============================================================================
+// Test Data Initialization
+// ============================================================================
+
+Order make_order(uint64_t i) {
+   static constexpr const char* symbols[] = {"AAPL", "MSFT", "NVDA", "AMZN", "GOOGL", "META", "TSLA", "BRK.B"};
+   const uint64_t h = mix(i);
+   return {i, 100.0 + double(h % 10000) * 0.01, uint32_t(1 + h % 1000), uint32_t(h & 1), symbols[h % 8]};
+}
+
+Point3 make_point(uint64_t i) {
+   const uint64_t h = mix(i);
+   return {float(h % 1000) * 0.5f, float((h >> 16) % 1000) * 0.5f, float((h >> 32) % 1000) * 0.5f};
+}
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+// Baseline: one write_zmem_preallocated per message, appended to the log
+template <class T>
+void write_loop(const std::vector<T>& values, std::string& log, std::string& scratch) {
+   log.clear();
+   for (const T& value : values) {
+      (void)glz::write_zmem_preallocated(value, scratch);
+      log.append(scratch);
+   }
+}
+
+// Best of `runs`, in ns per message
+template <class Func>
+double best_ns_per_message(Func&& func, size_t messages, size_t runs) {
+   func(); // Warmup: buffer capacity
+   double best = 0.0;
+   for (size_t r = 0; r < runs; ++r) {
+      auto start = std::chrono::high_resolution_clock::now();
+      func();
+      auto end = std::chrono::high_resolution_clock::now();
+      const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+                        double(messages);
+      if (r == 0 || ns < best) best = ns;
+   }
+   return best;
+}
+
+void print_row(const char* message, const std::string& method, double ns, double bytes_per_message,
+               double baseline_ns) {
+   std::cout << "| " << message << " | " << method << " | " << ns << " | " << bytes_per_message / ns << " | "
+             << baseline_ns / ns << "x |\n";
+}
+
+template <class T>
+bool run_type(const char* name, const std::vector<T>& values, size_t max_threads, size_t runs) {
+   const std::span<const T> span{values};
+   std::string expected;
+   std::string scratch;
+   std::string batch;
+
+   // Batch output must be the bytes glaze writes
+   write_loop(values, expected, scratch);
+   if (!zmem::write_zmem_batch(span, batch, zmem::batch_format::framed, max_threads) || batch != expected) {
+      std::cerr << name << ": framed write_zmem_batch differs from write_zmem_preallocated\n";
+      return false;
+   }
+   std::string expected_array;
+   if (auto ec = glz::write_zmem(values, expected_array); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, expected_array) << "\n";
+      return false;
+   }
+   if (!zmem::write_zmem_batch(span, batch, zmem::batch_format::array, max_threads) || batch != expected_array) {
+      std::cerr << name << ": array write_zmem_batch differs from write_zmem(std::vector)\n";
+      return false;
+   }
+
+   const size_t n = values.size();
+   const double framed_bytes = double(expected.size()) / double(n);
+   const double array_bytes = double(expected_array.size()) / double(n);
+
+   const double baseline = best_ns_per_message([&] { write_loop(values, batch, scratch); }, n, runs);
+   print_row(name, "write_zmem_preallocated loop", baseline, framed_bytes, baseline);
+   for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+      const double ns = best_ns_per_message(
+         [&] { (void)zmem::write_zmem_batch(span, batch, zmem::batch_format::framed, threads); }, n, runs);
+      print_row(name, "write_zmem_batch framed, " + std::to_string(threads) + " thread(s)", ns, framed_bytes,
+                baseline);
+   }
+
+   const double vector_ns = best_ns_per_message([&] { (void)glz::write_zmem(values, batch); }, n, runs);
+   print_row(name, "write_zmem(std::vector)", vector_ns, array_bytes, vector_ns);
+   for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+      const double ns = best_ns_per_message(
+         [&] { (void)zmem::write_zmem_batch(span, batch, zmem::batch_format::array, threads); }, n, runs);
+      print_row(name, "write_zmem_batch array, " + std::to_string(threads) + " thread(s)", ns, array_bytes,
+                vector_ns);
+   }
+   return true;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t count = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000);
+   const size_t max_threads = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8);
+   const size_t runs = std::max<size_t>(1, argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 5);
+
+   std::vector<Order> orders;
+   std::vector<Record> records;
+   std::vector<Point3> points;
+   orders.reserve(count);
+   records.reserve(count / 8 + 1);
+   points.reserve(count);
+   for (size_t i = 0; i < count; ++i) orders.push_back(make_order(i));
+   for (size_t i = 0; i < count / 8 + 1; ++i) records.push_back(make_record(i));
+   for (size_t i = 0; i < count; ++i) points.push_back(make_point(i));
+   const std::vector<Quote> quotes = make_quotes(count);
+   const std::vector<Tick> ticks = create_ticks(count);
+
+   std::cout << "ZMEM Batched Encode Benchmark\n";
+   std::cout << "=============================\n\n";
+   std::cout << "Messages: " << orders.size() << " Order, " << records.size() << " Record, " << count
+             << " each of Quote, Tick and Point3, best of " << runs
+             << " runs, hardware threads: " << std::thread::hardware_concurrency() << "\n";
+   std::cout << "Speedup is against the glaze row above it (framed: the loop; array: write_zmem(std::vector)).\n\n";
+   std::cout << std::fixed << std::setprecision(2);
+   std::cout << "| Message | Method | ns/message | GB/s | Speedup |\n";
+   std::cout << "|---------|--------|------------|------|---------|\n";
+
+   if (!run_type("Order (5 fields, ~56 B)", orders, max_threads, runs)) return 1;
+   if (!run_type("Record (4 fields, ~600 B)", records, max_threads, runs)) return 1;
+   if (!run_type("Quote (fixed, 48 B, padded)", quotes, max_threads, runs)) return 1;
+   if (!run_type("Tick (fixed, 24 B)", ticks, max_threads, runs)) return 1;
+   if (!run_type("Point3 (fixed, 12 B)", points, max_threads, runs)) return 1;
+   return 0;
+}
@@ -0,0 +1,210 @@
+// ZMEM Batched Encode
+// write_zmem_batch(values, buffer) serializes a range of structs into one
+// buffer, either as framed messages back to back (what a loop of glz::write_zmem calls
+// appending to a log produces) or as a single top-level [T] array message.
+//
+// A loop of write_zmem calls grows its buffer as it goes, and write_zmem_preallocated
+// computes each message's size before writing it. Here every size is computed once
+// with glz::size_zmem in a single pass (an exclusive prefix sum that is also every
+// message's position), the buffer is sized once, and each message is written by
+// glz::write_zmem straight into its slice of that buffer, optionally on several threads.
+// The slice already has the message's size, so the write neither sizes nor grows it.
+//
+// Fixed structs need no sizing: a message is the struct's wire bytes padded to 8 and an
+// array element is the struct's wire bytes. Where the native layout is the wire layout
+// they are copied through a padding mask (copy_scrubbed, zmem_scrub.hpp); otherwise each
+// is written by glz::write_zmem.
+
+#pragma once
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_scrub.hpp"
+#include "zmem_struct_layout.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zmem {
+
+// ============================================================================
+// Batches
+// ============================================================================
+
+enum class batch_format : uint32_t {
+   framed, // Messages back to back, each [size:8][inline][variable] (fixed structs: wire bytes padded to 8)
+   array // One [T] message: [count:8][offset table][self-contained elements] (fixed structs: contiguous)
+};
+
+namespace detail {
+
+// A slice of the batch buffer as a glaze output buffer: a contiguous char range that
+// starts out `capacity` bytes long. The sizing pass makes the slice exactly one message
+// long, so glz::write_zmem never grows it. A larger resize moves the output to `spill`,
+// so a size mismatch fails the write instead of overwriting the next message.
+struct buffer_slice {
+   using value_type = char;
+   using size_type = size_t;
+   using iterator = char*;
+   using const_iterator = const char*;
+
+   char* first{};
+   size_t capacity{};
+   size_t used = capacity;
+   std::string spill{};
+
+   size_t size() const noexcept { return used; }
+   bool empty() const noexcept { return used == 0; }
+   void resize(size_t n) {
+      if (n > capacity) spill.resize(n);
+      used = n;
+   }
+   char* data() noexcept { return used > capacity ? spill.data() : first; }
+   const char* data() const noexcept { return used > capacity ? spill.data() : first; }
+   char* begin() noexcept { return data(); }
+   char* end() noexcept { return data() + used; }
+   const char* begin() const noexcept { return data(); }
+   const char* end() const noexcept { return data() + used; }
+   char& operator[](size_t i) noexcept { return data()[i]; }
+   const char& operator[](size_t i) const noexcept { return data()[i]; }
+};
+
+static_assert(std::ranges::contiguous_range<buffer_slice>);
+
+// glz::write_zmem of `value` into the `bytes` at `out`; false unless it wrote exactly
+// that many bytes
+template <class T>
+bool write_slice(const T& value, char* out, size_t bytes) {
+   buffer_slice slice{out, bytes};
+   return !glz::write_zmem(value, slice) && slice.size() == bytes;
+}
+
+// Wire bytes of a fixed struct (fixed_size of them) at `out`, through a whole message
+// when the element is shorter than one
+template <class T>
+bool write_fixed(const T& value, char* out, size_t bytes) {
+   using layout = struct_layout<T>;
+   if (bytes == layout::message_size) return write_slice(value, out, bytes);
+   alignas(8) char message[layout::message_size];
+   if (!write_slice(value, message, layout::message_size)) return false;
+   std::memcpy(out, message, bytes);
+   return true;
+}
+
+// Runs fill(begin, end) over contiguous ranges of [0, n) on up to `threads` threads,
+// keeping at least 64 elements per thread; split(t, threads) is where range t begins
+template <class Split, class Fill>
+void fill_ranges(size_t n, size_t threads, Split&& split, Fill&& fill) {
+   threads = std::max<size_t>(1, std::min(threads, n / 64));
+   if (threads == 1) {
+      fill(size_t(0), n);
+      return;
+   }
+   std::vector<size_t> bounds(threads + 1, n);
+   bounds[0] = 0;
+   for (size_t t = 1; t < threads; ++t) bounds[t] = split(t, threads);
+   std::vector<std::thread> workers;
+   workers.reserve(threads - 1);
+   for (size_t t = 1; t < threads; ++t) workers.emplace_back(fill, bounds[t], bounds[t + 1]);
+   fill(bounds[0], bounds[1]);
+   for (auto& w : workers) w.join();
+}
+
+} // namespace detail
+
+// Serializes `values` into `buffer` (replacing its contents) with one resize. With
+// threads > 1 the fill is split into that many contiguous ranges of about equal bytes.
+// Returns false if glaze fails to write a message or writes a size other than
+// glz::size_zmem computed; the buffer contents are then unspecified.
+template <class T, class Buffer>
+bool write_zmem_batch(std::span<const T> values, Buffer& buffer, batch_format format = batch_format::framed,
+                      size_t threads = 1) {
+   static_assert(detail::is_struct_v<T>, "write_zmem_batch encodes structs");
+   const size_t n = values.size();
+   std::atomic<bool> ok{true};
+
+   if constexpr (!is_variable_struct<T>()) {
+      // Framed: messages of message_size bytes back to back. Array: the count, any
+      // alignment padding, elements at a stride of fixed_size (sizeof(T) for native
+      // layouts) and zero padding to a multiple of 8.
+      using layout = struct_layout<T>;
+      static_assert(layout::supported, "T has a field type not supported by zmem_struct_layout.hpp");
+      const bool array = format == batch_format::array;
+      const uint64_t header = array ? std::max<uint64_t>(8, layout::max_align) : 0;
+      const uint64_t stride = array ? layout::fixed_size : layout::message_size;
+      const uint64_t elements_end = header + n * stride;
+      buffer.resize(array ? detail::align_up(elements_end, 8) : elements_end);
+      char* out = buffer.data();
+      if (array) {
+         std::memset(out, 0, header);
+         const uint64_t count = n;
+         std::memcpy(out, &count, 8);
+         std::memset(out + elements_end, 0, buffer.size() - elements_end);
+      }
+      detail::fill_ranges(n, threads, [&](size_t t, size_t parts) { return n / parts * t; },
+                          [&](size_t begin, size_t end) {
+                             char* at = out + header + begin * stride;
+                             if constexpr (native_wire_stride<T>()) {
+                                if (stride == sizeof(T)) {
+                                   copy_scrubbed(values.data() + begin, end - begin, at);
+                                   return;
+                                }
+                                for (size_t i = begin; i < end; ++i, at += stride) {
+                                   copy_scrubbed(&values[i], 1, at);
+                                   std::memset(at + sizeof(T), 0, stride - sizeof(T));
+                                }
+                             }
+                             else {
+                                for (size_t i = begin; i < end; ++i, at += stride) {
+                                   if (!detail::write_fixed(values[i], at, stride)) {
+                                      ok.store(false, std::memory_order_relaxed);
+                                   }
+                                }
+                             }
+                          });
+   }
+   else {
+      // Sizes, as an exclusive prefix sum: offsets[i] is where message i starts
+      std::vector<uint64_t> offsets(n + 1);
+      uint64_t total = 0;
+      for (size_t i = 0; i < n; ++i) {
+         offsets[i] = total;
+         total += glz::size_zmem(values[i]);
+      }
+      offsets[n] = total;
+
+      // The array form's offset table is the same prefix sum, relative to its end
+      const uint64_t header = format == batch_format::array ? 8 + (n + 1) * 8 : 0;
+      buffer.resize(header + total);
+      char* out = buffer.data();
+      if (format == batch_format::array) {
+         const uint64_t count = n;
+         std::memcpy(out, &count, 8);
+         std::memcpy(out + 8, offsets.data(), (n + 1) * 8);
+      }
+
+      detail::fill_ranges(
+         n, threads,
+         [&](size_t t, size_t parts) {
+            const uint64_t target = total / parts * t;
+            return size_t(std::lower_bound(offsets.begin(), offsets.end() - 1, target) - offsets.begin());
+         },
+         [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+               if (!detail::write_slice(values[i], out + header + offsets[i], size_t(offsets[i + 1] - offsets[i]))) {
+                  ok.store(false, std::memory_order_relaxed);
+               }
+            }
+         });
+   }
+   return ok.load(std::memory_order_relaxed);
+}
+
+} // namespace zmem
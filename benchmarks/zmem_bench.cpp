@@ -3,131 +3,189 @@
 
 #include "glaze/zmem.hpp"
 
+#include "zmem_alloc_counter.hpp"
+#include "zmem_fixtures.hpp"
+#include "zmem_latency.hpp"
+#include "zmem_perf_counters.hpp"
+#include "zmem_report.hpp"
+
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <memory_resource>
 #include <string>
+#include <utility>
 #include <vector>
 
 // ============================================================================
-// Test Data Structures
+// Benchmark Utilities
 // ============================================================================
 
-struct Vec3 {
-   double x{};
-   double y{};
-   double z{};
-};
-
-struct NestedObject {
-   std::vector<Vec3> v3s{};
-   std::string id{};
-};
-
-struct AnotherObject {
-   std::string string{};
-   std::string another_string{};
-   std::string escaped_text{};
-   bool boolean{};
-   NestedObject nested_object{};
-};
-
-struct FixedObject {
-   std::vector<int32_t> int_array{};
-   std::vector<float> float_array{};
-   std::vector<double> double_array{};
-};
-
-struct FixedNameObject {
-   std::string name0{};
-   std::string name1{};
-   std::string name2{};
-   std::string name3{};
-   std::string name4{};
-};
-
-struct TestObj {
-   FixedObject fixed_object{};
-   FixedNameObject fixed_name_object{};
-   AnotherObject another_object{};
-   std::vector<std::string> string_array{};
-   std::string string{};
-   double number{};
-   bool boolean{};
-   bool another_bool{};
+struct bench_result {
+   double ns{}; // Mean time per operation over all runs
+   std::vector<double> runs_ns{}; // Mean time per operation of each run
+   double allocations{}; // Operator new calls per operation, after warmup
+   double allocated_bytes{}; // Bytes requested per operation, after warmup
+   zmem::perf_sample counters{}; // Per operation, if collected
+   zmem::hdr_histogram latency{}; // Individually timed operations (ns)
 };
 
-// ============================================================================
-// Test Data Initialization
-// ============================================================================
-
-TestObj create_test_data() {
-   TestObj obj;
-
-   // Fixed object
-   obj.fixed_object.int_array = {0, 1, 2, 3, 4, 5, 6};
-   obj.fixed_object.float_array = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f};
-   obj.fixed_object.double_array = {3288398.238, 233e22, 289e-1, 0.928759872, 0.22222848, 0.1, 0.2, 0.3, 0.4};
-
-   // Fixed name object
-   obj.fixed_name_object.name0 = "James";
-   obj.fixed_name_object.name1 = "Abraham";
-   obj.fixed_name_object.name2 = "Susan";
-   obj.fixed_name_object.name3 = "Frank";
-   obj.fixed_name_object.name4 = "Alicia";
-
-   // Another object
-   obj.another_object.string = "here is some text";
-   obj.another_object.another_string = "Hello World";
-   obj.another_object.escaped_text = R"({"some key":"some string value"})";
-   obj.another_object.boolean = false;
-   obj.another_object.nested_object.v3s = {
-      {0.12345, 0.23456, 0.001345},
-      {0.3894675, 97.39827, 297.92387},
-      {18.18, 87.289, 2988.298}
-   };
-   obj.another_object.nested_object.id = "298728949872";
-
-   // String array
-   obj.string_array = {"Cat", "Dog", "Elephant", "Tiger"};
-
-   // Simple fields
-   obj.string = "Hello world";
-   obj.number = 3.14;
-   obj.boolean = true;
-   obj.another_bool = false;
-
-   return obj;
-}
-
-// ============================================================================
-// Benchmark Utilities
-// ============================================================================
-
+// Mean over `runs` tight loops, then a second pass timing every call for the distribution
 template <typename Func>
-double benchmark(Func&& func, size_t iterations) {
+bench_result benchmark(Func&& func, size_t iterations, size_t runs, const zmem::op_timer& timer,
+                       zmem::perf_counters* counters = nullptr) {
    // Warmup
    for (size_t i = 0; i < iterations / 10; ++i) {
       func();
    }
 
-   auto start = std::chrono::high_resolution_clock::now();
-   for (size_t i = 0; i < iterations; ++i) {
-      func();
+   bench_result result;
+   result.runs_ns.reserve(runs);
+   const zmem::allocation_stats allocations_before = zmem::thread_allocations();
+   if (counters) counters->start();
+   for (size_t run = 0; run < runs; ++run) {
+      auto start = std::chrono::high_resolution_clock::now();
+      for (size_t i = 0; i < iterations; ++i) {
+         func();
+      }
+      auto end = std::chrono::high_resolution_clock::now();
+      auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+      result.runs_ns.push_back(static_cast<double>(duration.count()) / static_cast<double>(iterations));
+   }
+   if (counters) result.counters = counters->stop().per_op(iterations * runs);
+   const zmem::allocation_stats allocated = zmem::thread_allocations() - allocations_before;
+   result.allocations = static_cast<double>(allocated.allocations) / static_cast<double>(iterations * runs);
+   result.allocated_bytes = static_cast<double>(allocated.bytes) / static_cast<double>(iterations * runs);
+   for (const double ns : result.runs_ns) result.ns += ns / static_cast<double>(runs);
+
+   zmem::record_latencies(func, iterations, timer, result.latency);
+   return result;
+}
+
+void print_count(double value) {
+   if (value < 0) {
+      std::cout << "-";
+   }
+   else {
+      std::cout << value;
+   }
+}
+
+void print_row(const char* operation, const bench_result& r, size_t bytes, bool counters) {
+   std::cout << "| " << operation << " | " << r.ns << " | " << (static_cast<double>(bytes) / r.ns * 1000.0) << " | "
+             << r.allocations << " | " << r.allocated_bytes << " |";
+   if (counters) {
+      for (const auto event : {zmem::perf_event::cycles, zmem::perf_event::instructions}) {
+         std::cout << " ";
+         print_count(r.counters[event]);
+         std::cout << " |";
+      }
+      std::cout << " " << std::setprecision(2);
+      print_count(r.counters.ipc());
+      std::cout << std::setprecision(1) << " |";
+      for (const auto event : {zmem::perf_event::l1d_misses, zmem::perf_event::llc_misses,
+                               zmem::perf_event::branch_misses, zmem::perf_event::dtlb_misses}) {
+         std::cout << " " << std::setprecision(3);
+         print_count(r.counters[event]);
+         std::cout << std::setprecision(1) << " |";
+      }
    }
-   auto end = std::chrono::high_resolution_clock::now();
+   std::cout << "\n";
+}
+
+void print_latency_row(const char* operation, const bench_result& r) {
+   const auto& h = r.latency;
+   std::cout << "| " << operation << " | " << h.value_at_percentile(50.0) << " | " << h.value_at_percentile(90.0)
+             << " | " << h.value_at_percentile(99.0) << " | " << h.value_at_percentile(99.9) << " | " << h.max()
+             << " |\n";
+}
 
-   auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
-   return static_cast<double>(duration.count()) / static_cast<double>(iterations);
+zmem::operation_report make_report(const char* operation, const bench_result& r, size_t bytes) {
+   zmem::operation_report report;
+   report.name = operation;
+   report.bytes = bytes;
+   report.runs_ns = r.runs_ns;
+   report.allocations_per_op = r.allocations;
+   report.allocated_bytes_per_op = r.allocated_bytes;
+   report.p50_ns = r.latency.value_at_percentile(50.0);
+   report.p90_ns = r.latency.value_at_percentile(90.0);
+   report.p99_ns = r.latency.value_at_percentile(99.0);
+   report.p999_ns = r.latency.value_at_percentile(99.9);
+   report.max_ns = r.latency.max();
+   return report;
 }
 
 // ============================================================================
 // Main Benchmark
 // ============================================================================
 
-int main() {
+// Usage: zmem_bench [--perf] [--pin <cpu>] [--isolate] [--clock-gettime] [--runs <n>] [--json <path>]
+//                   [--require-zero-alloc]
+//   --perf            hardware counters per operation (perf_event_open, Linux)
+//   --pin <cpu>       run on one CPU only
+//   --isolate         SCHED_FIFO and mlockall for the benchmark thread (needs privileges)
+//   --clock-gettime   time operations with clock_gettime instead of rdtsc
+//   --runs <n>        repeat each timed loop n times (default 1; use >= 5 for zmem_compare)
+//   --json <path>     also write the results and build/machine details as JSON
+//   --require-zero-alloc   exit with status 3 if any operation allocates after warmup
+int main(int argc, char** argv) {
    constexpr size_t iterations = 100000;
 
+   bool perf = false;
+   bool isolate = false;
+   int pin_cpu = -1;
+   size_t runs = 1;
+   bool require_zero_alloc = false;
+   std::string json_path;
+   zmem::timer_source clock = zmem::op_timer::default_source();
+   for (int i = 1; i < argc; ++i) {
+      if (std::strcmp(argv[i], "--perf") == 0) {
+         perf = true;
+      }
+      else if (std::strcmp(argv[i], "--pin") == 0 && i + 1 < argc) {
+         pin_cpu = std::atoi(argv[++i]);
+      }
+      else if (std::strcmp(argv[i], "--isolate") == 0) {
+         isolate = true;
+      }
+      else if (std::strcmp(argv[i], "--clock-gettime") == 0) {
+         clock = zmem::timer_source::monotonic;
+      }
+      else if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+         runs = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+      }
+      else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+         json_path = argv[++i];
+      }
+      else if (std::strcmp(argv[i], "--require-zero-alloc") == 0) {
+         require_zero_alloc = true;
+      }
+   }
+
+   // Placement first, so counters, buffers and the TSC calibration all see the final CPU
+   if (pin_cpu >= 0 && !zmem::pin_current_thread_to_cpu(uint32_t(pin_cpu))) {
+      std::cerr << "Could not pin to CPU " << pin_cpu << "\n";
+   }
+   if (isolate) {
+      const zmem::isolation_result isolation = zmem::isolate_current_thread();
+      if (!isolation.realtime) std::cerr << "SCHED_FIFO unavailable (needs CAP_SYS_NICE)\n";
+      if (!isolation.memory_locked) std::cerr << "mlockall failed (RLIMIT_MEMLOCK)\n";
+   }
+   const zmem::op_timer timer{clock};
+   zmem::perf_counters counter_storage;
+   zmem::perf_counters* counters = nullptr;
+   if (perf) {
+      if (counter_storage.valid()) {
+         counters = &counter_storage;
+      }
+      else {
+         std::cerr << "perf_event_open unavailable (no PMU access or /proc/sys/kernel/perf_event_paranoid)\n";
+      }
+   }
+
    TestObj test_data = create_test_data();
 
    // Pre-serialize for read benchmarks
@@ -139,40 +197,110 @@ int main() {
 
    std::cout << "ZMEM Benchmark\n";
    std::cout << "==============\n\n";
-   std::cout << "Iterations: " << iterations << "\n";
-   std::cout << "Serialized size: " << buffer.size() << " bytes\n\n";
+   std::cout << "Iterations: " << iterations << " x " << runs << " runs\n";
+   std::cout << "Serialized size: " << buffer.size() << " bytes\n";
+   std::cout << "Timer: " << zmem::timer_source_name(timer.source()) << ", overhead " << timer.overhead_ns()
+             << " ns (included in percentiles)\n\n";
 
    // Write benchmark
    std::string write_buffer;
 
-   double write_ns = benchmark([&] {
+   const bench_result write = benchmark([&] {
       (void)glz::write_zmem(test_data, write_buffer);
-   }, iterations);
+   }, iterations, runs, timer, counters);
 
    // Write (preallocated) benchmark - computes size first, allocates once, writes without bounds checks
    std::string prealloc_buffer;
 
-   double write_prealloc_ns = benchmark([&] {
+   const bench_result write_prealloc = benchmark([&] {
       (void)glz::write_zmem_preallocated(test_data, prealloc_buffer);
-   }, iterations);
+   }, iterations, runs, timer, counters);
+
+   // Write into a std::pmr::string - separates the output buffer's allocations from the rest
+   zmem::counting_resource buffer_resource;
+   std::pmr::string pmr_buffer{&buffer_resource};
+
+   const bench_result write_pmr = benchmark([&] {
+      (void)glz::write_zmem(test_data, pmr_buffer);
+   }, iterations, runs, timer, counters);
 
    // Read benchmark
    TestObj result;
 
-   double read_ns = benchmark([&] {
+   const bench_result read = benchmark([&] {
       (void)glz::read_zmem(result, buffer);
-   }, iterations);
+   }, iterations, runs, timer, counters);
+
+   // Lazy view benchmark - two fields read in place, no decode
+   uint64_t sink = 0;
+
+   const bench_result lazy_view = benchmark([&] {
+      glz::lazy_zmem_view<TestObj> view{buffer};
+      sink += static_cast<uint64_t>(view.get<5>()) + view.get<4>().size();
+   }, iterations, runs, timer, counters);
 
    // Results
    std::cout << std::fixed << std::setprecision(1);
-   std::cout << "| Operation | Time (ns) | Throughput (MB/s) |\n";
-   std::cout << "|-----------|-----------|-------------------|\n";
-   std::cout << "| Write | " << write_ns << " | "
-             << (buffer.size() / write_ns * 1000.0) << " |\n";
-   std::cout << "| Write (prealloc) | " << write_prealloc_ns << " | "
-             << (buffer.size() / write_prealloc_ns * 1000.0) << " |\n";
-   std::cout << "| Read | " << read_ns << " | "
-             << (buffer.size() / read_ns * 1000.0) << " |\n";
+   if (counters) {
+      std::cout << "| Operation | Time (ns) | Throughput (MB/s) | Allocs/op | Bytes/op | Cycles/op | Instructions/op "
+                   "| IPC | L1D misses/op | LLC misses/op | Branch misses/op | dTLB misses/op |\n";
+      std::cout << "|-----------|-----------|-------------------|-----------|----------|-----------|-----------------"
+                   "|-----|---------------|---------------|------------------|----------------|\n";
+   }
+   else {
+      std::cout << "| Operation | Time (ns) | Throughput (MB/s) | Allocs/op | Bytes/op |\n";
+      std::cout << "|-----------|-----------|-------------------|-----------|----------|\n";
+   }
+   print_row("Write", write, buffer.size(), counters != nullptr);
+   print_row("Write (prealloc)", write_prealloc, buffer.size(), counters != nullptr);
+   print_row("Write (pmr buffer)", write_pmr, buffer.size(), counters != nullptr);
+   print_row("Read", read, buffer.size(), counters != nullptr);
+   print_row("Lazy view", lazy_view, buffer.size(), counters != nullptr);
+
+   std::cout << "\nLatency (ns)\n\n";
+   std::cout << "| Operation | p50 | p90 | p99 | p99.9 | max |\n";
+   std::cout << "|-----------|-----|-----|-----|-------|-----|\n";
+   print_latency_row("Write", write);
+   print_latency_row("Write (prealloc)", write_prealloc);
+   print_latency_row("Write (pmr buffer)", write_pmr);
+   print_latency_row("Read", read);
+   print_latency_row("Lazy view", lazy_view);
+
+   const zmem::allocation_stats& pmr_stats = buffer_resource.stats();
+   std::cout << "\npmr buffer resource: " << pmr_stats.allocations << " allocations, " << pmr_stats.bytes
+             << " bytes in total (including warmup)\n";
+   std::cout << "Checksum: " << sink << "\n";
+
+   if (!json_path.empty()) {
+      zmem::benchmark_report report;
+      report.benchmark = "zmem_bench";
+      report.timestamp = zmem::utc_timestamp();
+      report.build = zmem::current_build();
+      report.machine = zmem::current_machine();
+      report.iterations = iterations;
+      report.operations = {make_report("Write", write, buffer.size()),
+                           make_report("Write (prealloc)", write_prealloc, buffer.size()),
+                           make_report("Write (pmr buffer)", write_pmr, buffer.size()),
+                           make_report("Read", read, buffer.size()),
+                           make_report("Lazy view", lazy_view, buffer.size())};
+      if (const std::string error = zmem::save_report(report, json_path); !error.empty()) {
+         std::cerr << "JSON write error: " << error << "\n";
+         return 1;
+      }
+      std::cout << "Results written to " << json_path << "\n";
+   }
 
+   if (require_zero_alloc) {
+      bool allocation_free = true;
+      for (const auto& [operation, r] : {std::pair{"Write", &write}, std::pair{"Write (prealloc)", &write_prealloc},
+                                         std::pair{"Write (pmr buffer)", &write_pmr}, std::pair{"Read", &read},
+                                         std::pair{"Lazy view", &lazy_view}}) {
+         if (r->allocations > 0) {
+            std::cerr << operation << " allocates after warmup (" << r->allocations << " per operation)\n";
+            allocation_free = false;
+         }
+      }
+      if (!allocation_free) return 3;
+   }
    return 0;
 }
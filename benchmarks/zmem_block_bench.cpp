@@ -0,0 +1,152 @@
+// ZMEM Block-Compressed Container Benchmark
+// Measures compression ratio, compression throughput and random-access latency
+// of the block container (zmem_block_container.hpp) against plain ZMEM buffers.
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_block_container.hpp"
+#include "zmem_fixtures.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Test Data
+// ============================================================================
+
+// Log of framed TestObj messages with slowly varying content
+std::string create_message_log(size_t count) {
+   TestObj obj = create_test_data();
+   std::string log;
+   std::string message;
+   for (size_t i = 0; i < count; ++i) {
+      obj.number = 3.14 + static_cast<double>(i);
+      obj.fixed_object.int_array[0] = static_cast<int32_t>(i);
+      obj.string = "message " + std::to_string(i);
+      message.clear();
+      (void)glz::write_zmem(obj, message);
+      log.append(message);
+   }
+   return log;
+}
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+template <typename Func>
+double time_ns(Func&& func, size_t iterations) {
+   auto start = std::chrono::high_resolution_clock::now();
+   for (size_t i = 0; i < iterations; ++i) {
+      func(i);
+   }
+   auto end = std::chrono::high_resolution_clock::now();
+   auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+   return static_cast<double>(duration.count()) / static_cast<double>(iterations);
+}
+
+const char* codec_name(zmem::block_codec codec) {
+   switch (codec) {
+      case zmem::block_codec::none: return "none";
+      case zmem::block_codec::shuffle_delta: return "shuffle_delta";
+   }
+   return "unknown";
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t tick_count = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000);
+   const size_t message_count = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200'000);
+   constexpr size_t lookups = 200'000;
+
+   const std::vector<Tick> ticks = create_ticks(tick_count);
+   const std::string log = create_message_log(message_count);
+   const double tick_bytes = static_cast<double>(ticks.size() * sizeof(Tick));
+
+   std::cout << "ZMEM Block Container Benchmark\n";
+   std::cout << "==============================\n\n";
+   std::cout << "[Tick] elements: " << ticks.size() << " (" << ticks.size() * sizeof(Tick) << " bytes)\n";
+   std::cout << "TestObj messages: " << message_count << " (" << log.size() << " bytes)\n\n";
+
+   std::mt19937_64 rng{7};
+   std::vector<uint64_t> tick_indices(lookups);
+   for (auto& i : tick_indices) i = rng() % ticks.size();
+   std::vector<uint64_t> message_indices(lookups);
+   for (auto& i : message_indices) i = rng() % message_count;
+
+   // Baseline: random access straight into the uncompressed array
+   size_t checksum = 0;
+   const double raw_access_ns = time_ns([&](size_t i) {
+      checksum += ticks[tick_indices[i]].quantity;
+   }, lookups);
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "| Data | Codec | Block (KB) | Ratio | Compress (MB/s) | Random access (ns) |\n";
+   std::cout << "|------|-------|------------|-------|-----------------|--------------------|\n";
+   std::cout << "| [Tick] | raw | - | 1.0 | - | " << raw_access_ns << " |\n";
+
+   for (const auto codec : {zmem::block_codec::none, zmem::block_codec::shuffle_delta}) {
+      for (const uint64_t block_kb : {16, 64, 256}) {
+         zmem::block_options opts{};
+         opts.codec = codec;
+         opts.block_bytes = block_kb * 1024;
+
+         // Array container
+         std::string container;
+         const double compress_ns = time_ns([&](size_t) {
+            zmem::compress_array<Tick>(ticks, container, opts);
+         }, 3);
+
+         zmem::block_reader reader{container};
+         if (reader.error() != zmem::block_error::none) {
+            std::cerr << "Block container open error\n";
+            return 1;
+         }
+         if (reader.element<Tick>(tick_indices[0]) == nullptr) {
+            std::cerr << "Block container lookup error\n";
+            return 1;
+         }
+         const double access_ns = time_ns([&](size_t i) {
+            if (const Tick* tick = reader.element<Tick>(tick_indices[i])) checksum += tick->quantity;
+         }, lookups);
+
+         std::cout << "| [Tick] | " << codec_name(codec) << " | " << block_kb << " | "
+                   << tick_bytes / static_cast<double>(container.size()) << " | "
+                   << (tick_bytes / compress_ns * 1000.0) << " | " << access_ns << " |\n";
+
+         // Message log container: fetch a random message and read one field through a lazy view
+         std::string log_container;
+         const double log_compress_ns = time_ns([&](size_t) {
+            (void)zmem::compress_message_log(log, log_container, opts);
+         }, 3);
+
+         zmem::block_reader log_reader{log_container};
+         if (log_reader.error() != zmem::block_error::none || log_reader.message(message_indices[0]).empty()) {
+            std::cerr << "Block container open error\n";
+            return 1;
+         }
+         const double log_access_ns = time_ns([&](size_t i) {
+            glz::lazy_zmem_view<TestObj> view{log_reader.message(message_indices[i])};
+            checksum += static_cast<size_t>(view.get<5>());
+         }, lookups);
+
+         std::cout << "| TestObj log | " << codec_name(codec) << " | " << block_kb << " | "
+                   << static_cast<double>(log.size()) / static_cast<double>(log_container.size()) << " | "
+                   << (static_cast<double>(log.size()) / log_compress_ns * 1000.0) << " | " << log_access_ns
+                   << " |\n";
+      }
+   }
+
+   std::cout << "\nChecksum: " << checksum << "\n";
+
+   return 0;
+}
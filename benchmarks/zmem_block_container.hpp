@@ -0,0 +1,553 @@
+// ZMEM Block-Compressed Container
+// Optional archival wrapper around ZMEM array messages and message logs.
+//
+// The payload is split into independently compressed blocks and a block index
+// records which elements each block holds. Readers decode only the blocks that
+// cover a requested element range into a reusable buffer and hand back normal
+// ZMEM views (std::span<const T> for arrays, a framed message for logs).
+// See "Appendix C: Block-Compressed Container" in docs/ZMEM_FORMAT.md.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace zmem {
+
+// ============================================================================
+// Container Layout
+// ============================================================================
+
+enum class block_layout : uint32_t {
+   array = 0, // Payload of an array message of fixed elements
+   message_log = 1, // Concatenated size-prefixed (variable struct) messages
+};
+
+enum class block_codec : uint32_t {
+   none = 0,
+   shuffle_delta = 1, // Byte shuffle by element stride, byte delta, run-length
+};
+
+enum class block_error : uint32_t {
+   none = 0,
+   truncated,
+   bad_magic,
+   unsupported_version,
+   unsupported_codec,
+   unsupported_layout,
+   bad_index, // Blocks not contiguous from element 0, or counts and sizes inconsistent
+};
+
+inline constexpr char block_magic[4] = {'Z', 'M', 'B', 'C'};
+inline constexpr uint32_t block_version = 1;
+
+struct block_container_header {
+   char magic[4]{};
+   uint32_t version{};
+   uint32_t layout{};
+   uint32_t codec{};
+   uint64_t element_size{}; // Array stride, 0 for message logs
+   uint64_t element_count{}; // Elements (array) or messages (log)
+   uint64_t block_count{};
+};
+static_assert(sizeof(block_container_header) == 40);
+
+struct block_index_entry {
+   uint64_t first_element{};
+   uint64_t element_count{};
+   uint64_t offset{}; // From start of container, 8-byte aligned
+   uint64_t compressed_size{}; // == raw_size means the block is stored uncompressed
+   uint64_t raw_size{};
+};
+static_assert(sizeof(block_index_entry) == 40);
+
+struct block_options {
+   block_codec codec = block_codec::shuffle_delta;
+   uint64_t block_bytes = 64 * 1024; // Target uncompressed bytes per block
+};
+
+namespace detail {
+
+inline constexpr size_t padded_size_8(size_t n) noexcept { return (n + 7) & ~size_t(7); }
+
+inline uint64_t read_u64(const char* p) noexcept {
+   uint64_t v;
+   std::memcpy(&v, p, 8);
+   return v;
+}
+
+// ----------------------------------------------------------------------------
+// shuffle_delta codec
+// ----------------------------------------------------------------------------
+// 1. Byte shuffle: group byte j of every element together, so slowly varying
+//    high bytes of integers and float exponents become long similar runs.
+// 2. Byte delta: x[i] - x[i-1] (wrapping), turning ramps into constant runs.
+// 3. Run-length: tag < 128 -> (tag + 1) literal bytes follow,
+//    tag >= 128 -> next byte repeated (tag - 128 + 3) times.
+
+inline void shuffle(const char* src, char* dst, size_t n, size_t stride) noexcept {
+   const size_t m = n / stride;
+   for (size_t j = 0; j < stride; ++j) {
+      char* out = dst + j * m;
+      for (size_t i = 0; i < m; ++i) {
+         out[i] = src[i * stride + j];
+      }
+   }
+}
+
+inline void unshuffle(const char* src, char* dst, size_t n, size_t stride) noexcept {
+   const size_t m = n / stride;
+   for (size_t j = 0; j < stride; ++j) {
+      const char* in = src + j * m;
+      for (size_t i = 0; i < m; ++i) {
+         dst[i * stride + j] = in[i];
+      }
+   }
+}
+
+inline void rle_encode(const uint8_t* in, size_t n, std::string& out) {
+   constexpr size_t min_run = 3;
+   constexpr size_t max_run = 127 + min_run;
+   constexpr size_t max_literal = 128;
+
+   size_t i = 0;
+   size_t literal_start = 0;
+   auto flush_literals = [&](size_t end) {
+      while (literal_start < end) {
+         const size_t len = std::min(end - literal_start, max_literal);
+         out.push_back(static_cast<char>(len - 1));
+         out.append(reinterpret_cast<const char*>(in + literal_start), len);
+         literal_start += len;
+      }
+   };
+
+   while (i < n) {
+      size_t run = 1;
+      while (i + run < n && run < max_run && in[i + run] == in[i]) {
+         ++run;
+      }
+      if (run >= min_run) {
+         flush_literals(i);
+         out.push_back(static_cast<char>(128 + (run - min_run)));
+         out.push_back(static_cast<char>(in[i]));
+         i += run;
+         literal_start = i;
+      }
+      else {
+         i += run;
+      }
+   }
+   flush_literals(n);
+}
+
+// Returns false if the input is malformed or does not decode to exactly n bytes
+inline bool rle_decode(const uint8_t* in, size_t in_size, uint8_t* out, size_t n) noexcept {
+   size_t i = 0;
+   size_t o = 0;
+   while (i < in_size) {
+      const uint8_t tag = in[i++];
+      if (tag < 128) {
+         const size_t len = size_t(tag) + 1;
+         if (i + len > in_size || o + len > n) return false;
+         std::memcpy(out + o, in + i, len);
+         i += len;
+         o += len;
+      }
+      else {
+         const size_t len = size_t(tag) - 128 + 3;
+         if (i >= in_size || o + len > n) return false;
+         std::memset(out + o, in[i++], len);
+         o += len;
+      }
+   }
+   return o == n;
+}
+
+inline void shuffle_delta_encode(const char* src, size_t n, size_t stride, std::string& scratch,
+                                 std::string& out) {
+   if (stride <= 1 || n % stride != 0) {
+      stride = 1;
+   }
+   scratch.resize(n);
+   if (stride > 1) {
+      shuffle(src, scratch.data(), n, stride);
+   }
+   else {
+      std::memcpy(scratch.data(), src, n);
+   }
+
+   auto* bytes = reinterpret_cast<uint8_t*>(scratch.data());
+   uint8_t prev = 0;
+   for (size_t i = 0; i < n; ++i) {
+      const uint8_t cur = bytes[i];
+      bytes[i] = uint8_t(cur - prev);
+      prev = cur;
+   }
+
+   rle_encode(bytes, n, out);
+}
+
+inline bool shuffle_delta_decode(const char* src, size_t src_size, size_t stride, char* dst, size_t n,
+                                 std::string& scratch) {
+   if (stride <= 1 || n % stride != 0) {
+      stride = 1;
+   }
+   uint8_t* bytes = reinterpret_cast<uint8_t*>(dst);
+   if (stride > 1) {
+      scratch.resize(n);
+      bytes = reinterpret_cast<uint8_t*>(scratch.data());
+   }
+   if (!rle_decode(reinterpret_cast<const uint8_t*>(src), src_size, bytes, n)) {
+      return false;
+   }
+
+   uint8_t prev = 0;
+   for (size_t i = 0; i < n; ++i) {
+      prev = uint8_t(prev + bytes[i]);
+      bytes[i] = prev;
+   }
+
+   if (stride > 1) {
+      unshuffle(scratch.data(), dst, n, stride);
+   }
+   return true;
+}
+
+// ----------------------------------------------------------------------------
+// Container writer
+// ----------------------------------------------------------------------------
+
+struct pending_block {
+   uint64_t first_element{};
+   uint64_t element_count{};
+   const char* data{};
+   size_t size{};
+};
+
+inline void write_container(block_layout layout, uint64_t element_size, uint64_t element_count,
+                            const std::vector<pending_block>& blocks, const block_options& opts,
+                            std::string& out) {
+   block_container_header header{};
+   std::memcpy(header.magic, block_magic, 4);
+   header.version = block_version;
+   header.layout = uint32_t(layout);
+   header.codec = uint32_t(opts.codec);
+   header.element_size = element_size;
+   header.element_count = element_count;
+   header.block_count = blocks.size();
+
+   const size_t index_size = blocks.size() * sizeof(block_index_entry);
+   out.clear();
+   out.resize(sizeof(block_container_header) + index_size);
+   std::memcpy(out.data(), &header, sizeof(header));
+
+   // Stride used by the shuffle: element size for arrays, 8-byte words for logs
+   // (size headers, offsets and most scalars are 8-byte aligned).
+   const size_t stride = layout == block_layout::array ? size_t(element_size) : 8;
+
+   std::string encoded;
+   std::string scratch;
+   std::vector<block_index_entry> index(blocks.size());
+   for (size_t b = 0; b < blocks.size(); ++b) {
+      const auto& blk = blocks[b];
+      auto& entry = index[b];
+      entry.first_element = blk.first_element;
+      entry.element_count = blk.element_count;
+      entry.raw_size = blk.size;
+      entry.offset = out.size();
+
+      encoded.clear();
+      if (opts.codec == block_codec::shuffle_delta) {
+         shuffle_delta_encode(blk.data, blk.size, stride, scratch, encoded);
+      }
+
+      // Store incompressible blocks verbatim
+      if (opts.codec == block_codec::none || encoded.size() >= blk.size) {
+         entry.compressed_size = blk.size;
+         out.append(blk.data, blk.size);
+      }
+      else {
+         entry.compressed_size = encoded.size();
+         out.append(encoded);
+      }
+      out.resize(padded_size_8(out.size()), '\0');
+   }
+
+   std::memcpy(out.data() + sizeof(block_container_header), index.data(), index_size);
+}
+
+} // namespace detail
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+// Compress the elements of an array of fixed elements.
+template <class T>
+   requires std::is_trivially_copyable_v<T>
+void compress_array(std::span<const T> elements, std::string& out, const block_options& opts = {}) {
+   const uint64_t per_block = std::max<uint64_t>(1, opts.block_bytes / sizeof(T));
+   std::vector<detail::pending_block> blocks;
+   for (uint64_t first = 0; first < elements.size(); first += per_block) {
+      const uint64_t count = std::min<uint64_t>(per_block, elements.size() - first);
+      blocks.push_back({first, count, reinterpret_cast<const char*>(elements.data() + first),
+                        size_t(count * sizeof(T))});
+   }
+   detail::write_container(block_layout::array, sizeof(T), elements.size(), blocks, opts, out);
+}
+
+// Compress an existing ZMEM array message of fixed elements (alignof(T) <= 8).
+inline block_error compress_array_message(std::string_view message, uint64_t element_size, std::string& out,
+                                          const block_options& opts = {}) {
+   if (message.size() < 8 || element_size == 0) return block_error::truncated;
+   const uint64_t count = detail::read_u64(message.data());
+   if (count > (message.size() - 8) / element_size) return block_error::truncated;
+
+   const uint64_t per_block = std::max<uint64_t>(1, opts.block_bytes / element_size);
+   std::vector<detail::pending_block> blocks;
+   for (uint64_t first = 0; first < count; first += per_block) {
+      const uint64_t n = std::min<uint64_t>(per_block, count - first);
+      blocks.push_back({first, n, message.data() + 8 + first * element_size, size_t(n * element_size)});
+   }
+   detail::write_container(block_layout::array, element_size, count, blocks, opts, out);
+   return block_error::none;
+}
+
+// Compress a log of concatenated size-prefixed messages (e.g. repeated glz::write_zmem
+// output of a variable struct). Blocks always end on a message boundary.
+inline block_error compress_message_log(std::string_view log, std::string& out, const block_options& opts = {}) {
+   std::vector<detail::pending_block> blocks;
+   uint64_t message_count = 0;
+   size_t pos = 0;
+   detail::pending_block current{};
+   while (pos < log.size()) {
+      if (log.size() - pos < 8) return block_error::truncated;
+      const uint64_t size = detail::read_u64(log.data() + pos);
+      if (size > log.size() - pos - 8) return block_error::truncated;
+      const size_t message_size = size_t(8 + size);
+
+      if (current.element_count > 0 && current.size + message_size > opts.block_bytes) {
+         blocks.push_back(current);
+         current = {};
+      }
+      if (current.element_count == 0) {
+         current.first_element = message_count;
+         current.data = log.data() + pos;
+      }
+      ++current.element_count;
+      current.size += message_size;
+      ++message_count;
+      pos += message_size;
+   }
+   if (current.element_count > 0) {
+      blocks.push_back(current);
+   }
+   detail::write_container(block_layout::message_log, 0, message_count, blocks, opts, out);
+   return block_error::none;
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+// One decoded block: its raw_size bytes and the elements (or messages) it holds
+struct block_view {
+   std::string_view bytes{};
+   uint64_t first_element{};
+   uint64_t element_count{};
+};
+
+// Random-access reader over a block container. The container bytes must outlive
+// the reader and be 8-byte aligned (as a std::string or mmap'd file is). Returned
+// views point into an internal buffer and remain valid until the next call on the
+// same reader; one reader per thread.
+struct block_reader {
+   block_reader() = default;
+   explicit block_reader(std::string_view container) { (void)open(container); }
+
+   // Validates the header and the whole block index. The result is also kept in
+   // error(); on failure the reader is empty and every lookup returns an empty view.
+   block_error open(std::string_view container) {
+      container_ = container;
+      cached_block_ = no_block;
+      error_ = load(container);
+      if (error_ != block_error::none) {
+         header_ = {};
+         index_.clear();
+      }
+      return error_;
+   }
+
+   block_error error() const noexcept { return error_; }
+   block_layout layout() const noexcept { return block_layout(header_.layout); }
+   uint64_t size() const noexcept { return header_.element_count; }
+   uint64_t block_count() const noexcept { return header_.block_count; }
+   const std::vector<block_index_entry>& index() const noexcept { return index_; }
+
+   // Elements [first, first + count) of an array container. A range inside one block
+   // is returned straight from the decoded block; ranges spanning blocks are gathered.
+   template <class T>
+      requires std::is_trivially_copyable_v<T>
+   std::span<const T> elements(uint64_t first, uint64_t count) {
+      if (layout() != block_layout::array || header_.element_size != sizeof(T) || count == 0 ||
+          first >= size() || count > size() - first) {
+         return {};
+      }
+
+      size_t b = find_block(first);
+      if (b == no_block) return {};
+      const auto& entry = index_[b];
+      if (first + count <= entry.first_element + entry.element_count) {
+         const char* data = decode_block(b);
+         if (!data) return {};
+         return {reinterpret_cast<const T*>(data) + (first - entry.first_element), size_t(count)};
+      }
+
+      gather_.resize(size_t((count * sizeof(T) + 7) / 8));
+      char* out = reinterpret_cast<char*>(gather_.data());
+      uint64_t done = 0;
+      while (done < count) {
+         if (b >= index_.size()) return {};
+         const auto& e = index_[b];
+         const char* data = decode_block(b);
+         if (!data) return {};
+         const uint64_t begin = first + done - e.first_element;
+         const uint64_t n = std::min(count - done, e.element_count - begin);
+         std::memcpy(out + done * sizeof(T), data + begin * sizeof(T), size_t(n * sizeof(T)));
+         done += n;
+         ++b;
+      }
+      return {reinterpret_cast<const T*>(gather_.data()), size_t(count)};
+   }
+
+   template <class T>
+   const T* element(uint64_t i) {
+      auto s = elements<T>(i, 1);
+      return s.empty() ? nullptr : s.data();
+   }
+
+   // Message i of a message log container, including its 8-byte size header.
+   // Suitable for glz::read_zmem or glz::lazy_zmem_view.
+   std::string_view message(uint64_t i) {
+      if (layout() != block_layout::message_log || i >= size()) return {};
+      const size_t b = find_block(i);
+      if (b == no_block) return {};
+      const auto& entry = index_[b];
+      const char* data = decode_block(b);
+      if (!data) return {};
+
+      size_t pos = 0;
+      for (uint64_t k = entry.first_element;; ++k) {
+         if (entry.raw_size - pos < 8) return {};
+         const uint64_t size = detail::read_u64(data + pos);
+         if (size > entry.raw_size - pos - 8) return {};
+         if (k == i) return {data + pos, size_t(8 + size)};
+         pos += size_t(8 + size);
+      }
+   }
+
+   // Block b decoded whole, for sequential consumers. Empty bytes if b is out of
+   // range or does not decode.
+   block_view block(size_t b) {
+      if (b >= index_.size()) return {};
+      const auto& entry = index_[b];
+      const char* data = decode_block(b);
+      if (!data) return {};
+      return {{data, size_t(entry.raw_size)}, entry.first_element, entry.element_count};
+   }
+
+  private:
+   static constexpr size_t no_block = ~size_t(0);
+
+   block_error load(std::string_view container) {
+      if (container.size() < sizeof(block_container_header)) return block_error::truncated;
+      std::memcpy(&header_, container.data(), sizeof(header_));
+      if (std::memcmp(header_.magic, block_magic, 4) != 0) return block_error::bad_magic;
+      if (header_.version != block_version) return block_error::unsupported_version;
+      if (header_.codec > uint32_t(block_codec::shuffle_delta)) return block_error::unsupported_codec;
+      if (header_.layout > uint32_t(block_layout::message_log)) return block_error::unsupported_layout;
+      const bool array = layout() == block_layout::array;
+      if (array && header_.element_size == 0) return block_error::bad_index;
+      if (header_.block_count > (container.size() - sizeof(header_)) / sizeof(block_index_entry)) {
+         return block_error::truncated;
+      }
+      index_.resize(size_t(header_.block_count));
+      std::memcpy(index_.data(), container.data() + sizeof(header_), index_.size() * sizeof(block_index_entry));
+
+      // Blocks cover [0, element_count) in order, each with a non-empty element range
+      // whose decoded size matches it: arrays exactly, logs at least a size header each
+      uint64_t next = 0;
+      for (const auto& entry : index_) {
+         if (entry.offset > container.size() || entry.compressed_size > container.size() - entry.offset) {
+            return block_error::truncated;
+         }
+         if (entry.offset % 8 != 0 || entry.first_element != next || entry.element_count == 0 ||
+             entry.element_count > header_.element_count - next) {
+            return block_error::bad_index;
+         }
+         const bool sized = array ? entry.element_count <= entry.raw_size / header_.element_size &&
+                                       entry.raw_size == entry.element_count * header_.element_size
+                                  : entry.element_count <= entry.raw_size / 8;
+         // Run-length output is at most 65x its input (2 bytes expand to 130)
+         const bool decodable = entry.compressed_size == entry.raw_size ||
+                                entry.compressed_size >= entry.raw_size / 65 + (entry.raw_size % 65 != 0);
+         if (!sized || !decodable) return block_error::bad_index;
+         next += entry.element_count;
+      }
+      if (next != header_.element_count) return block_error::bad_index;
+      return block_error::none;
+   }
+
+   // Block holding `element`, or no_block
+   size_t find_block(uint64_t element) const noexcept {
+      auto it = std::upper_bound(index_.begin(), index_.end(), element,
+                                 [](uint64_t e, const block_index_entry& entry) { return e < entry.first_element; });
+      if (it == index_.begin()) return no_block;
+      const size_t b = size_t(it - index_.begin()) - 1;
+      if (element - index_[b].first_element >= index_[b].element_count) return no_block;
+      return b;
+   }
+
+   // Decodes block b into the reusable block buffer (cached for repeated hits)
+   const char* decode_block(size_t b) {
+      const auto& entry = index_[b];
+      const char* src = container_.data() + entry.offset;
+      if (entry.compressed_size == entry.raw_size) {
+         // Stored blocks are 8-byte aligned within the container, so views into them
+         // are as safe as views into the original message.
+         return src;
+      }
+      char* dst = reinterpret_cast<char*>(block_.data());
+      if (cached_block_ == b) return dst;
+
+      block_.resize(size_t((entry.raw_size + 7) / 8));
+      dst = reinterpret_cast<char*>(block_.data());
+      const size_t stride = layout() == block_layout::array ? size_t(header_.element_size) : 8;
+      if (!detail::shuffle_delta_decode(src, size_t(entry.compressed_size), stride, dst, size_t(entry.raw_size),
+                                        scratch_)) {
+         cached_block_ = no_block;
+         return nullptr;
+      }
+      cached_block_ = b;
+      return dst;
+   }
+
+   std::string_view container_{};
+   block_container_header header_{};
+   std::vector<block_index_entry> index_{};
+   block_error error_ = block_error::none;
+
+   // uint64_t storage keeps decoded elements 8-byte aligned for zero-copy views
+   std::vector<uint64_t> block_{};
+   std::vector<uint64_t> gather_{};
+   std::string scratch_{};
+   size_t cached_block_ = no_block;
+};
+
+} // namespace zmem
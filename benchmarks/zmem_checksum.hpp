@@ -0,0 +1,379 @@
+// ZMEM Checksums
+// CRC32C (Castagnoli) and XXH3-64 over message bytes. Instruction sets are selected
+// at runtime: SSE4.2 CRC32 instructions and AVX2 XXH3 stripe accumulation, with
+// slice-by-8 tables and scalar XXH3 as fallbacks. All paths agree bit for bit.
+//
+// CRC32C chains like zlib's crc32: crc32c(b, crc32c(a)) == crc32c(a + b). XXH3 is
+// the default-secret, seed 0 variant (XXH3_64bits in the reference library).
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ZMEM_CHECKSUM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace zmem {
+
+// ============================================================================
+// Instruction Set Selection
+// ============================================================================
+
+enum class checksum_isa : uint32_t {
+   scalar,
+   sse42, // CRC32 instructions
+   avx2, // SSE4.2 plus AVX2 for XXH3
+};
+
+inline checksum_isa detect_checksum_isa() noexcept {
+#if defined(ZMEM_CHECKSUM_X86)
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("sse4.2")) {
+      if (__builtin_cpu_supports("avx2")) return checksum_isa::avx2;
+      return checksum_isa::sse42;
+   }
+#endif
+   return checksum_isa::scalar;
+}
+
+inline checksum_isa best_checksum_isa() noexcept {
+   static const checksum_isa isa = detect_checksum_isa();
+   return isa;
+}
+
+inline const char* checksum_isa_name(checksum_isa isa) noexcept {
+   switch (isa) {
+      case checksum_isa::scalar: return "scalar";
+      case checksum_isa::sse42: return "SSE4.2";
+      case checksum_isa::avx2: return "SSE4.2+AVX2";
+   }
+   return "unknown";
+}
+
+namespace detail {
+
+// ----------------------------------------------------------------------------
+// Slice-by-8 tables for the reflected polynomial 0x82F63B78
+// ----------------------------------------------------------------------------
+
+inline constexpr std::array<std::array<uint32_t, 256>, 8> crc32c_tables = [] {
+   std::array<std::array<uint32_t, 256>, 8> tables{};
+   for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1)));
+      tables[0][i] = crc;
+   }
+   for (uint32_t i = 0; i < 256; ++i) {
+      for (size_t t = 1; t < 8; ++t) tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+   }
+   return tables;
+}();
+
+// `crc` is the running (inverted) state
+inline uint32_t crc32c_scalar(uint32_t crc, const unsigned char* p, size_t n) noexcept {
+   const auto& t = crc32c_tables;
+   while (n >= 8) {
+      uint64_t word;
+      std::memcpy(&word, p, 8);
+      word ^= crc;
+      crc = t[7][word & 0xFF] ^ t[6][(word >> 8) & 0xFF] ^ t[5][(word >> 16) & 0xFF] ^ t[4][(word >> 24) & 0xFF] ^
+            t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF] ^ t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+      p += 8;
+      n -= 8;
+   }
+   while (n--) crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+   return crc;
+}
+
+#if defined(ZMEM_CHECKSUM_X86)
+__attribute__((target("sse4.2"))) inline uint32_t crc32c_sse42(uint32_t crc, const unsigned char* p,
+                                                                size_t n) noexcept {
+   uint64_t c = crc;
+   while (n >= 8) {
+      uint64_t word;
+      std::memcpy(&word, p, 8);
+      c = _mm_crc32_u64(c, word);
+      p += 8;
+      n -= 8;
+   }
+   crc = uint32_t(c);
+   while (n--) crc = _mm_crc32_u8(crc, *p++);
+   return crc;
+}
+#endif
+
+} // namespace detail
+
+// ============================================================================
+// CRC32C
+// ============================================================================
+
+inline uint32_t crc32c(const void* data, size_t n, uint32_t seed = 0,
+                       checksum_isa isa = best_checksum_isa()) noexcept {
+   const auto* p = static_cast<const unsigned char*>(data);
+   uint32_t crc = ~seed;
+#if defined(ZMEM_CHECKSUM_X86)
+   if (isa != checksum_isa::scalar) return ~detail::crc32c_sse42(crc, p, n);
+#else
+   (void)isa;
+#endif
+   return ~detail::crc32c_scalar(crc, p, n);
+}
+
+inline uint32_t crc32c(std::string_view bytes, uint32_t seed = 0, checksum_isa isa = best_checksum_isa()) noexcept {
+   return crc32c(bytes.data(), bytes.size(), seed, isa);
+}
+
+// ============================================================================
+// XXH3-64
+// ============================================================================
+
+namespace detail {
+
+inline constexpr uint64_t xxh_prime32_1 = 0x9E3779B1u;
+inline constexpr uint64_t xxh_prime32_2 = 0x85EBCA77u;
+inline constexpr uint64_t xxh_prime32_3 = 0xC2B2AE3Du;
+inline constexpr uint64_t xxh_prime64_1 = 0x9E3779B185EBCA87ull;
+inline constexpr uint64_t xxh_prime64_2 = 0xC2B2AE3D27D4EB4Full;
+inline constexpr uint64_t xxh_prime64_3 = 0x165667B19E3779F9ull;
+inline constexpr uint64_t xxh_prime64_4 = 0x85EBCA77C2B2AE63ull;
+inline constexpr uint64_t xxh_prime64_5 = 0x27D4EB2F165667C5ull;
+inline constexpr uint64_t xxh_prime_mx1 = 0x165667919E3779F9ull;
+inline constexpr uint64_t xxh_prime_mx2 = 0x9FB21C651E98DF25ull;
+
+inline constexpr size_t xxh_stripe_len = 64;
+inline constexpr size_t xxh_secret_size = 192;
+
+// Default secret (from FARSH)
+alignas(64) inline constexpr unsigned char xxh3_secret[xxh_secret_size] = {
+   0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+   0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+   0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+   0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+   0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+   0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+   0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+   0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+   0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+   0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+   0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+   0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+inline uint64_t xxh_read64(const unsigned char* p) noexcept {
+   uint64_t v;
+   std::memcpy(&v, p, 8);
+   return v;
+}
+
+inline uint32_t xxh_read32(const unsigned char* p) noexcept {
+   uint32_t v;
+   std::memcpy(&v, p, 4);
+   return v;
+}
+
+inline uint64_t xxh_swap64(uint64_t v) noexcept {
+   v = ((v & 0x00FF00FF00FF00FFull) << 8) | ((v >> 8) & 0x00FF00FF00FF00FFull);
+   v = ((v & 0x0000FFFF0000FFFFull) << 16) | ((v >> 16) & 0x0000FFFF0000FFFFull);
+   return (v << 32) | (v >> 32);
+}
+
+// Low and high halves of the 128-bit product, XORed
+inline uint64_t xxh_mul128_fold64(uint64_t lhs, uint64_t rhs) noexcept {
+#if defined(__SIZEOF_INT128__)
+   const unsigned __int128 product = (unsigned __int128)lhs * rhs;
+   return uint64_t(product) ^ uint64_t(product >> 64);
+#else
+   const uint64_t lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+   const uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+   const uint64_t lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+   const uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+   const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+   const uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+   const uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+   return lower ^ upper;
+#endif
+}
+
+inline uint64_t xxh64_avalanche(uint64_t h) noexcept {
+   h ^= h >> 33;
+   h *= xxh_prime64_2;
+   h ^= h >> 29;
+   h *= xxh_prime64_3;
+   return h ^ (h >> 32);
+}
+
+inline uint64_t xxh3_avalanche(uint64_t h) noexcept {
+   h ^= h >> 37;
+   h *= xxh_prime_mx1;
+   return h ^ (h >> 32);
+}
+
+inline uint64_t xxh3_rrmxmx(uint64_t h, uint64_t len) noexcept {
+   h ^= std::rotl(h, 49) ^ std::rotl(h, 24);
+   h *= xxh_prime_mx2;
+   h ^= (h >> 35) + len;
+   h *= xxh_prime_mx2;
+   return h ^ (h >> 28);
+}
+
+inline uint64_t xxh3_mix16(const unsigned char* p, const unsigned char* secret) noexcept {
+   return xxh_mul128_fold64(xxh_read64(p) ^ xxh_read64(secret), xxh_read64(p + 8) ^ xxh_read64(secret + 8));
+}
+
+inline uint64_t xxh3_0to16(const unsigned char* p, size_t len) noexcept {
+   const unsigned char* secret = xxh3_secret;
+   if (len > 8) {
+      const uint64_t lo = xxh_read64(p) ^ (xxh_read64(secret + 24) ^ xxh_read64(secret + 32));
+      const uint64_t hi = xxh_read64(p + len - 8) ^ (xxh_read64(secret + 40) ^ xxh_read64(secret + 48));
+      return xxh3_avalanche(len + xxh_swap64(lo) + hi + xxh_mul128_fold64(lo, hi));
+   }
+   if (len >= 4) {
+      const uint64_t input = xxh_read32(p + len - 4) + (uint64_t(xxh_read32(p)) << 32);
+      return xxh3_rrmxmx(input ^ (xxh_read64(secret + 8) ^ xxh_read64(secret + 16)), len);
+   }
+   if (len > 0) {
+      const uint32_t combined = (uint32_t(p[0]) << 16) | (uint32_t(p[len >> 1]) << 24) | uint32_t(p[len - 1]) |
+                                (uint32_t(len) << 8);
+      return xxh64_avalanche(combined ^ uint64_t(xxh_read32(secret) ^ xxh_read32(secret + 4)));
+   }
+   return xxh64_avalanche(xxh_read64(secret + 56) ^ xxh_read64(secret + 64));
+}
+
+inline uint64_t xxh3_17to128(const unsigned char* p, size_t len) noexcept {
+   const unsigned char* secret = xxh3_secret;
+   uint64_t acc = len * xxh_prime64_1;
+   if (len > 32) {
+      if (len > 64) {
+         if (len > 96) {
+            acc += xxh3_mix16(p + 48, secret + 96);
+            acc += xxh3_mix16(p + len - 64, secret + 112);
+         }
+         acc += xxh3_mix16(p + 32, secret + 64);
+         acc += xxh3_mix16(p + len - 48, secret + 80);
+      }
+      acc += xxh3_mix16(p + 16, secret + 32);
+      acc += xxh3_mix16(p + len - 32, secret + 48);
+   }
+   acc += xxh3_mix16(p, secret);
+   acc += xxh3_mix16(p + len - 16, secret + 16);
+   return xxh3_avalanche(acc);
+}
+
+inline uint64_t xxh3_129to240(const unsigned char* p, size_t len) noexcept {
+   const unsigned char* secret = xxh3_secret;
+   uint64_t acc = len * xxh_prime64_1;
+   for (size_t i = 0; i < 8; ++i) acc += xxh3_mix16(p + 16 * i, secret + 16 * i);
+   acc = xxh3_avalanche(acc);
+   uint64_t acc_end = xxh3_mix16(p + len - 16, secret + 136 - 17);
+   for (size_t i = 8; i < len / 16; ++i) acc_end += xxh3_mix16(p + 16 * i, secret + 16 * (i - 8) + 3);
+   return xxh3_avalanche(acc + acc_end);
+}
+
+// Long inputs: 8 accumulator lanes over 64-byte stripes, scrambled every 16 stripes
+inline void xxh3_accumulate_scalar(uint64_t* acc, const unsigned char* p, const unsigned char* secret) noexcept {
+   for (size_t lane = 0; lane < 8; ++lane) {
+      const uint64_t data = xxh_read64(p + lane * 8);
+      const uint64_t key = data ^ xxh_read64(secret + lane * 8);
+      acc[lane ^ 1] += data;
+      acc[lane] += (key & 0xFFFFFFFF) * (key >> 32);
+   }
+}
+
+inline void xxh3_scramble_scalar(uint64_t* acc, const unsigned char* secret) noexcept {
+   for (size_t lane = 0; lane < 8; ++lane) {
+      uint64_t a = acc[lane];
+      a ^= a >> 47;
+      a ^= xxh_read64(secret + lane * 8);
+      acc[lane] = a * xxh_prime32_1;
+   }
+}
+
+#if defined(ZMEM_CHECKSUM_X86)
+__attribute__((target("avx2"))) inline void xxh3_accumulate_avx2(uint64_t* acc, const unsigned char* p,
+                                                                  const unsigned char* secret) noexcept {
+   auto* xacc = reinterpret_cast<__m256i*>(acc);
+   for (size_t i = 0; i < 2; ++i) {
+      const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p) + i);
+      const __m256i key = _mm256_xor_si256(data, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+      const __m256i product = _mm256_mul_epu32(key, _mm256_srli_epi64(key, 32));
+      const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+      const __m256i sum = _mm256_add_epi64(_mm256_loadu_si256(xacc + i), swapped);
+      _mm256_storeu_si256(xacc + i, _mm256_add_epi64(product, sum));
+   }
+}
+
+__attribute__((target("avx2"))) inline void xxh3_scramble_avx2(uint64_t* acc, const unsigned char* secret) noexcept {
+   auto* xacc = reinterpret_cast<__m256i*>(acc);
+   const __m256i prime = _mm256_set1_epi32(int(xxh_prime32_1));
+   for (size_t i = 0; i < 2; ++i) {
+      __m256i a = _mm256_loadu_si256(xacc + i);
+      a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+      a = _mm256_xor_si256(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+      const __m256i lo = _mm256_mul_epu32(a, prime);
+      const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+      _mm256_storeu_si256(xacc + i, _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+   }
+}
+#endif
+
+template <auto Accumulate, auto Scramble>
+inline uint64_t xxh3_long(const unsigned char* p, size_t len) noexcept {
+   const unsigned char* secret = xxh3_secret;
+   constexpr size_t stripes_per_block = (xxh_secret_size - xxh_stripe_len) / 8;
+   constexpr size_t block_len = xxh_stripe_len * stripes_per_block;
+   alignas(32) uint64_t acc[8] = {xxh_prime32_3, xxh_prime64_1, xxh_prime64_2, xxh_prime64_3,
+                                  xxh_prime64_4, xxh_prime32_2, xxh_prime64_5, xxh_prime32_1};
+
+   const size_t blocks = (len - 1) / block_len;
+   for (size_t b = 0; b < blocks; ++b) {
+      for (size_t s = 0; s < stripes_per_block; ++s) {
+         Accumulate(acc, p + b * block_len + s * xxh_stripe_len, secret + s * 8);
+      }
+      Scramble(acc, secret + xxh_secret_size - xxh_stripe_len);
+   }
+   const size_t stripes = ((len - 1) - block_len * blocks) / xxh_stripe_len;
+   for (size_t s = 0; s < stripes; ++s) Accumulate(acc, p + blocks * block_len + s * xxh_stripe_len, secret + s * 8);
+   Accumulate(acc, p + len - xxh_stripe_len, secret + xxh_secret_size - xxh_stripe_len - 7);
+
+   uint64_t result = len * xxh_prime64_1;
+   for (size_t i = 0; i < 4; ++i) {
+      result += xxh_mul128_fold64(acc[2 * i] ^ xxh_read64(secret + 11 + 16 * i),
+                                  acc[2 * i + 1] ^ xxh_read64(secret + 11 + 16 * i + 8));
+   }
+   return xxh3_avalanche(result);
+}
+
+#if defined(ZMEM_CHECKSUM_X86)
+__attribute__((target("avx2"))) inline uint64_t xxh3_long_avx2(const unsigned char* p, size_t len) noexcept {
+   return xxh3_long<xxh3_accumulate_avx2, xxh3_scramble_avx2>(p, len);
+}
+#endif
+
+} // namespace detail
+
+inline uint64_t xxh3_64(const void* data, size_t n, checksum_isa isa = best_checksum_isa()) noexcept {
+   const auto* p = static_cast<const unsigned char*>(data);
+   if (n <= 16) return detail::xxh3_0to16(p, n);
+   if (n <= 128) return detail::xxh3_17to128(p, n);
+   if (n <= 240) return detail::xxh3_129to240(p, n);
+#if defined(ZMEM_CHECKSUM_X86)
+   if (isa == checksum_isa::avx2) return detail::xxh3_long_avx2(p, n);
+#else
+   (void)isa;
+#endif
+   return detail::xxh3_long<detail::xxh3_accumulate_scalar, detail::xxh3_scramble_scalar>(p, n);
+}
+
+inline uint64_t xxh3_64(std::string_view bytes, checksum_isa isa = best_checksum_isa()) noexcept {
+   return xxh3_64(bytes.data(), bytes.size(), isa);
+}
+
+} // namespace zmem
@@ -0,0 +1,171 @@
+// ZMEM Field Transform Codec Benchmark
+// Compares the schema-aware field codec (zmem_field_codec.hpp) against the block
+// container's generic shuffle_delta codec and, when available, zstd.
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_block_container.hpp"
+#include "zmem_field_codec.hpp"
+#include "zmem_fixtures.hpp"
+
+#if defined(ZMEM_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Test Data
+// ============================================================================
+
+using tick_codec = zmem::field_codec<Tick, &Tick::timestamp, &Tick::price, &Tick::quantity, &Tick::flags>;
+using vec3_codec = zmem::field_codec<Vec3, &Vec3::x, &Vec3::y, &Vec3::z>;
+
+// Numeric columns of a run of TestObj messages: each message repeats the fixture
+// arrays with small perturbations, as successive snapshots of the same object would.
+struct TestObjColumns {
+   std::vector<int32_t> int_array{};
+   std::vector<float> float_array{};
+   std::vector<double> double_array{};
+   std::vector<Vec3> v3s{};
+};
+
+TestObjColumns create_test_obj_columns(size_t messages) {
+   const TestObj obj = create_test_data();
+   TestObjColumns columns;
+   std::mt19937_64 rng{11};
+   for (size_t m = 0; m < messages; ++m) {
+      const double drift = static_cast<double>(rng() % 8) * 0.125;
+      for (auto v : obj.fixed_object.int_array) columns.int_array.push_back(v + static_cast<int32_t>(m));
+      for (auto v : obj.fixed_object.float_array) columns.float_array.push_back(v + static_cast<float>(drift));
+      for (auto v : obj.fixed_object.double_array) columns.double_array.push_back(v + drift);
+      for (auto v : obj.another_object.nested_object.v3s) {
+         columns.v3s.push_back({v.x + drift, v.y, v.z - drift});
+      }
+   }
+   return columns;
+}
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+template <typename Func>
+double time_ns(Func&& func, size_t iterations) {
+   func(); // Warmup
+   auto start = std::chrono::high_resolution_clock::now();
+   for (size_t i = 0; i < iterations; ++i) {
+      func();
+   }
+   auto end = std::chrono::high_resolution_clock::now();
+   auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+   return static_cast<double>(duration.count()) / static_cast<double>(iterations);
+}
+
+void print_row(const std::string& data, const char* codec, size_t raw, size_t encoded, double encode_ns,
+               double decode_ns) {
+   std::cout << "| " << data << " | " << codec << " | " << raw << " | " << encoded << " | "
+             << static_cast<double>(raw) / static_cast<double>(encoded) << " | "
+             << (static_cast<double>(raw) / encode_ns * 1000.0) << " | "
+             << (static_cast<double>(raw) / decode_ns * 1000.0) << " |\n";
+}
+
+// Runs every codec on one ZMEM array message and checks the round trip is byte-identical
+template <class Codec, class T>
+bool run_codecs(const std::string& name, const std::vector<T>& values, size_t iterations) {
+   std::string message;
+   if (auto ec = glz::write_zmem(values, message); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, message) << "\n";
+      return false;
+   }
+
+   // Field codec
+   std::string encoded;
+   std::string decoded;
+   if (Codec::encode(message, encoded) != zmem::field_codec_error::none) {
+      std::cerr << name << ": field codec rejected input\n";
+      return false;
+   }
+   const double field_encode_ns = time_ns([&] { (void)Codec::encode(message, encoded); }, iterations);
+   const double field_decode_ns = time_ns([&] { (void)Codec::decode(encoded, decoded); }, iterations);
+   if (decoded != message) {
+      std::cerr << name << ": field codec round trip is not byte-identical\n";
+      return false;
+   }
+   print_row(name, "field", message.size(), encoded.size(), field_encode_ns, field_decode_ns);
+
+   // Generic block codec over the same element bytes (single block)
+   zmem::block_options opts{};
+   opts.block_bytes = message.size();
+   std::string container;
+   const double block_encode_ns = time_ns([&] {
+      (void)zmem::compress_array_message(message, sizeof(T), container, opts);
+   }, iterations);
+   const double block_decode_ns = time_ns([&] {
+      zmem::block_reader reader{container}; // Fresh reader so the decoded block is not cached
+      volatile const T* sink = reader.elements<T>(0, values.size()).data();
+      (void)sink;
+   }, iterations);
+   print_row(name, "shuffle_delta", message.size(), container.size(), block_encode_ns, block_decode_ns);
+
+#if defined(ZMEM_HAS_ZSTD)
+   for (const int level : {1, 3}) {
+      std::string compressed(ZSTD_compressBound(message.size()), '\0');
+      size_t compressed_size = 0;
+      const double zstd_encode_ns = time_ns([&] {
+         compressed_size = ZSTD_compress(compressed.data(), compressed.size(), message.data(), message.size(), level);
+      }, iterations);
+      std::string restored(message.size(), '\0');
+      const double zstd_decode_ns = time_ns([&] {
+         (void)ZSTD_decompress(restored.data(), restored.size(), compressed.data(), compressed_size);
+      }, iterations);
+      print_row(name, level == 1 ? "zstd -1" : "zstd -3", message.size(), compressed_size, zstd_encode_ns,
+                zstd_decode_ns);
+   }
+#endif
+
+   return true;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t tick_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+   const size_t message_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100'000;
+   constexpr size_t iterations = 10;
+
+   std::cout << "ZMEM Field Codec Benchmark\n";
+   std::cout << "==========================\n\n";
+#if defined(__AVX2__)
+   std::cout << "SIMD: AVX2\n";
+#else
+   std::cout << "SIMD: none (configure with -DZMEM_BENCH_NATIVE=ON)\n";
+#endif
+#if !defined(ZMEM_HAS_ZSTD)
+   std::cout << "zstd: not found, zstd rows skipped\n";
+#endif
+   std::cout << "\n";
+
+   const std::vector<Tick> ticks = create_ticks(tick_count);
+   const TestObjColumns columns = create_test_obj_columns(message_count);
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "| Data | Codec | Raw (bytes) | Encoded (bytes) | Ratio | Encode (MB/s) | Decode (MB/s) |\n";
+   std::cout << "|------|-------|-------------|-----------------|-------|---------------|---------------|\n";
+
+   bool ok = run_codecs<tick_codec>("[Tick]", ticks, iterations);
+   ok &= run_codecs<zmem::field_codec<int32_t>>("TestObj int_array [i32]", columns.int_array, iterations);
+   ok &= run_codecs<zmem::field_codec<float>>("TestObj float_array [f32]", columns.float_array, iterations);
+   ok &= run_codecs<zmem::field_codec<double>>("TestObj double_array [f64]", columns.double_array, iterations);
+   ok &= run_codecs<vec3_codec>("TestObj v3s [Vec3]", columns.v3s, iterations);
+
+   return ok ? 0 : 1;
+}
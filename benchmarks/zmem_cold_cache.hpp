@@ -0,0 +1,68 @@
+// ZMEM Cold-Cache Fixtures
+// Copies of one serialized message spread over several times the last-level cache.
+// Picking a random copy per access makes each access miss the caches (and usually
+// the TLB) without flushing inside the timed loop.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zmem {
+
+// Size of the largest data cache of CPU 0 from sysfs, 32 MB if unknown
+inline size_t last_level_cache_bytes() {
+   size_t largest = 0;
+   for (int index = 0; index < 8; ++index) {
+      const std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+      std::ifstream type_in(dir + "type");
+      std::ifstream size_in(dir + "size");
+      std::string type;
+      std::string size;
+      if (!(type_in >> type) || !(size_in >> size) || type == "Instruction" || size.empty()) continue;
+      size_t bytes = std::strtoull(size.c_str(), nullptr, 10);
+      if (size.back() == 'K') bytes <<= 10;
+      if (size.back() == 'M') bytes <<= 20;
+      largest = std::max(largest, bytes);
+   }
+   return largest ? largest : size_t(32) << 20;
+}
+
+class cold_copies {
+  public:
+   // At least two copies; `footprint` 0 means 4x the last-level cache, at most 2 GB
+   cold_copies(const void* data, size_t size, size_t footprint = 0)
+      : size_(size), stride_((std::max<size_t>(size, 1) + 63) / 64 * 64) {
+      if (footprint == 0) footprint = std::min(4 * last_level_cache_bytes(), size_t(2) << 30);
+      count_ = std::max<size_t>(2, footprint / stride_);
+      storage_.resize(count_ * stride_ / sizeof(uint64_t) + 8);
+      for (size_t i = 0; i < count_; ++i) std::memcpy(base() + i * stride_, data, size);
+   }
+
+   size_t count() const noexcept { return count_; }
+   size_t size() const noexcept { return size_; }
+
+   // Copy `i`, 64-byte aligned
+   const uint8_t* data(size_t i) const noexcept { return base() + (i % count_) * stride_; }
+   std::string_view view(size_t i) const noexcept { return {reinterpret_cast<const char*>(data(i)), size_}; }
+
+  private:
+   uint8_t* base() const noexcept {
+      const auto p = reinterpret_cast<uintptr_t>(storage_.data());
+      return reinterpret_cast<uint8_t*>((p + 63) / 64 * 64);
+   }
+
+   size_t size_;
+   size_t stride_;
+   size_t count_{};
+   std::vector<uint64_t> storage_{}; // 64 spare bytes for alignment
+};
+
+} // namespace zmem
@@ -0,0 +1,221 @@
+// ZMEM Columnar Batch Decode
+// read_zmem_batch<T>(messages, columns) decodes many same-typed variable struct messages
+// field by field into one std::vector per field (structure of arrays), without building
+// a T per message and transposing.
+//
+// Every field sits at the same inline offset in every message (zmem_struct_layout.hpp),
+// so messages are validated a block at a time and each fixed field becomes a gather over
+// the block's inline base pointers. 4- and 8-byte scalars use AVX2 gather
+// instructions when available; other fields are decoded per message as in
+// zmem_projection.hpp (strings and vectors are copied, nested variable structs go
+// through glz::read_zmem).
+
+#pragma once
+
+#include "zmem_projection.hpp"
+#include "zmem_struct_layout.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ZMEM_COLUMNS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace zmem {
+
+// ============================================================================
+// Instruction Set Selection
+// ============================================================================
+
+enum class gather_isa : uint32_t {
+   scalar,
+   avx2, // VPGATHERQQ / VPGATHERQD
+};
+
+inline gather_isa detect_gather_isa() noexcept {
+#if defined(ZMEM_COLUMNS_X86)
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2")) return gather_isa::avx2;
+#endif
+   return gather_isa::scalar;
+}
+
+inline gather_isa best_gather_isa() noexcept {
+   static const gather_isa isa = detect_gather_isa();
+   return isa;
+}
+
+inline const char* gather_isa_name(gather_isa isa) noexcept {
+   switch (isa) {
+      case gather_isa::scalar: return "scalar";
+      case gather_isa::avx2: return "AVX2";
+   }
+   return "unknown";
+}
+
+// ============================================================================
+// Columns
+// ============================================================================
+
+namespace detail {
+
+template <class T, size_t... I>
+auto make_columns(std::index_sequence<I...>) -> std::tuple<std::vector<field_type<T, I>>...>;
+
+} // namespace detail
+
+// One std::vector per field of T, in declaration order: std::get<I>(columns)
+template <class T>
+using soa_columns = decltype(detail::make_columns<T>(std::make_index_sequence<struct_layout<T>::count>{}));
+
+namespace detail {
+
+// ----------------------------------------------------------------------------
+// Gather Kernels
+// ----------------------------------------------------------------------------
+
+// out[i] = the Size bytes at bases[i] + offset
+template <size_t Size>
+void gather_scalar(const char* const* bases, size_t n, uint64_t offset, void* out) noexcept {
+   char* dst = static_cast<char*>(out);
+   for (size_t i = 0; i < n; ++i) std::memcpy(dst + i * Size, bases[i] + offset, Size);
+}
+
+#if defined(ZMEM_COLUMNS_X86)
+
+// The base pointers are the gather indices (scale 1, null base), four per instruction
+__attribute__((target("avx2"))) inline void gather_u64_avx2(const char* const* bases, size_t n, uint64_t offset,
+                                                            void* out) noexcept {
+   static_assert(sizeof(const char*) == 8);
+   const __m256i shift = _mm256_set1_epi64x(int64_t(offset));
+   char* dst = static_cast<char*>(out);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m256i a = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bases + i)), shift);
+      const __m256i b = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bases + i + 4)), shift);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 8), _mm256_i64gather_epi64(nullptr, a, 1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 8 + 32), _mm256_i64gather_epi64(nullptr, b, 1));
+   }
+   gather_scalar<8>(bases + i, n - i, offset, dst + i * 8);
+}
+
+__attribute__((target("avx2"))) inline void gather_u32_avx2(const char* const* bases, size_t n, uint64_t offset,
+                                                            void* out) noexcept {
+   const __m256i shift = _mm256_set1_epi64x(int64_t(offset));
+   char* dst = static_cast<char*>(out);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m256i a = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bases + i)), shift);
+      const __m256i b = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bases + i + 4)), shift);
+      const __m128i lo = _mm256_i64gather_epi32(nullptr, a, 1);
+      const __m128i hi = _mm256_i64gather_epi32(nullptr, b, 1);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_set_m128i(hi, lo));
+   }
+   gather_scalar<4>(bases + i, n - i, offset, dst + i * 4);
+}
+
+#endif
+
+template <size_t Size>
+void gather(const char* const* bases, size_t n, uint64_t offset, void* out, gather_isa isa) noexcept {
+#if defined(ZMEM_COLUMNS_X86)
+   if constexpr (Size == 8 || Size == 4) {
+      if (isa == gather_isa::avx2) {
+         if constexpr (Size == 8) {
+            gather_u64_avx2(bases, n, offset, out);
+         }
+         else {
+            gather_u32_avx2(bases, n, offset, out);
+         }
+         return;
+      }
+   }
+#endif
+   (void)isa;
+   gather_scalar<Size>(bases, n, offset, out);
+}
+
+// Column I of T for the `bases.size()` messages starting at `first`. `bases` holds each
+// message's inline base address; the column is already sized for the whole batch.
+template <class T, size_t I>
+bool decode_column(std::vector<field_type<T, I>>& column, std::span<const std::string_view> messages, size_t first,
+                   std::span<const char* const> bases, gather_isa isa) {
+   using F = field_type<T, I>;
+   constexpr uint64_t offset = struct_layout<T>::offsets[I];
+   if constexpr ((std::is_arithmetic_v<F> || std::is_enum_v<F>) && !std::is_same_v<F, bool>) {
+      gather<sizeof(F)>(bases.data(), bases.size(), offset, column.data() + first, isa);
+      return true;
+   }
+   else if constexpr (!inline_layout<F>().variable) {
+      for (size_t m = 0; m < bases.size(); ++m) {
+         if constexpr (std::is_same_v<F, bool>) {
+            column[first + m] = bases[m][offset] != 0;
+         }
+         else {
+            decode_fixed(column[first + m], bases[m] + offset);
+         }
+      }
+      return true;
+   }
+   else {
+      for (size_t m = 0; m < bases.size(); ++m) {
+         const message_scope scope{framed_message(messages[first + m]), struct_layout<T>::inline_base};
+         if (!decode_field(column[first + m], scope, scope.inline_base + offset)) return false;
+      }
+      return true;
+   }
+}
+
+// Messages per block: every column of a block is filled while its inline sections are
+// still in L1/L2, instead of streaming the whole batch from memory once per column
+inline constexpr size_t batch_block = 256;
+
+} // namespace detail
+
+// Decodes every message into `columns`, replacing their contents: std::get<I>(columns)[m]
+// is field I of message m. Messages must be complete variable struct messages of T.
+// Returns false if one is truncated or holds references outside itself; `columns` is
+// then unspecified.
+template <class T>
+bool read_zmem_batch(std::span<const std::string_view> messages, soa_columns<T>& columns,
+                     gather_isa isa = best_gather_isa()) {
+   using layout = struct_layout<T>;
+   static_assert(layout::variable, "arrays of fixed structs are already columnar-friendly: use a [T] message");
+   static_assert(layout::supported, "T has a field type not supported by zmem_struct_layout.hpp");
+   constexpr bool decodable = []<size_t... I>(std::index_sequence<I...>) {
+      return (detail::field_decodable<detail::field_type<T, I>>() && ...);
+   }(std::make_index_sequence<layout::count>{});
+   static_assert(decodable,
+                 "read_zmem_batch cannot decode maps, vectors of maps or nested vectors: use glz::read_zmem");
+
+   [&]<size_t... I>(std::index_sequence<I...>) {
+      ((std::get<I>(columns).resize(messages.size())), ...);
+   }(std::make_index_sequence<layout::count>{});
+
+   const char* bases[detail::batch_block];
+   for (size_t first = 0; first < messages.size(); first += detail::batch_block) {
+      const size_t n = std::min(detail::batch_block, messages.size() - first);
+      // Validate the block, so the fixed-field gathers need no per-message checks
+      for (size_t m = 0; m < n; ++m) {
+         const std::string_view message = detail::framed_message(messages[first + m]);
+         if (message.size() < layout::inline_base + layout::inline_size) return false;
+         bases[m] = message.data() + layout::inline_base;
+      }
+      const bool ok = [&]<size_t... I>(std::index_sequence<I...>) {
+         return (detail::decode_column<T, I>(std::get<I>(columns), messages, first, {bases, n}, isa) && ...);
+      }(std::make_index_sequence<layout::count>{});
+      if (!ok) return false;
+   }
+   return true;
+}
+
+} // namespace zmem
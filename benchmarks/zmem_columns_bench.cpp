@@ -0,0 +1,204 @@
+// ZMEM Columnar Batch Decode Benchmark
+// Many small variable struct messages decoded into per-field columns: glz::read_zmem
+// into one object per message followed by a transpose, against zmem::read_zmem_batch
+// (zmem_columns.hpp) with scalar and AVX2 gathers. Trade carries a string column;
+// Sample is scalar columns plus an empty vector, so the gathers dominate; Entity (the
+// game world entity of zmem_workloads.hpp) has nested fixed structs whose size is not a
+// multiple of 8 and vectors of them. Columns are checked against the per-message decode
+// before timing.
+//
+// Usage: zmem_columns_bench [messages=1000000] [runs=5]
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_columns.hpp"
+#include "zmem_workloads.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+// ============================================================================
+// Test Data Structures
+// ============================================================================
+
+struct Trade {
+   uint64_t id{};
+   int64_t timestamp{};
+   double price{};
+   double quantity{};
+   uint32_t venue{};
+   float fee{};
+   std::string symbol{};
+};
+
+struct Sample {
+   uint64_t sensor{};
+   int64_t timestamp{};
+   double value{};
+   float confidence{};
+   uint32_t quality{};
+   std::vector<float> extra{}; // Empty; makes the struct variable
+};
+
+// ============================================================================
+// Test Data Initialization
+// ============================================================================
+
+Trade make_trade(std::mt19937_64& rng, size_t i) {
+   static constexpr const char* symbols[] = {"AAPL", "MSFT", "NVDA", "AMZN", "GOOGL", "META", "TSLA", "BRK.B"};
+   return {i,
+           int64_t(1'700'000'000'000'000'000ll + int64_t(i) * 1000),
+           100.0 + double(rng() % 10000) * 0.01,
+           double(1 + rng() % 1000),
+           uint32_t(rng() % 16),
+           float(rng() % 100) * 0.001f,
+           symbols[rng() % 8]};
+}
+
+Sample make_sample(std::mt19937_64& rng, size_t i) {
+   return {rng() % 4096, int64_t(i) * 1000, double(rng() % 100000) * 0.001, float(rng() % 100) * 0.01f,
+           uint32_t(rng() % 4), {}};
+}
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+// Every message written back to back into one log, with a view of each
+template <class T>
+bool make_log(const std::vector<T>& values, std::string& log, std::vector<std::string_view>& messages) {
+   std::string scratch;
+   std::vector<size_t> offsets;
+   for (const T& value : values) {
+      if (auto ec = glz::write_zmem(value, scratch); ec) {
+         std::cerr << "ZMEM write error: " << glz::format_error(ec, scratch) << "\n";
+         return false;
+      }
+      offsets.push_back(log.size());
+      log.append(scratch);
+   }
+   offsets.push_back(log.size());
+   messages.clear();
+   for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+      messages.emplace_back(log.data() + offsets[i], offsets[i + 1] - offsets[i]);
+   }
+   return true;
+}
+
+// Baseline: decode every message into a T, then scatter the fields into columns
+template <class T>
+bool decode_and_transpose(const std::vector<std::string_view>& messages, std::vector<T>& objects,
+                          zmem::soa_columns<T>& columns) {
+   objects.resize(messages.size());
+   for (size_t m = 0; m < messages.size(); ++m) {
+      if (glz::read_zmem(objects[m], messages[m])) return false;
+   }
+   [&]<size_t... I>(std::index_sequence<I...>) {
+      ((std::get<I>(columns).resize(objects.size())), ...);
+      for (size_t m = 0; m < objects.size(); ++m) {
+         ((std::get<I>(columns)[m] = zmem::detail::field<I>(objects[m])), ...);
+      }
+   }(std::make_index_sequence<zmem::struct_layout<T>::count>{});
+   return true;
+}
+
+// Best of `runs`, in ns per message
+template <class Func>
+double best_ns_per_message(Func&& func, size_t messages, size_t runs) {
+   func(); // Warmup: column and object capacity
+   double best = 0.0;
+   for (size_t r = 0; r < runs; ++r) {
+      auto start = std::chrono::high_resolution_clock::now();
+      func();
+      auto end = std::chrono::high_resolution_clock::now();
+      const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+                        double(messages);
+      if (r == 0 || ns < best) best = ns;
+   }
+   return best;
+}
+
+void print_row(const char* message, const char* method, double ns, double baseline_ns) {
+   std::cout << "| " << message << " | " << method << " | " << ns << " | " << 1e3 / ns << " | " << baseline_ns / ns
+             << "x |\n";
+}
+
+template <class T>
+bool run_type(const char* name, const std::vector<T>& values, size_t runs) {
+   std::string log;
+   std::vector<std::string_view> messages;
+   if (!make_log(values, log, messages)) return false;
+
+   std::vector<T> objects;
+   zmem::soa_columns<T> expected;
+   zmem::soa_columns<T> columns;
+   if (!decode_and_transpose(messages, objects, expected)) {
+      std::cerr << name << ": read_zmem failed\n";
+      return false;
+   }
+   const zmem::gather_isa best = zmem::best_gather_isa();
+   for (const zmem::gather_isa isa : {zmem::gather_isa::scalar, best}) {
+      if (!zmem::read_zmem_batch<T>(messages, columns, isa) || columns != expected) {
+         std::cerr << name << ": read_zmem_batch (" << zmem::gather_isa_name(isa)
+                   << ") disagrees with read_zmem\n";
+         return false;
+      }
+   }
+
+   const double baseline = best_ns_per_message([&] { (void)decode_and_transpose(messages, objects, columns); },
+                                               messages.size(), runs);
+   print_row(name, "read_zmem + transpose", baseline, baseline);
+   print_row(name, "read_zmem_batch (scalar)",
+             best_ns_per_message(
+                [&] { (void)zmem::read_zmem_batch<T>(messages, columns, zmem::gather_isa::scalar); },
+                messages.size(), runs),
+             baseline);
+   if (best != zmem::gather_isa::scalar) {
+      const std::string method = std::string("read_zmem_batch (") + zmem::gather_isa_name(best) + " gather)";
+      print_row(name, method.c_str(),
+                best_ns_per_message([&] { (void)zmem::read_zmem_batch<T>(messages, columns, best); },
+                                    messages.size(), runs),
+                baseline);
+   }
+   return true;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t count = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000);
+   const size_t runs = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5);
+
+   std::mt19937_64 rng{42};
+   std::vector<Trade> trades;
+   std::vector<Sample> samples;
+   trades.reserve(count);
+   samples.reserve(count);
+   for (size_t i = 0; i < count; ++i) {
+      trades.push_back(make_trade(rng, i));
+      samples.push_back(make_sample(rng, i));
+   }
+
+   std::cout << "ZMEM Columnar Batch Decode Benchmark\n";
+   std::cout << "====================================\n\n";
+   std::cout << "Messages: " << count << " per type, best of " << runs << " runs, gather: "
+             << zmem::gather_isa_name(zmem::best_gather_isa()) << "\n\n";
+   std::cout << std::fixed << std::setprecision(2);
+   std::cout << "| Message | Method | ns/message | M msg/s | Speedup |\n";
+   std::cout << "|---------|--------|------------|---------|---------|\n";
+
+   if (!run_type("Trade (7 fields, string)", trades, runs)) return 1;
+   if (!run_type("Sample (6 fields, scalars)", samples, runs)) return 1;
+   if (!run_type("Entity (10 fields, nested structs)", workloads::make_world_snapshot(count).entities, runs)) return 1;
+   return 0;
+}
@@ -0,0 +1,115 @@
+// ZMEM Benchmark Comparison
+// Compares two JSON reports (zmem_bench --runs <n> --json <path>) operation by operation.
+// A change is significant when the 95% confidence interval on the difference of run
+// means (Welch) excludes zero and the change exceeds the threshold.
+//
+// Usage: zmem_compare <baseline.json> <candidate.json> [threshold_percent=2]
+// Exit status: 0 no regression, 1 usage or read error, 2 regression found
+
+#include "zmem_report.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+
+// ============================================================================
+// Comparison Utilities
+// ============================================================================
+
+void print_field(const char* name, const std::string& baseline, const std::string& candidate) {
+   if (baseline == candidate) {
+      std::cout << name << ": " << baseline << "\n";
+   }
+   else {
+      std::cout << name << ": " << baseline << " -> " << candidate << "\n";
+   }
+}
+
+const zmem::operation_report* find_operation(const zmem::benchmark_report& report, const std::string& name) {
+   for (const auto& op : report.operations) {
+      if (op.name == name) return &op;
+   }
+   return nullptr;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+   if (argc < 3) {
+      std::cerr << "Usage: zmem_compare <baseline.json> <candidate.json> [threshold_percent=2]\n";
+      return 1;
+   }
+   const double threshold = (argc > 3 ? std::strtod(argv[3], nullptr) : 2.0) / 100.0;
+
+   zmem::benchmark_report baseline;
+   zmem::benchmark_report candidate;
+   for (const auto& [report, path] : {std::pair{&baseline, argv[1]}, std::pair{&candidate, argv[2]}}) {
+      if (const std::string error = zmem::load_report(*report, path); !error.empty()) {
+         std::cerr << "JSON read error: " << error << "\n";
+         return 1;
+      }
+   }
+
+   std::cout << "ZMEM Benchmark Comparison\n";
+   std::cout << "=========================\n\n";
+   print_field("Benchmark", baseline.benchmark, candidate.benchmark);
+   print_field("Revision", baseline.build.revision, candidate.build.revision);
+   print_field("Glaze revision", baseline.build.glaze_revision, candidate.build.glaze_revision);
+   print_field("Compiler", baseline.build.compiler, candidate.build.compiler);
+   print_field("Flags", baseline.build.flags, candidate.build.flags);
+   print_field("Build type", baseline.build.build_type, candidate.build.build_type);
+   print_field("CPU", baseline.machine.cpu_model, candidate.machine.cpu_model);
+   print_field("Kernel", baseline.machine.kernel, candidate.machine.kernel);
+   if (baseline.machine.cpu_model != candidate.machine.cpu_model) {
+      std::cout << "\nWarning: different CPUs, differences may not come from the code\n";
+   }
+
+   std::cout << "\n" << std::fixed << std::setprecision(1);
+   std::cout << "| Operation | Baseline (ns) | Candidate (ns) | Runs | Change (%) | 95% CI (%) | Allocs/op "
+                "| Verdict |\n";
+   std::cout << "|-----------|---------------|----------------|------|------------|------------|-----------"
+                "|---------|\n";
+
+   size_t regressions = 0;
+   for (const auto& before : baseline.operations) {
+      const zmem::operation_report* after = find_operation(candidate, before.name);
+      if (!after) {
+         std::cout << "| " << before.name << " | " << zmem::compute_stats(before.runs_ns).mean
+                   << " | - | - | - | - | - | missing |\n";
+         continue;
+      }
+
+      const zmem::difference_interval d = zmem::compare_samples(before.runs_ns, after->runs_ns);
+      const char* verdict = "no change";
+      if (!d.valid) {
+         verdict = "needs >= 2 runs";
+      }
+      else if (d.low > 0.0 && d.change > threshold) {
+         verdict = "REGRESSION";
+         ++regressions;
+      }
+      else if (d.high < 0.0 && -d.change > threshold) {
+         verdict = "improvement";
+      }
+
+      std::cout << "| " << before.name << " | " << zmem::compute_stats(before.runs_ns).mean << " | "
+                << zmem::compute_stats(after->runs_ns).mean << " | " << before.runs_ns.size() << "/"
+                << after->runs_ns.size() << " | " << std::showpos << 100.0 * d.change << " | ";
+      if (d.valid) {
+         std::cout << "[" << 100.0 * d.low << ", " << 100.0 * d.high << "]";
+      }
+      else {
+         std::cout << "-";
+      }
+      std::cout << std::noshowpos << " | " << before.allocations_per_op;
+      if (after->allocations_per_op != before.allocations_per_op) std::cout << " -> " << after->allocations_per_op;
+      std::cout << " | " << verdict << " |\n";
+   }
+
+   std::cout << "\n" << regressions << " regression(s) beyond " << 100.0 * threshold << "%\n";
+   return regressions ? 2 : 0;
+}
@@ -0,0 +1,289 @@
+// ZMEM Nested Vector Depth Benchmark
+// Random element access into [f32] .. [[[[[f32]]]]] against the "Access Complexity
+// Summary": zero-copy access follows one offset table per level above the last, so its
+// cost should grow with depth and not with size, while decoded std::vector access is a
+// pointer chase per level after a decode proportional to the whole message.
+//
+// Accesses form a dependent chain (the next path depends on the value just read), so
+// the rows are latencies rather than throughput.
+//
+// Usage: zmem_depth_bench [leaves=1048576] [accesses=1000000]
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_layout.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ============================================================================
+// Test Data Structures
+// ============================================================================
+
+// nested_vector<1> is std::vector<float>, nested_vector<3> is [[[f32]]]
+template <size_t Depth>
+struct nested_vector_type {
+   using type = std::vector<typename nested_vector_type<Depth - 1>::type>;
+};
+
+template <>
+struct nested_vector_type<0> {
+   using type = float;
+};
+
+template <size_t Depth>
+using nested_vector = typename nested_vector_type<Depth>::type;
+
+template <size_t Depth>
+struct NestedMessage {
+   nested_vector<Depth> values{};
+   uint64_t id{};
+};
+
+// values is the first inline field
+constexpr zmem::vector_field values_field{0, 0};
+
+// ============================================================================
+// Test Data Initialization
+// ============================================================================
+
+// `fan_out` elements at every level, leaves numbered in order
+template <size_t Depth>
+void fill(nested_vector<Depth>& v, size_t fan_out, float& next) {
+   v.resize(fan_out);
+   for (auto& element : v) {
+      if constexpr (Depth == 1) {
+         element = next;
+         next += 1.0f;
+      }
+      else {
+         fill<Depth - 1>(element, fan_out, next);
+      }
+   }
+}
+
+template <size_t Depth>
+NestedMessage<Depth> make_message(size_t fan_out) {
+   NestedMessage<Depth> m;
+   m.id = Depth;
+   float next = 0.0f;
+   fill<Depth>(m.values, fan_out, next);
+   return m;
+}
+
+// `count` random paths of `depth` indices, stored back to back
+std::vector<uint64_t> make_paths(size_t count, size_t depth, size_t fan_out) {
+   std::vector<uint64_t> paths(count * depth);
+   std::mt19937_64 rng{42};
+   for (auto& index : paths) index = rng() % fan_out;
+   return paths;
+}
+
+// Smallest fan-out with fan_out^depth >= leaves
+size_t fan_out_for(size_t leaves, size_t depth) {
+   size_t fan_out = std::max<size_t>(1, size_t(std::pow(double(leaves), 1.0 / double(depth))));
+   auto total = [&](size_t f) {
+      size_t n = 1;
+      for (size_t i = 0; i < depth; ++i) n *= f;
+      return n;
+   };
+   while (total(fan_out) < leaves) ++fan_out;
+   return fan_out;
+}
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+constexpr size_t path_count = size_t(1) << 16; // Distinct random paths, cycled through
+
+template <size_t Depth>
+float native_at(const nested_vector<Depth>& v, const uint64_t* path) {
+   if constexpr (Depth == 1) {
+      return v[path[0]];
+   }
+   else {
+      return native_at<Depth - 1>(v[path[0]], path + 1);
+   }
+}
+
+inline float zero_copy_at(std::string_view buffer, const uint64_t* path, size_t depth) {
+   const std::string_view element = zmem::nested_element(buffer, values_field, {path, depth}, sizeof(float));
+   float v = 0.0f;
+   if (!element.empty()) std::memcpy(&v, element.data(), sizeof(float));
+   return v;
+}
+
+// Mean ns per access over a dependent chain of `accesses`, best of three runs
+template <typename Access>
+double chain_ns(Access&& access, const std::vector<uint64_t>& paths, size_t depth, size_t accesses,
+                double& checksum) {
+   auto run = [&](size_t n) {
+      uint64_t j = 0;
+      float sum = 0.0f;
+      for (size_t a = 0; a < n; ++a) {
+         const float v = access(paths.data() + (j & (path_count - 1)) * depth);
+         sum += v;
+         uint32_t bits;
+         std::memcpy(&bits, &v, sizeof(bits));
+         j += 1 + (bits & 1);
+      }
+      checksum += sum;
+   };
+
+   run(accesses / 10 + 1); // Warmup
+   double best = 0.0;
+   for (int r = 0; r < 3; ++r) {
+      auto start = std::chrono::high_resolution_clock::now();
+      run(accesses);
+      auto end = std::chrono::high_resolution_clock::now();
+      const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+                        double(accesses);
+      if (r == 0 || ns < best) best = ns;
+   }
+   return best;
+}
+
+struct depth_result {
+   size_t depth{};
+   size_t fan_out{};
+   size_t leaves{};
+   size_t bytes{};
+   double zero_copy_ns{};
+   double native_ns{};
+   double lazy_view_ns{}; // Depth 1 only: lazy_zmem_view indexes fixed element vectors
+   double decode_ms{};
+};
+
+template <size_t Depth>
+bool run_depth(size_t fan_out, size_t accesses, depth_result& result, double& checksum) {
+   const NestedMessage<Depth> message = make_message<Depth>(fan_out);
+   std::string buffer;
+   if (auto ec = glz::write_zmem(message, buffer); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, buffer) << "\n";
+      return false;
+   }
+
+   const std::vector<uint64_t> paths = make_paths(path_count, Depth, fan_out);
+
+   // The layout walk must agree with the decoded vectors before it is timed
+   for (size_t p = 0; p < path_count; ++p) {
+      const uint64_t* path = paths.data() + p * Depth;
+      if (zero_copy_at(buffer, path, Depth) != native_at<Depth>(message.values, path)) {
+         std::cerr << "Zero-copy walk disagrees with the decoded vectors at depth " << Depth << "\n";
+         return false;
+      }
+   }
+
+   result = {Depth, fan_out, 0, buffer.size()};
+   result.leaves = 1;
+   for (size_t i = 0; i < Depth; ++i) result.leaves *= fan_out;
+
+   result.zero_copy_ns = chain_ns([&](const uint64_t* path) { return zero_copy_at(buffer, path, Depth); }, paths,
+                                  Depth, accesses, checksum);
+   result.native_ns = chain_ns([&](const uint64_t* path) { return native_at<Depth>(message.values, path); }, paths,
+                               Depth, accesses, checksum);
+   if constexpr (Depth == 1) {
+      result.lazy_view_ns = chain_ns([&](const uint64_t* path) {
+         glz::lazy_zmem_view<NestedMessage<1>> view{buffer};
+         return float(view.get<0>()[path[0]]);
+      }, paths, Depth, accesses, checksum);
+   }
+
+   // What the native rows pay up front
+   NestedMessage<Depth> decoded{};
+   constexpr int decodes = 3;
+   auto start = std::chrono::high_resolution_clock::now();
+   for (int i = 0; i < decodes; ++i) (void)glz::read_zmem(decoded, buffer);
+   auto end = std::chrono::high_resolution_clock::now();
+   result.decode_ms = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / 1e6 /
+                      double(decodes);
+   checksum += double(decoded.id);
+   return true;
+}
+
+bool run_depth(size_t depth, size_t fan_out, size_t accesses, depth_result& result, double& checksum) {
+   switch (depth) {
+      case 1: return run_depth<1>(fan_out, accesses, result, checksum);
+      case 2: return run_depth<2>(fan_out, accesses, result, checksum);
+      case 3: return run_depth<3>(fan_out, accesses, result, checksum);
+      case 4: return run_depth<4>(fan_out, accesses, result, checksum);
+      case 5: return run_depth<5>(fan_out, accesses, result, checksum);
+      default: return false;
+   }
+}
+
+void print_header() {
+   std::cout << "| Depth | Fan-out | Leaves | Wire size (KB) | Zero-copy (ns) | lazy_zmem_view (ns) | std::vector (ns) "
+                "| Zero-copy vs depth 1 | read_zmem (ms) |\n";
+   std::cout << "|-------|---------|--------|----------------|----------------|---------------------|------------------"
+                "|----------------------|----------------|\n";
+}
+
+void print_row(const depth_result& r, double baseline_ns) {
+   std::cout << "| " << r.depth << " | " << r.fan_out << " | " << r.leaves << " | " << double(r.bytes) / 1024.0
+             << " | " << r.zero_copy_ns << " | ";
+   if (r.depth == 1) {
+      std::cout << r.lazy_view_ns;
+   }
+   else {
+      std::cout << "-";
+   }
+   std::cout << " | " << r.native_ns << " | " << r.zero_copy_ns / baseline_ns << "x | " << r.decode_ms << " |\n";
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t leaves = std::max<size_t>(32, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : size_t(1) << 20);
+   const size_t accesses = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1'000'000);
+   constexpr size_t max_depth = 5;
+   constexpr size_t tensor_depth = 3; // [[[f32]]] feature-store tensors
+
+   std::cout << "ZMEM Nested Vector Depth Benchmark\n";
+   std::cout << "==================================\n\n";
+   std::cout << "Leaves: ~" << leaves << " f32, accesses: " << accesses << " (dependent chain over " << path_count
+             << " random paths)\n";
+   std::cout << "lazy_zmem_view only indexes the fixed element vector at depth 1; deeper levels are walked\n"
+                "through their offset tables (zmem::nested_element).\n\n";
+   std::cout << std::fixed << std::setprecision(2);
+
+   double checksum = 0.0;
+   depth_result result;
+
+   // Same number of leaves at every depth: only the number of offset tables changes
+   std::cout << "Constant size, depth 1-" << max_depth << ":\n\n";
+   print_header();
+   double baseline_ns = 0.0;
+   for (size_t depth = 1; depth <= max_depth; ++depth) {
+      if (!run_depth(depth, fan_out_for(leaves, depth), accesses, result, checksum)) return 1;
+      if (depth == 1) baseline_ns = result.zero_copy_ns;
+      print_row(result, baseline_ns);
+   }
+
+   // Fixed depth, growing fan-out: access time should follow cache level, not size
+   std::cout << "\nDepth " << tensor_depth << " ([[[f32]]]), fan-out sweep:\n\n";
+   print_header();
+   for (size_t fan_out = 4; fan_out * fan_out * fan_out <= leaves * 8; fan_out *= 2) {
+      if (!run_depth(tensor_depth, fan_out, accesses, result, checksum)) return 1;
+      // Ratio against a flat [f32] with the same number of leaves
+      depth_result flat;
+      if (!run_depth(1, result.leaves, accesses, flat, checksum)) return 1;
+      print_row(result, flat.zero_copy_ns);
+   }
+
+   std::cout << "\nChecksum: " << static_cast<uint64_t>(checksum) << "\n";
+   return 0;
+}
@@ -0,0 +1,466 @@
+// ZMEM Field Transform Codec
+// Lossless, schema-aware archival codec for ZMEM array messages of fixed elements.
+//
+// Every field of the element type is transposed into its own column and encoded
+// with a transform chosen from the field's primitive type:
+//   f64        -> XOR with previous value, leading/trailing zero bytes elided (Gorilla-style)
+//   integers   -> delta, zigzag, frame-of-reference bit-packing in 128-value frames
+//   f32, other -> byte shuffle by field size, byte delta, run-length (block container codec)
+// Decoding rebuilds the canonical array message (count, elements, zero padding)
+// byte for byte. Input with non-zero padding is rejected as non-canonical.
+
+#pragma once
+
+#include "zmem_block_container.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace zmem {
+
+enum class field_codec_error : uint32_t {
+   none = 0,
+   truncated,
+   bad_magic,
+   element_size_mismatch,
+   non_canonical, // Padding bytes in the input were not zero
+   corrupt,
+};
+
+inline constexpr char field_codec_magic[4] = {'Z', 'M', 'F', 'C'};
+
+namespace detail {
+
+// ----------------------------------------------------------------------------
+// Forward transforms (vectorized where AVX2 is available)
+// ----------------------------------------------------------------------------
+
+// out[i] = in[i] ^ in[i - 1], with in[-1] = 0
+inline void xor_delta_u64(const uint64_t* in, uint64_t* out, size_t n) noexcept {
+   if (n == 0) return;
+   out[0] = in[0];
+   size_t i = 1;
+#if defined(__AVX2__)
+   for (; i + 4 <= n; i += 4) {
+      const __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+      const __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i - 1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(cur, prev));
+   }
+#endif
+   for (; i < n; ++i) {
+      out[i] = in[i] ^ in[i - 1];
+   }
+}
+
+// out[i] = zigzag(in[i] - in[i - 1]), with in[-1] = 0
+inline void delta_zigzag_u64(const uint64_t* in, uint64_t* out, size_t n) noexcept {
+   if (n == 0) return;
+   auto zigzag = [](uint64_t d) { return (d << 1) ^ uint64_t(int64_t(d) >> 63); };
+   out[0] = zigzag(in[0]);
+   size_t i = 1;
+#if defined(__AVX2__)
+   const __m256i zero = _mm256_setzero_si256();
+   for (; i + 4 <= n; i += 4) {
+      const __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+      const __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i - 1));
+      const __m256i d = _mm256_sub_epi64(cur, prev);
+      const __m256i sign = _mm256_cmpgt_epi64(zero, d);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_xor_si256(_mm256_slli_epi64(d, 1), sign));
+   }
+#endif
+   for (; i < n; ++i) {
+      out[i] = zigzag(in[i] - in[i - 1]);
+   }
+}
+
+// ----------------------------------------------------------------------------
+// f64: XOR delta with zero-byte elision
+// ----------------------------------------------------------------------------
+// Per value one control byte (trailing_zero_bytes << 4 | significant_bytes),
+// all control bytes first, then the significant bytes of each XOR.
+
+inline void encode_xor_f64(const uint64_t* bits, size_t n, std::vector<uint64_t>& scratch, std::string& out) {
+   scratch.resize(n);
+   xor_delta_u64(bits, scratch.data(), n);
+
+   const size_t control_pos = out.size();
+   out.resize(control_pos + n);
+   for (size_t i = 0; i < n; ++i) {
+      const uint64_t x = scratch[i];
+      uint8_t control = 0;
+      if (x != 0) {
+         const int tz = std::countr_zero(x) / 8;
+         const int lz = std::countl_zero(x) / 8;
+         const int len = 8 - tz - lz;
+         control = uint8_t((tz << 4) | len);
+         const uint64_t v = x >> (8 * tz);
+         out.append(reinterpret_cast<const char*>(&v), size_t(len));
+      }
+      out[control_pos + i] = char(control);
+   }
+}
+
+inline bool decode_xor_f64(const char* in, size_t in_size, size_t n, uint64_t* bits) noexcept {
+   if (in_size < n) return false;
+   const char* payload = in + n;
+   const char* end = in + in_size;
+   uint64_t prev = 0;
+   for (size_t i = 0; i < n; ++i) {
+      const uint8_t control = uint8_t(in[i]);
+      const int tz = control >> 4;
+      const int len = control & 0xF;
+      if (tz + len > 8 || payload + len > end) return false;
+      uint64_t v = 0;
+      std::memcpy(&v, payload, size_t(len));
+      payload += len;
+      prev ^= v << (8 * tz);
+      bits[i] = prev;
+   }
+   return payload == end;
+}
+
+// ----------------------------------------------------------------------------
+// Integers: delta + zigzag + frame-of-reference bit-packing
+// ----------------------------------------------------------------------------
+// Frames of 128 values: u64 base (minimum), u8 bit width, then (value - base)
+// packed little-endian at that width.
+
+inline constexpr size_t for_frame = 128;
+
+inline void encode_for_u64(const uint64_t* values, size_t n, std::vector<uint64_t>& scratch, std::string& out) {
+   scratch.resize(n);
+   delta_zigzag_u64(values, scratch.data(), n);
+
+   for (size_t first = 0; first < n; first += for_frame) {
+      const size_t count = std::min(for_frame, n - first);
+      const uint64_t* v = scratch.data() + first;
+      uint64_t base = v[0];
+      uint64_t max = v[0];
+      for (size_t i = 1; i < count; ++i) {
+         base = std::min(base, v[i]);
+         max = std::max(max, v[i]);
+      }
+      const uint8_t width = uint8_t(std::bit_width(max - base));
+      out.append(reinterpret_cast<const char*>(&base), 8);
+      out.push_back(char(width));
+      if (width == 0) continue;
+
+      const size_t packed_bytes = (count * width + 7) / 8;
+      const size_t pos = out.size();
+      out.resize(pos + packed_bytes + 8); // Slack for the final 8-byte store
+      char* dst = out.data() + pos;
+      size_t bit = 0;
+      for (size_t i = 0; i < count; ++i, bit += width) {
+         const uint64_t d = v[i] - base;
+         uint64_t word;
+         std::memcpy(&word, dst + bit / 8, 8);
+         word |= d << (bit % 8);
+         std::memcpy(dst + bit / 8, &word, 8);
+         if (bit % 8 + width > 64) {
+            dst[bit / 8 + 8] |= char(d >> (64 - bit % 8));
+         }
+      }
+      out.resize(pos + packed_bytes);
+   }
+}
+
+inline bool decode_for_u64(const char* in, size_t in_size, size_t n, uint64_t* values) noexcept {
+   const char* p = in;
+   const char* end = in + in_size;
+   uint64_t prev = 0;
+   for (size_t first = 0; first < n; first += for_frame) {
+      const size_t count = std::min(for_frame, n - first);
+      if (end - p < 9) return false;
+      uint64_t base;
+      std::memcpy(&base, p, 8);
+      const uint8_t width = uint8_t(p[8]);
+      p += 9;
+      if (width > 64) return false;
+      const size_t packed_bytes = (count * width + 7) / 8;
+      if (size_t(end - p) < packed_bytes) return false;
+
+      const uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+      size_t bit = 0;
+      for (size_t i = 0; i < count; ++i, bit += width) {
+         uint64_t d = 0;
+         if (width) {
+            const size_t byte = bit / 8;
+            const size_t shift = bit % 8;
+            const size_t avail = std::min<size_t>(8, packed_bytes - byte);
+            std::memcpy(&d, p + byte, avail);
+            d >>= shift;
+            if (shift + width > 64) {
+               d |= uint64_t(uint8_t(p[byte + 8])) << (64 - shift);
+            }
+            d &= mask;
+         }
+         const uint64_t z = base + d;
+         prev += (z >> 1) ^ (~(z & 1) + 1); // Undo zigzag, then the delta
+         values[first + i] = prev;
+      }
+      p += packed_bytes;
+   }
+   return p == end;
+}
+
+// ----------------------------------------------------------------------------
+// Columns
+// ----------------------------------------------------------------------------
+
+template <class F>
+inline constexpr bool is_for_integer = std::is_integral_v<F> && !std::is_same_v<F, bool> && sizeof(F) <= 8;
+
+template <class F>
+void encode_column(const char* elements, size_t n, size_t stride, size_t offset, std::vector<uint64_t>& wide,
+                   std::vector<uint64_t>& scratch, std::string& bytes, std::string& out) {
+   if constexpr (std::is_same_v<F, double>) {
+      wide.resize(n);
+      for (size_t i = 0; i < n; ++i) {
+         std::memcpy(&wide[i], elements + i * stride + offset, 8);
+      }
+      encode_xor_f64(wide.data(), n, scratch, out);
+   }
+   else if constexpr (is_for_integer<F>) {
+      wide.resize(n);
+      for (size_t i = 0; i < n; ++i) {
+         F v;
+         std::memcpy(&v, elements + i * stride + offset, sizeof(F));
+         wide[i] = uint64_t(std::conditional_t<std::is_signed_v<F>, int64_t, uint64_t>(v));
+      }
+      encode_for_u64(wide.data(), n, scratch, out);
+   }
+   else {
+      bytes.resize(n * sizeof(F));
+      for (size_t i = 0; i < n; ++i) {
+         std::memcpy(bytes.data() + i * sizeof(F), elements + i * stride + offset, sizeof(F));
+      }
+      std::string shuffled;
+      shuffle_delta_encode(bytes.data(), bytes.size(), sizeof(F), shuffled, out);
+   }
+}
+
+template <class F>
+bool decode_column(const char* in, size_t in_size, size_t n, char* elements, size_t stride, size_t offset,
+                   std::vector<uint64_t>& wide, std::string& bytes) {
+   if constexpr (std::is_same_v<F, double> || is_for_integer<F>) {
+      wide.resize(n);
+      bool ok;
+      if constexpr (std::is_same_v<F, double>) {
+         ok = decode_xor_f64(in, in_size, n, wide.data());
+      }
+      else {
+         ok = decode_for_u64(in, in_size, n, wide.data());
+      }
+      if (!ok) return false;
+      for (size_t i = 0; i < n; ++i) {
+         if constexpr (std::is_same_v<F, double>) {
+            std::memcpy(elements + i * stride + offset, &wide[i], 8);
+         }
+         else {
+            const F v = F(wide[i]);
+            std::memcpy(elements + i * stride + offset, &v, sizeof(F));
+         }
+      }
+   }
+   else {
+      bytes.resize(n * sizeof(F));
+      std::string scratch;
+      if (!shuffle_delta_decode(in, in_size, sizeof(F), bytes.data(), bytes.size(), scratch)) return false;
+      for (size_t i = 0; i < n; ++i) {
+         std::memcpy(elements + i * stride + offset, bytes.data() + i * sizeof(F), sizeof(F));
+      }
+   }
+   return true;
+}
+
+// Most values a column of `length` encoded bytes can describe, so a corrupt element
+// count is rejected before the output is allocated
+template <class F>
+uint64_t max_column_elements(uint64_t length) noexcept {
+   if constexpr (std::is_same_v<F, double>) {
+      return length; // One control byte per value
+   }
+   else if constexpr (is_for_integer<F>) {
+      return length / 9 * for_frame; // At least base and width per frame
+   }
+   else {
+      return length * 65 / sizeof(F); // A 2-byte run decodes to at most 130 bytes
+   }
+}
+
+template <class T, class F>
+size_t member_offset(F T::*member) noexcept {
+   static const T probe{};
+   return size_t(reinterpret_cast<const char*>(&(probe.*member)) - reinterpret_cast<const char*>(&probe));
+}
+
+template <class M>
+struct member_traits;
+
+template <class T, class F>
+struct member_traits<F T::*> {
+   using type = F;
+};
+
+} // namespace detail
+
+// ============================================================================
+// Codec
+// ============================================================================
+
+// Codec for a ZMEM array message `[T]` of fixed elements. The schema is the list of
+// member pointers covering every field of T, e.g.
+//    using tick_codec = zmem::field_codec<Tick, &Tick::timestamp, &Tick::price, &Tick::quantity>;
+// For primitive element types (`[f64]`, `[u32]`, ...) list no members.
+//
+// Encoded layout: magic "ZMFC", u32 field count, u64 element count, u64 sizeof(T),
+// then per field a u64 byte length followed by the encoded column.
+template <class T, auto... Members>
+   requires std::is_trivially_copyable_v<T> && (alignof(T) <= 8)
+struct field_codec {
+   static constexpr size_t field_count = sizeof...(Members) == 0 ? 1 : sizeof...(Members);
+
+   static field_codec_error encode(std::string_view array_message, std::string& out) {
+      if (array_message.size() < 8) return field_codec_error::truncated;
+      uint64_t count;
+      std::memcpy(&count, array_message.data(), 8);
+      if (count > (array_message.size() - 8) / sizeof(T)) return field_codec_error::truncated;
+      const size_t n = size_t(count);
+      if (array_message.size() != detail::padded_size_8(8 + n * sizeof(T))) {
+         return field_codec_error::element_size_mismatch;
+      }
+
+      const char* elements = array_message.data() + 8;
+      if (!is_canonical(elements, n, array_message.data() + array_message.size())) {
+         return field_codec_error::non_canonical;
+      }
+
+      out.clear();
+      out.append(field_codec_magic, 4);
+      const uint32_t fields = field_count;
+      const uint64_t element_size = sizeof(T);
+      out.append(reinterpret_cast<const char*>(&fields), 4);
+      out.append(reinterpret_cast<const char*>(&count), 8);
+      out.append(reinterpret_cast<const char*>(&element_size), 8);
+
+      std::vector<uint64_t> wide;
+      std::vector<uint64_t> scratch;
+      std::string bytes;
+      for_each_field([&]<class F>(size_t offset) {
+         const size_t length_pos = out.size();
+         out.append(8, '\0');
+         detail::encode_column<F>(elements, n, sizeof(T), offset, wide, scratch, bytes, out);
+         const uint64_t length = out.size() - length_pos - 8;
+         std::memcpy(out.data() + length_pos, &length, 8);
+      });
+      return field_codec_error::none;
+   }
+
+   // Writes the canonical ZMEM array message into `array_message`
+   static field_codec_error decode(std::string_view encoded, std::string& array_message) {
+      constexpr size_t header_size = 24;
+      if (encoded.size() < header_size) return field_codec_error::truncated;
+      if (std::memcmp(encoded.data(), field_codec_magic, 4) != 0) return field_codec_error::bad_magic;
+      uint32_t fields;
+      uint64_t count;
+      uint64_t element_size;
+      std::memcpy(&fields, encoded.data() + 4, 4);
+      std::memcpy(&count, encoded.data() + 8, 8);
+      std::memcpy(&element_size, encoded.data() + 16, 8);
+      if (fields != field_count || element_size != sizeof(T)) return field_codec_error::element_size_mismatch;
+
+      // Every column must be complete and able to hold `count` values
+      size_t pos = header_size;
+      bool ok = true;
+      for_each_field([&]<class F>(size_t) {
+         if (!ok) return;
+         uint64_t length;
+         if (encoded.size() - pos < 8) {
+            ok = false;
+            return;
+         }
+         std::memcpy(&length, encoded.data() + pos, 8);
+         pos += 8;
+         if (length > encoded.size() - pos || count > detail::max_column_elements<F>(length)) {
+            ok = false;
+            return;
+         }
+         pos += size_t(length);
+      });
+      if (!ok || pos != encoded.size()) return field_codec_error::corrupt;
+
+      const size_t n = size_t(count);
+      array_message.assign(detail::padded_size_8(8 + n * sizeof(T)), '\0');
+      std::memcpy(array_message.data(), &count, 8);
+      char* elements = array_message.data() + 8;
+
+      // Column lengths were checked above
+      pos = header_size;
+      std::vector<uint64_t> wide;
+      std::string bytes;
+      for_each_field([&]<class F>(size_t offset) {
+         if (!ok) return;
+         uint64_t length;
+         std::memcpy(&length, encoded.data() + pos, 8);
+         pos += 8;
+         ok = detail::decode_column<F>(encoded.data() + pos, size_t(length), n, elements, sizeof(T), offset, wide,
+                                       bytes);
+         pos += size_t(length);
+      });
+      return ok ? field_codec_error::none : field_codec_error::corrupt;
+   }
+
+  private:
+   // fn.template operator()<F>(offset) for each field in schema order
+   template <class Fn>
+   static void for_each_field(Fn&& fn) {
+      if constexpr (sizeof...(Members) == 0) {
+         fn.template operator()<T>(0);
+      }
+      else {
+         (fn.template operator()<typename detail::member_traits<decltype(Members)>::type>(
+             detail::member_offset(Members)),
+          ...);
+      }
+   }
+
+   // Bytes of T not covered by a listed field (padding) and the message end padding must be zero
+   static bool is_canonical(const char* elements, size_t n, const char* end) noexcept {
+      static const std::vector<uint8_t> covered = [] {
+         std::vector<uint8_t> mask(sizeof(T), sizeof...(Members) == 0 ? 1 : 0);
+         if constexpr (sizeof...(Members) > 0) {
+            auto mark = [&]<class F>(size_t offset) { std::memset(mask.data() + offset, 1, sizeof(F)); };
+            (mark.template operator()<typename detail::member_traits<decltype(Members)>::type>(
+                detail::member_offset(Members)),
+             ...);
+         }
+         return mask;
+      }();
+
+      bool has_padding = false;
+      for (auto c : covered) has_padding |= (c == 0);
+      if (has_padding) {
+         for (size_t i = 0; i < n; ++i) {
+            const char* e = elements + i * sizeof(T);
+            for (size_t b = 0; b < sizeof(T); ++b) {
+               if (!covered[b] && e[b] != 0) return false;
+            }
+         }
+      }
+      for (const char* p = elements + n * sizeof(T); p < end; ++p) {
+         if (*p != 0) return false;
+      }
+      return true;
+   }
+};
+
+} // namespace zmem
@@ -0,0 +1,620 @@
+// ZMEM File Benchmark
+// Random element lookups into a locally generated multi-GB ZMEM file.
+//
+// Usage: zmem_file_bench [mode] [size_mb] [lookups] [path]
+//   async      mmap page faults vs. io_uring / pread thread pool (zmem_async_reader.hpp)
+//   prefetch   scans of the mapped records per prefetch distance (zmem_prefetch.hpp)
+//   numa       shared mapping vs. node-local and remote replicas (zmem_numa.hpp)
+//   cold       first-touch mmap lookups after posix_fadvise(DONTNEED): faults, pages read
+//
+// The file is one `Dataset` message whose `records` field holds most of the bytes.
+// It is generated on first use and reused while its size matches. Async and cold runs
+// start with the file evicted from the page cache; the other modes run with it
+// resident (numa keeps one copy per node in memory: size the file accordingly).
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_async_reader.hpp"
+#include "zmem_fixtures.hpp"
+#include "zmem_mapped_file.hpp"
+#include "zmem_numa.hpp"
+#include "zmem_prefetch.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Dataset File
+// ============================================================================
+
+// Dataset::records: vector reference after `id` in the inline section, variable elements
+constexpr zmem::vector_field records_field{8, 0};
+
+// Streams a Dataset message to `path`: elements are written as they are serialized
+// and the offset table is filled in at the end. Returns the record count, 0 on error.
+uint64_t generate_dataset(const std::string& path, uint64_t count) {
+   std::ofstream out(path, std::ios::binary | std::ios::trunc);
+   if (!out) return 0;
+
+   // Size header, inline section {id, records ref}, offset table
+   constexpr uint64_t inline_size = 24;
+   const uint64_t table_bytes = (count + 1) * 8;
+   std::vector<uint64_t> offsets(count + 1);
+   std::string chunk(8 + inline_size + table_bytes, '\0');
+   out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+
+   chunk.clear();
+   std::string message;
+   uint64_t position = 0;
+   for (uint64_t i = 0; i < count; ++i) {
+      offsets[i] = position;
+      message.clear();
+      if (auto ec = glz::write_zmem(make_record(i), message); ec) {
+         std::cerr << "ZMEM write error: " << glz::format_error(ec, message) << "\n";
+         return 0;
+      }
+      chunk.append(message);
+      position += message.size();
+      if (chunk.size() >= (8u << 20)) {
+         out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+         chunk.clear();
+      }
+   }
+   offsets[count] = position;
+   out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+
+   const uint64_t header[4] = {inline_size + table_bytes + position, 1, inline_size, count};
+   out.seekp(0);
+   out.write(reinterpret_cast<const char*>(header), sizeof(header));
+   out.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(table_bytes));
+   return out ? count : 0;
+}
+
+// Reuses an existing file with the expected record count
+uint64_t open_or_generate(const std::string& path, uint64_t size_mb) {
+   const uint64_t count = std::max<uint64_t>(1, (size_mb << 20) / approx_record_bytes);
+   {
+      zmem::mapped_file file{path};
+      zmem::vector_ref ref;
+      if (file.is_open() && zmem::read_vector_ref(file.bytes(), records_field, ref) && ref.count == count &&
+          zmem::message_size(file.bytes()) == file.size()) {
+         return count;
+      }
+   }
+   std::cout << "Generating " << path << " (" << count << " records)...\n";
+   return generate_dataset(path, count);
+}
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+using clock_type = std::chrono::steady_clock;
+
+struct run_result {
+   double seconds{};
+   std::vector<double> latencies_us{};
+   size_t errors{};
+};
+
+double percentile(std::vector<double>& sorted, double p) {
+   if (sorted.empty()) return 0.0;
+   return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * static_cast<double>(sorted.size())))];
+}
+
+void print_row(const std::string& reader, const std::string& depth, run_result& r) {
+   std::sort(r.latencies_us.begin(), r.latencies_us.end());
+   std::cout << "| " << reader << " | " << depth << " | "
+             << static_cast<double>(r.latencies_us.size()) / r.seconds << " | " << percentile(r.latencies_us, 0.50)
+             << " | " << percentile(r.latencies_us, 0.99) << " | " << percentile(r.latencies_us, 0.999) << " | "
+             << r.errors << " |\n";
+}
+
+// Reads the looked-up record through a lazy view and checks it is the one requested
+bool check_record(std::string_view element, uint64_t index, uint64_t& checksum) {
+   glz::lazy_zmem_view<Record> view{element};
+   const uint64_t id = view.get<0>();
+   checksum += view.get<2>().size();
+   return id == index;
+}
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+// Page-fault driven lookups through a shared mapping, split across `threads`
+run_result run_mmap(const std::string& path, const std::vector<uint64_t>& indices, size_t threads,
+                    uint64_t& checksum) {
+   run_result result;
+   zmem::mapped_file file{path};
+   if (!file.is_open()) {
+      result.errors = indices.size();
+      return result;
+   }
+   file.advise(zmem::map_advice::random);
+   const std::string_view message = file.bytes();
+
+   result.latencies_us.resize(indices.size());
+   std::vector<uint64_t> sums(threads);
+   std::vector<size_t> errors(threads);
+   const auto start = clock_type::now();
+   std::vector<std::thread> workers;
+   for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+         for (size_t i = t; i < indices.size(); i += threads) {
+            const auto t0 = clock_type::now();
+            const std::string_view element = zmem::element(message, records_field, indices[i]);
+            if (element.empty() || !check_record(element, indices[i], sums[t])) ++errors[t];
+            result.latencies_us[i] = std::chrono::duration<double, std::micro>(clock_type::now() - t0).count();
+         }
+      });
+   }
+   for (auto& w : workers) w.join();
+   result.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+   for (size_t t = 0; t < threads; ++t) {
+      checksum += sums[t];
+      result.errors += errors[t];
+   }
+   return result;
+}
+
+// Lookups kept `depth` deep through the async reader
+run_result run_async(const std::string& path, const std::vector<uint64_t>& indices, zmem::async_backend backend,
+                     uint32_t depth, bool direct, uint64_t& checksum, std::string& backend_used) {
+   run_result result;
+   const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | (direct ? O_DIRECT : 0));
+   if (fd < 0) {
+      result.errors = indices.size();
+      return result;
+   }
+
+   zmem::async_reader_options opts{};
+   opts.backend = backend;
+   opts.queue_depth = depth;
+   opts.buffer_count = depth;
+   opts.buffer_size = 16 * 1024;
+   opts.alignment = direct ? 4096 : 0;
+   opts.threads = std::min<uint32_t>(depth, 16);
+
+   {
+      zmem::async_file_reader io{fd, opts};
+      backend_used = zmem::async_backend_name(io.backend());
+      zmem::async_vector_reader reader{io, records_field};
+      if (reader.open() != zmem::lookup_status::ok) {
+         ::close(fd);
+         result.errors = indices.size();
+         return result;
+      }
+
+      std::vector<clock_type::time_point> issued(indices.size());
+      result.latencies_us.resize(indices.size());
+      size_t next = 0;
+      size_t done = 0;
+      const auto start = clock_type::now();
+      while (done < indices.size()) {
+         while (next < indices.size()) {
+            issued[next] = clock_type::now();
+            if (!reader.lookup(indices[next], next)) break;
+            ++next;
+         }
+         done += reader.poll([&](uint64_t tag, zmem::lookup_status status, std::string_view element) {
+            if (status != zmem::lookup_status::ok || !check_record(element, indices[tag], checksum)) {
+               ++result.errors;
+            }
+            result.latencies_us[tag] =
+               std::chrono::duration<double, std::micro>(clock_type::now() - issued[tag]).count();
+         });
+      }
+      result.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+   }
+   ::close(fd);
+   return result;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int run_async_mode(const std::string& path, uint64_t count, size_t lookups) {
+   std::mt19937_64 rng{29};
+   std::vector<uint64_t> indices(lookups);
+   for (auto& i : indices) i = rng() % count;
+
+   if (!zmem::drop_page_cache(path)) {
+      std::cout << "Note: could not evict the file from the page cache, runs may be warm\n";
+   }
+
+   uint64_t checksum = 0;
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "\n| Reader | Depth | Lookups/s | p50 (us) | p99 (us) | p99.9 (us) | Errors |\n";
+   std::cout << "|--------|-------|-----------|----------|----------|------------|--------|\n";
+
+   for (const size_t threads : {size_t(1), size_t(16)}) {
+      zmem::drop_page_cache(path);
+      run_result r = run_mmap(path, indices, threads, checksum);
+      print_row("mmap", std::to_string(threads) + (threads == 1 ? " thread" : " threads"), r);
+   }
+
+   struct async_case {
+      zmem::async_backend backend;
+      uint32_t depth;
+      bool direct;
+   };
+   for (const async_case c : {async_case{zmem::async_backend::io_uring, 1, false},
+                              async_case{zmem::async_backend::io_uring, 16, false},
+                              async_case{zmem::async_backend::io_uring, 64, false},
+                              async_case{zmem::async_backend::io_uring, 256, false},
+                              async_case{zmem::async_backend::io_uring, 64, true},
+                              async_case{zmem::async_backend::thread_pool, 64, false}}) {
+      zmem::drop_page_cache(path);
+      std::string backend;
+      run_result r = run_async(path, indices, c.backend, c.depth, c.direct, checksum, backend);
+      if (r.latencies_us.empty()) {
+         std::cout << "| " << zmem::async_backend_name(c.backend) << (c.direct ? " O_DIRECT" : "")
+                   << " | " << c.depth << " | unavailable | - | - | - | - |\n";
+         continue;
+      }
+      print_row(backend + (c.direct ? " O_DIRECT" : ""), std::to_string(c.depth), r);
+   }
+
+   std::cout << "\nChecksum: " << checksum << "\n";
+   return 0;
+}
+
+// Reads the inline fields of a record, as a replay loop filtering on them would
+inline uint64_t touch_record(std::string_view element) {
+   glz::lazy_zmem_view<Record> view{element};
+   const uint64_t id = view.get<0>();
+   return id + static_cast<uint64_t>(static_cast<double>(view.get<1>()));
+}
+
+// Best of three runs, in ns per element
+template <class Func>
+double scan_ns(Func&& func, size_t elements) {
+   double best = 0.0;
+   for (int run = 0; run < 3; ++run) {
+      const auto start = clock_type::now();
+      func();
+      const double ns = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+      if (run == 0 || ns < best) best = ns;
+   }
+   return best / static_cast<double>(elements);
+}
+
+int run_prefetch_mode(const std::string& path, uint64_t count, size_t lookups) {
+   zmem::mapped_file file{path};
+   if (!file.is_open()) {
+      std::cerr << "Could not map " << path << "\n";
+      return 1;
+   }
+   // Fault every page in first: prefetches hide cache and TLB misses, not page faults
+   file.advise(zmem::map_advice::willneed);
+   uint64_t checksum = 0;
+   for (size_t p = 0; p < file.size(); p += 4096) checksum += uint8_t(file.data()[p]);
+
+   const zmem::variable_vector_view records{file.bytes(), records_field};
+   if (!records.valid() || records.size() != count) {
+      std::cerr << "Unexpected layout in " << path << "\n";
+      return 1;
+   }
+   // The records are back-to-back messages, so they double as a message log
+   const std::string_view first = records[0];
+   const zmem::message_log_view log{
+      file.bytes().substr(size_t(first.data() - file.data()), size_t(records[count - 1].data() - first.data()) +
+                                                                  records[count - 1].size())};
+
+   std::mt19937_64 rng{31};
+   std::vector<uint64_t> indices(lookups);
+   for (auto& i : indices) i = rng() % count;
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "\n| Distance | Sequential scan (ns/elem) | Random gather (ns/elem) | Message log (ns/elem) |\n";
+   std::cout << "|----------|---------------------------|-------------------------|-----------------------|\n";
+
+   auto row = [&](const zmem::prefetch_options& opts) {
+      uint32_t scan_distance = 0;
+      uint32_t gather_distance = 0;
+      uint32_t log_distance = 0;
+      const double scan = scan_ns([&] {
+         auto range = records.scan(opts);
+         for (const auto element : range) checksum += touch_record(element);
+         scan_distance = range.distance();
+      }, count);
+      const double gather = scan_ns([&] {
+         auto range = records.gather(indices.data(), indices.size(), opts);
+         for (const auto element : range) checksum += touch_record(element);
+         gather_distance = range.distance();
+      }, indices.size());
+      const double log_scan = scan_ns([&] {
+         auto it = log.begin(opts);
+         for (; it != log.end(); ++it) checksum += touch_record(*it);
+         log_distance = it.distance();
+      }, count);
+
+      if (opts.auto_tune) {
+         std::cout << "| auto (" << scan_distance << "/" << gather_distance << "/" << log_distance << ") | ";
+      }
+      else {
+         std::cout << "| " << opts.distance << " | ";
+      }
+      std::cout << scan << " | " << gather << " | " << log_scan << " |\n";
+   };
+
+   for (const uint32_t distance : {0u, 1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+      zmem::prefetch_options opts{};
+      opts.distance = distance;
+      row(opts);
+   }
+   zmem::prefetch_options tuned{};
+   tuned.auto_tune = true;
+   row(tuned);
+
+   std::cout << "\nChecksum: " << checksum << "\n";
+   return 0;
+}
+
+struct numa_result {
+   double lookups_per_s{};
+   double scan_gb_s{};
+   size_t threads{};
+   size_t errors{};
+};
+
+// Threads pinned to every node; each looks up records in, then scans a slice of,
+// the view `view_for(node)` returns
+template <class ViewFor>
+numa_result run_numa(const zmem::numa_topology& topology, ViewFor&& view_for, const std::vector<uint64_t>& indices,
+                     uint64_t& checksum) {
+   numa_result result;
+   std::vector<size_t> thread_nodes;
+   for (size_t n = 0; n < topology.node_count(); ++n) {
+      const size_t threads = std::min<size_t>(topology.node(n).cpus.size(), 8);
+      for (size_t t = 0; t < threads; ++t) thread_nodes.push_back(n);
+   }
+   result.threads = thread_nodes.size();
+
+   std::vector<uint64_t> sums(result.threads);
+   std::vector<size_t> errors(result.threads);
+   std::vector<double> lookup_seconds(result.threads);
+   std::vector<double> scan_seconds(result.threads);
+   std::vector<size_t> scanned(result.threads);
+   std::vector<std::thread> workers;
+   for (size_t t = 0; t < result.threads; ++t) {
+      workers.emplace_back([&, t] {
+         topology.pin_current_thread(thread_nodes[t]);
+         const std::string_view message = view_for(thread_nodes[t]);
+
+         auto start = clock_type::now();
+         for (size_t i = t; i < indices.size(); i += result.threads) {
+            const std::string_view element = zmem::element(message, records_field, indices[i]);
+            if (element.empty() || !check_record(element, indices[i], sums[t])) ++errors[t];
+         }
+         lookup_seconds[t] = std::chrono::duration<double>(clock_type::now() - start).count();
+
+         const size_t slice = message.size() / result.threads / 8 * 8;
+         const char* p = message.data() + t * slice;
+         uint64_t sum = 0;
+         start = clock_type::now();
+         for (size_t b = 0; b < slice; b += 8) sum += zmem::detail::load_u64(p + b);
+         scan_seconds[t] = std::chrono::duration<double>(clock_type::now() - start).count();
+         sums[t] += sum;
+         scanned[t] = slice;
+      });
+   }
+   for (auto& w : workers) w.join();
+
+   // Aggregate rates from the slowest thread, as all threads run concurrently
+   double lookup_wall = 0.0;
+   double scan_wall = 0.0;
+   size_t scan_bytes = 0;
+   for (size_t t = 0; t < result.threads; ++t) {
+      lookup_wall = std::max(lookup_wall, lookup_seconds[t]);
+      scan_wall = std::max(scan_wall, scan_seconds[t]);
+      scan_bytes += scanned[t];
+      checksum += sums[t];
+      result.errors += errors[t];
+   }
+   result.lookups_per_s = static_cast<double>(indices.size()) / lookup_wall;
+   result.scan_gb_s = static_cast<double>(scan_bytes) / scan_wall / 1e9;
+   return result;
+}
+
+int run_numa_mode(const std::string& path, uint64_t count, size_t lookups) {
+   zmem::mapped_file file{path};
+   if (!file.is_open()) {
+      std::cerr << "Could not map " << path << "\n";
+      return 1;
+   }
+   file.advise(zmem::map_advice::willneed);
+   uint64_t checksum = 0;
+   for (size_t p = 0; p < file.size(); p += 4096) checksum += uint8_t(file.data()[p]);
+
+   zmem::numa_topology topology = zmem::numa_topology::detect();
+   if (topology.node_count() < 2) {
+      std::cout << "Single NUMA node: simulating 2 nodes (local and remote replicas share memory)\n";
+      topology = zmem::numa_topology::simulated(2);
+   }
+   const zmem::replicated_region region{file.bytes(), topology};
+   if (!region.replicated()) {
+      std::cerr << "Could not allocate " << topology.node_count() << " replicas of " << path << "\n";
+      return 1;
+   }
+   for (size_t n = 0; n < topology.node_count(); ++n) {
+      const int placed = zmem::node_of_address(region.on_node(n).data());
+      std::cout << "Node " << topology.node(n).id << ": " << topology.node(n).cpus.size() << " CPUs, replica on node "
+                << (placed < 0 ? std::string{"?"} : std::to_string(placed)) << "\n";
+   }
+
+   std::mt19937_64 rng{33};
+   std::vector<uint64_t> indices(lookups);
+   for (auto& i : indices) i = rng() % count;
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "\n| Source | Threads | Lookups/s | Scan (GB/s) | Errors |\n";
+   std::cout << "|--------|---------|-----------|-------------|--------|\n";
+
+   const auto print = [](const char* source, const numa_result& r) {
+      std::cout << "| " << source << " | " << r.threads << " | " << r.lookups_per_s << " | " << std::setprecision(2)
+                << r.scan_gb_s << std::setprecision(1) << " | " << r.errors << " |\n";
+   };
+   const size_t nodes = topology.node_count();
+   print("Shared mapping", run_numa(topology, [&](size_t) { return file.bytes(); }, indices, checksum));
+   print("Local replica", run_numa(topology, [&](size_t) { return region.local(); }, indices, checksum));
+   print("Remote replica",
+         run_numa(topology, [&](size_t node) { return region.on_node((node + 1) % nodes); }, indices, checksum));
+
+   std::cout << "\nChecksum: " << checksum << "\n";
+   return 0;
+}
+
+// ============================================================================
+// First-Touch Lookups
+// ============================================================================
+
+struct io_counters {
+   uint64_t major_faults{};
+   uint64_t minor_faults{};
+   int64_t read_bytes{-1}; // Fetched from the storage layer (/proc/self/io), -1 if unavailable
+};
+
+io_counters read_io_counters() {
+   io_counters c;
+   rusage usage{};
+   if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+      c.major_faults = uint64_t(usage.ru_majflt);
+      c.minor_faults = uint64_t(usage.ru_minflt);
+   }
+   std::ifstream io("/proc/self/io");
+   for (std::string key; io >> key;) {
+      int64_t value = 0;
+      if (!(io >> value)) break;
+      if (key == "read_bytes:") c.read_bytes = value;
+   }
+   return c;
+}
+
+struct cold_result {
+   run_result lookups{};
+   io_counters delta{};
+   size_t resident_bytes{};
+};
+
+// Lookups through a fresh mapping of the evicted file. Latency includes the page
+// faults; residency and counters show how much of the file each lookup pulled in.
+cold_result run_cold(const std::string& path, const std::vector<uint64_t>& indices, zmem::map_advice advice,
+                     uint64_t& checksum) {
+   cold_result result;
+   zmem::drop_page_cache(path);
+   zmem::mapped_file file{path};
+   if (!file.is_open()) {
+      result.lookups.errors = indices.size();
+      return result;
+   }
+   file.advise(advice);
+   const std::string_view message = file.bytes();
+   const size_t resident_before = file.resident_bytes();
+
+   result.lookups.latencies_us.resize(indices.size());
+   const io_counters before = read_io_counters();
+   const auto start = clock_type::now();
+   for (size_t i = 0; i < indices.size(); ++i) {
+      const auto t0 = clock_type::now();
+      const std::string_view element = zmem::element(message, records_field, indices[i]);
+      if (element.empty() || !check_record(element, indices[i], checksum)) ++result.lookups.errors;
+      result.lookups.latencies_us[i] = std::chrono::duration<double, std::micro>(clock_type::now() - t0).count();
+   }
+   result.lookups.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+   const io_counters after = read_io_counters();
+
+   result.delta.major_faults = after.major_faults - before.major_faults;
+   result.delta.minor_faults = after.minor_faults - before.minor_faults;
+   if (before.read_bytes >= 0 && after.read_bytes >= 0) result.delta.read_bytes = after.read_bytes - before.read_bytes;
+   result.resident_bytes = file.resident_bytes() - std::min(resident_before, file.resident_bytes());
+   return result;
+}
+
+int run_cold_mode(const std::string& path, uint64_t count, size_t lookups) {
+   std::mt19937_64 rng{41};
+   std::vector<uint64_t> indices(lookups);
+   for (auto& i : indices) i = rng() % count;
+
+   if (!zmem::drop_page_cache(path)) {
+      std::cout << "Note: could not evict the file from the page cache, lookups may be warm\n";
+   }
+   {
+      zmem::mapped_file file{path};
+      std::cout << "Resident after eviction: " << file.resident_bytes() / 1024 << " KB of " << file.size() / 1024
+                << " KB\n";
+   }
+
+   uint64_t checksum = 0;
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "\n| Advice | Lookups/s | p50 (us) | p99 (us) | Major faults/lookup | Minor faults/lookup "
+                "| Resident KB/lookup | Read KB/lookup | Errors |\n";
+   std::cout << "|--------|-----------|----------|----------|---------------------|---------------------"
+                "|--------------------|----------------|--------|\n";
+
+   struct cold_case {
+      const char* name;
+      zmem::map_advice advice;
+   };
+   for (const cold_case c : {cold_case{"MADV_RANDOM", zmem::map_advice::random},
+                             cold_case{"default readahead", zmem::map_advice::normal}}) {
+      cold_result r = run_cold(path, indices, c.advice, checksum);
+      std::sort(r.lookups.latencies_us.begin(), r.lookups.latencies_us.end());
+      const double n = static_cast<double>(std::max<size_t>(1, indices.size()));
+      std::cout << "| " << c.name << " | " << n / r.lookups.seconds << " | " << percentile(r.lookups.latencies_us, 0.50)
+                << " | " << percentile(r.lookups.latencies_us, 0.99) << " | " << std::setprecision(2)
+                << static_cast<double>(r.delta.major_faults) / n << " | "
+                << static_cast<double>(r.delta.minor_faults) / n << " | "
+                << static_cast<double>(r.resident_bytes) / 1024.0 / n << " | ";
+      if (r.delta.read_bytes >= 0) {
+         std::cout << static_cast<double>(r.delta.read_bytes) / 1024.0 / n;
+      }
+      else {
+         std::cout << "-";
+      }
+      std::cout << std::setprecision(1) << " | " << r.lookups.errors << " |\n";
+   }
+
+   std::cout << "\nA lookup touches the offset table entry and the record: 2 pages when both miss.\n";
+   std::cout << "Use lookups well below the file's page count so most of them are first touches.\n";
+   std::cout << "\nChecksum: " << checksum << "\n";
+   return 0;
+}
+
+int main(int argc, char** argv) {
+   const std::string mode = argc > 1 ? argv[1] : "async";
+   const uint64_t size_mb = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4096;
+   const size_t lookups = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200'000;
+   const std::string path = argc > 4 ? argv[4] : "zmem_file_bench.zmem";
+
+   std::cout << "ZMEM File Benchmark\n";
+   std::cout << "===================\n\n";
+
+   const uint64_t count = open_or_generate(path, size_mb);
+   if (count == 0) {
+      std::cerr << "Could not create " << path << "\n";
+      return 1;
+   }
+   std::cout << "File: " << path << " (" << count << " records, ~" << size_mb << " MB)\n";
+   std::cout << "Lookups: " << lookups << " random records\n";
+
+   if (mode == "async") return run_async_mode(path, count, lookups);
+   if (mode == "prefetch") return run_prefetch_mode(path, count, lookups);
+   if (mode == "numa") return run_numa_mode(path, count, lookups);
+   if (mode == "cold") return run_cold_mode(path, count, lookups);
+
+   std::cerr << "Unknown mode: " << mode << " (expected: async, prefetch, numa, cold)\n";
+   return 1;
+}
@@ -0,0 +1,318 @@
+// ZMEM Benchmark Fixtures
+// Shared test data used by the ZMEM-only benchmark targets
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Test Data Structures
+// ============================================================================
+
+struct Vec3 {
+   double x{};
+   double y{};
+   double z{};
+};
+
+struct NestedObject {
+   std::vector<Vec3> v3s{};
+   std::string id{};
+};
+
+struct AnotherObject {
+   std::string string{};
+   std::string another_string{};
+   std::string escaped_text{};
+   bool boolean{};
+   NestedObject nested_object{};
+};
+
+struct FixedObject {
+   std::vector<int32_t> int_array{};
+   std::vector<float> float_array{};
+   std::vector<double> double_array{};
+};
+
+struct FixedNameObject {
+   std::string name0{};
+   std::string name1{};
+   std::string name2{};
+   std::string name3{};
+   std::string name4{};
+};
+
+struct TestObj {
+   FixedObject fixed_object{};
+   FixedNameObject fixed_name_object{};
+   AnotherObject another_object{};
+   std::vector<std::string> string_array{};
+   std::string string{};
+   double number{};
+   bool boolean{};
+   bool another_bool{};
+};
+
+// ============================================================================
+// Test Data Initialization
+// ============================================================================
+
+inline TestObj create_test_data() {
+   TestObj obj;
+
+   // Fixed object
+   obj.fixed_object.int_array = {0, 1, 2, 3, 4, 5, 6};
+   obj.fixed_object.float_array = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f};
+   obj.fixed_object.double_array = {3288398.238, 233e22, 289e-1, 0.928759872, 0.22222848, 0.1, 0.2, 0.3, 0.4};
+
+   // Fixed name object
+   obj.fixed_name_object.name0 = "James";
+   obj.fixed_name_object.name1 = "Abraham";
+   obj.fixed_name_object.name2 = "Susan";
+   obj.fixed_name_object.name3 = "Frank";
+   obj.fixed_name_object.name4 = "Alicia";
+
+   // Another object
+   obj.another_object.string = "here is some text";
+   obj.another_object.another_string = "Hello World";
+   obj.another_object.escaped_text = R"({"some key":"some string value"})";
+   obj.another_object.boolean = false;
+   obj.another_object.nested_object.v3s = {
+      {0.12345, 0.23456, 0.001345},
+      {0.3894675, 97.39827, 297.92387},
+      {18.18, 87.289, 2988.298}
+   };
+   obj.another_object.nested_object.id = "298728949872";
+
+   // String array
+   obj.string_array = {"Cat", "Dog", "Elephant", "Tiger"};
+
+   // Simple fields
+   obj.string = "Hello world";
+   obj.number = 3.14;
+   obj.boolean = true;
+   obj.another_bool = false;
+
+   return obj;
+}
+
+// ============================================================================
+// Synthetic Tick Data
+// ============================================================================
+
+// Fixed struct typical of market data archives
+struct Tick {
+   uint64_t timestamp{};
+   double price{};
+   uint32_t quantity{};
+   uint32_t flags{};
+};
+
+inline std::vector<Tick> create_ticks(size_t count) {
+   std::vector<Tick> ticks(count);
+   std::mt19937_64 rng{42};
+   uint64_t timestamp = 1'700'000'000'000'000'000ull;
+   double price = 100.0;
+   for (auto& t : ticks) {
+      timestamp += 1000 + rng() % 4000;
+      price += (static_cast<int>(rng() % 5) - 2) * 0.01;
+      t.timestamp = timestamp;
+      t.price = price;
+      t.quantity = static_cast<uint32_t>(1 + rng() % 500);
+      t.flags = (rng() % 16 == 0) ? 1u : 0u;
+   }
+   return ticks;
+}
+
+// ============================================================================
+// Synthetic Record Data
+// ============================================================================
+
+// Variable struct element of the large `Dataset` messages used by file-backed benchmarks
+struct Record {
+   uint64_t id{};
+   double score{};
+   std::vector<float> features{};
+   std::string label{};
+};
+
+struct Dataset {
+   uint64_t id{};
+   std::vector<Record> records{};
+};
+
+// Average serialized Record size, used to size datasets
+constexpr uint64_t approx_record_bytes = 592;
+
+inline uint64_t mix(uint64_t x) {
+   x += 0x9E3779B97F4A7C15ull;
+   x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+   x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+   return x ^ (x >> 31);
+}
+
+inline Record make_record(uint64_t i) {
+   const uint64_t h = mix(i);
+   Record r;
+   r.id = i;
+   r.score = static_cast<double>(h % 10000) * 0.01;
+   r.features.resize(16 + h % 225);
+   for (size_t k = 0; k < r.features.size(); ++k) {
+      r.features[k] = static_cast<float>(k) * 0.5f + static_cast<float>(i % 97);
+   }
+   r.label = "record-" + std::to_string(i);
+   return r;
+}
+
+// ============================================================================
+// Synthetic Quote Data
+// ============================================================================
+
+// Fixed struct with tail padding, for encoders that must zero padding bytes
+struct Quote {
+   uint64_t id{};
+   int64_t timestamp{};
+   double bid{};
+   double ask{};
+   uint32_t bid_size{};
+   uint32_t ask_size{};
+   uint8_t side{};
+   uint8_t venue{};
+   // 6 bytes of tail padding
+};
+
+// Storage is filled with 0xAB first, so padding bytes are nonzero as they would be in
+// structs built on the stack or copied from the network
+inline std::vector<Quote> make_quotes(size_t count) {
+   std::vector<Quote> quotes(count);
+   std::memset(static_cast<void*>(quotes.data()), 0xAB, count * sizeof(Quote));
+   for (size_t i = 0; i < count; ++i) {
+      const uint64_t h = mix(i);
+      Quote& q = quotes[i];
+      q.id = i;
+      q.timestamp = int64_t(1'700'000'000'000'000'000ll + int64_t(i) * 1000);
+      q.bid = 100.0 + double(h % 1000) * 0.01;
+      q.ask = q.bid + 0.01;
+      q.bid_size = uint32_t(h % 5000);
+      q.ask_size = uint32_t((h >> 16) % 5000);
+      q.side = uint8_t(h & 1);
+      q.venue = uint8_t((h >> 8) % 16);
+   }
+   return quotes;
+}
+
+// ============================================================================
+// Synthetic Shapes
+// ============================================================================
+
+// Message shapes for size sweeps. Each make_* function targets a serialized size in
+// bytes from the layout rules; messages never go below one element, so the smallest
+// targets overshoot. Benchmarks report the actual size.
+
+struct FixedShape {
+   std::vector<Tick> ticks{};
+};
+
+struct VectorShape {
+   std::vector<double> doubles{};
+   std::vector<float> floats{};
+   std::vector<int32_t> ints{};
+   std::vector<uint64_t> ids{};
+};
+
+struct StringShape {
+   std::vector<std::string> strings{};
+};
+
+struct DeepLeaf {
+   uint64_t id{};
+   std::vector<double> values{};
+};
+
+struct DeepGroup {
+   std::vector<DeepLeaf> leaves{};
+   std::string name{};
+};
+
+struct DeepShape {
+   std::vector<DeepGroup> groups{};
+};
+
+struct MapShape {
+   std::map<uint64_t, double> values{};
+};
+
+// Elements that fit in `bytes` after `overhead`, at least one
+inline size_t shape_elements(size_t bytes, size_t overhead, size_t per_element) {
+   return std::max<size_t>(1, bytes > overhead ? (bytes - overhead) / per_element : 0);
+}
+
+// Size header + vector reference, 24 bytes per Tick
+inline FixedShape make_fixed_shape(size_t bytes) { return {create_ticks(shape_elements(bytes, 24, 24))}; }
+
+// Four references, 24 bytes per row across the four vectors
+inline VectorShape make_vector_shape(size_t bytes) {
+   const size_t n = shape_elements(bytes, 72, 24);
+   VectorShape shape;
+   shape.doubles.resize(n);
+   shape.floats.resize(n);
+   shape.ints.resize(n);
+   shape.ids.resize(n);
+   for (size_t i = 0; i < n; ++i) {
+      shape.doubles[i] = static_cast<double>(i) * 0.25;
+      shape.floats[i] = static_cast<float>(i % 1000) * 0.5f;
+      shape.ints[i] = static_cast<int32_t>(i % 65536) - 32768;
+      shape.ids[i] = mix(i);
+   }
+   return shape;
+}
+
+// 4-35 character strings: ~20 bytes plus an 8 byte offset table entry each
+inline StringShape make_string_shape(size_t bytes) {
+   const size_t n = shape_elements(bytes, 32, 28);
+   StringShape shape;
+   shape.strings.resize(n);
+   for (size_t i = 0; i < n; ++i) {
+      const uint64_t h = mix(i);
+      shape.strings[i].assign(4 + h % 32, char('a' + h % 26));
+   }
+   return shape;
+}
+
+// Groups of 8 leaves with 4 values: three levels of [VariableStruct], ~640 bytes per group
+inline DeepShape make_deep_shape(size_t bytes) {
+   DeepShape shape;
+   shape.groups.resize(shape_elements(bytes, 32, 640));
+   uint64_t id = 0;
+   for (auto& group : shape.groups) {
+      group.leaves.resize(8);
+      for (auto& leaf : group.leaves) {
+         leaf.id = id++;
+         leaf.values = {1.0, 2.0, 3.0, static_cast<double>(leaf.id)};
+      }
+      group.name = "group";
+   }
+   return shape;
+}
+
+// Fixed map<u64, f64>: 16 byte entries, even keys
+inline MapShape make_map_shape(size_t bytes) {
+   MapShape shape;
+   const size_t n = shape_elements(bytes, 24, 16);
+   for (size_t i = 0; i < n; ++i) shape.values.emplace_hint(shape.values.end(), i * 2, static_cast<double>(i));
+   return shape;
+}
+
+// Records of ~592 bytes plus an 8 byte offset table entry
+inline Dataset make_dataset(size_t bytes) {
+   Dataset dataset{1, {}};
+   dataset.records.resize(shape_elements(bytes, 32, approx_record_bytes + 8));
+   for (size_t i = 0; i < dataset.records.size(); ++i) dataset.records[i] = make_record(i);
+   return dataset;
+}
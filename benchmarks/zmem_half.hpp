@@ -0,0 +1,474 @@
+// ZMEM Half-Precision Conversion
+// Bulk f16/bf16 <-> f32 conversion and zero-copy views over `[f16]` / `[bf16]` data.
+//
+// Half-precision values travel as uint16_t bit patterns (see "Half-Precision Types"
+// in docs/ZMEM_FORMAT.md), so a `[f16]`/`[bf16]` field is read zero-copy as a
+// std::span<const uint16_t> and widened in bulk. Conversion paths are selected at
+// runtime: AVX-512 BF16, AVX-512F, AVX2 + F16C, or a portable scalar fallback.
+// All paths round to nearest even and agree bit for bit, except that the AVX-512 BF16
+// f32 -> bf16 instruction flushes f32 denormals to zero.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ZMEM_HALF_X86 1
+#include <immintrin.h>
+#endif
+
+namespace zmem {
+
+// ============================================================================
+// Scalar Conversion
+// ============================================================================
+
+inline float f16_to_f32(uint16_t h) noexcept {
+   const uint32_t sign = uint32_t(h & 0x8000) << 16;
+   const uint32_t exponent = (h >> 10) & 0x1F;
+   uint32_t mantissa = h & 0x3FF;
+
+   uint32_t bits;
+   if (exponent == 0x1F) {
+      // Inf, or NaN quieted with its payload kept (matches VCVTPH2PS)
+      bits = sign | 0x7F800000 | (mantissa ? 0x400000 : 0) | (mantissa << 13);
+   }
+   else if (exponent != 0) {
+      bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+   }
+   else if (mantissa == 0) {
+      bits = sign; // +-0
+   }
+   else {
+      // Subnormal f16 -> normal f32
+      int e = -1;
+      do {
+         ++e;
+         mantissa <<= 1;
+      } while ((mantissa & 0x400) == 0);
+      bits = sign | uint32_t(112 - e) << 23 | ((mantissa & 0x3FF) << 13);
+   }
+   return std::bit_cast<float>(bits);
+}
+
+inline uint16_t f32_to_f16(float f) noexcept {
+   const uint32_t bits = std::bit_cast<uint32_t>(f);
+   const uint16_t sign = uint16_t((bits >> 16) & 0x8000);
+   const uint32_t abs = bits & 0x7FFFFFFF;
+
+   if (abs >= 0x7F800000) {
+      // Inf stays Inf, NaN stays a quiet NaN with the top payload bits
+      return uint16_t(sign | 0x7C00 | (abs > 0x7F800000 ? (0x200 | ((abs >> 13) & 0x3FF)) : 0));
+   }
+   if (abs >= 0x477FF000) {
+      return uint16_t(sign | 0x7C00); // Rounds to a value beyond 65504 -> Inf
+   }
+   if (abs >= 0x38800000) {
+      // Normal range: rebias and round to nearest even
+      const uint32_t rounded = abs + 0xFFF + ((abs >> 13) & 1);
+      return uint16_t(sign | ((rounded - 0x38000000) >> 13));
+   }
+   if (abs < 0x33000001) {
+      return sign; // Below half the smallest subnormal -> +-0
+   }
+   // Subnormal f16
+   const uint32_t exponent = abs >> 23;
+   const uint32_t mantissa = (abs & 0x7FFFFF) | 0x800000;
+   const uint32_t shift = 126 - exponent;
+   const uint32_t half_ulp = 1u << (shift - 1);
+   const uint32_t remainder = mantissa & ((1u << shift) - 1);
+   uint32_t result = mantissa >> shift;
+   if (remainder > half_ulp || (remainder == half_ulp && (result & 1))) {
+      ++result;
+   }
+   return uint16_t(sign | result);
+}
+
+inline float bf16_to_f32(uint16_t h) noexcept { return std::bit_cast<float>(uint32_t(h) << 16); }
+
+inline uint16_t f32_to_bf16(float f) noexcept {
+   const uint32_t bits = std::bit_cast<uint32_t>(f);
+   if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+      return uint16_t((bits >> 16) | 0x40); // Quiet NaN, sign and top payload preserved
+   }
+   return uint16_t((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16);
+}
+
+// ============================================================================
+// Instruction Set Selection
+// ============================================================================
+
+enum class half_isa : uint32_t {
+   scalar,
+   avx2_f16c,
+   avx512f,
+   avx512_bf16, // AVX-512F plus native f32 -> bf16 conversion
+};
+
+inline half_isa detect_half_isa() noexcept {
+#if defined(ZMEM_HALF_X86)
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+      if (__builtin_cpu_supports("avx512bf16")) return half_isa::avx512_bf16;
+      return half_isa::avx512f;
+   }
+   if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c")) return half_isa::avx2_f16c;
+#endif
+   return half_isa::scalar;
+}
+
+inline half_isa best_half_isa() noexcept {
+   static const half_isa isa = detect_half_isa();
+   return isa;
+}
+
+inline const char* half_isa_name(half_isa isa) noexcept {
+   switch (isa) {
+      case half_isa::scalar: return "scalar";
+      case half_isa::avx2_f16c: return "AVX2+F16C";
+      case half_isa::avx512f: return "AVX-512F";
+      case half_isa::avx512_bf16: return "AVX-512 BF16";
+   }
+   return "unknown";
+}
+
+// ============================================================================
+// Vector Kernels
+// ============================================================================
+
+namespace detail {
+
+#if defined(ZMEM_HALF_X86)
+
+// GCC 12 reports false positives from the AVX-512 intrinsic headers when they are
+// inlined into target("...") functions
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+// ----------------------------------------------------------------------------
+// AVX2 + F16C (8 lanes)
+// ----------------------------------------------------------------------------
+
+__attribute__((target("avx2,f16c"))) inline size_t f16_to_f32_avx2(const uint16_t* in, float* out,
+                                                                     size_t n) noexcept {
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+      _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+   }
+   return i;
+}
+
+__attribute__((target("avx2,f16c"))) inline size_t f32_to_f16_avx2(const float* in, uint16_t* out,
+                                                                     size_t n) noexcept {
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+   }
+   return i;
+}
+
+__attribute__((target("avx2"))) inline size_t bf16_to_f32_avx2(const uint16_t* in, float* out, size_t n) noexcept {
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_slli_epi32(wide, 16));
+   }
+   return i;
+}
+
+// Round to nearest even in integer arithmetic, NaNs quieted like the scalar path
+__attribute__((target("avx2"))) inline size_t f32_to_bf16_avx2(const float* in, uint16_t* out, size_t n) noexcept {
+   const __m256i one = _mm256_set1_epi32(1);
+   const __m256i bias = _mm256_set1_epi32(0x7FFF);
+   const __m256i abs_mask = _mm256_set1_epi32(0x7FFFFFFF);
+   const __m256i inf = _mm256_set1_epi32(0x7F800000);
+   const __m256i quiet = _mm256_set1_epi32(0x00400000);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8) {
+      const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+      const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+      const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(bits, _mm256_add_epi32(bias, lsb)), 16);
+      const __m256i is_nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, abs_mask), inf);
+      const __m256i nan = _mm256_srli_epi32(_mm256_or_si256(bits, quiet), 16);
+      const __m256i result = _mm256_blendv_epi8(rounded, nan, is_nan);
+      // Narrow 8 x u32 -> 8 x u16 (packus works per 128-bit lane, so fix the order)
+      const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0x08);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(packed));
+   }
+   return i;
+}
+
+// ----------------------------------------------------------------------------
+// AVX-512F (16 lanes)
+// ----------------------------------------------------------------------------
+
+__attribute__((target("avx512f"))) inline size_t f16_to_f32_avx512(const uint16_t* in, float* out,
+                                                                    size_t n) noexcept {
+   size_t i = 0;
+   for (; i + 16 <= n; i += 16) {
+      const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+      _mm512_storeu_ps(out + i, _mm512_cvtph_ps(h));
+   }
+   return i;
+}
+
+__attribute__((target("avx512f"))) inline size_t f32_to_f16_avx512(const float* in, uint16_t* out,
+                                                                    size_t n) noexcept {
+   size_t i = 0;
+   for (; i + 16 <= n; i += 16) {
+      const __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), h);
+   }
+   return i;
+}
+
+__attribute__((target("avx512f"))) inline size_t bf16_to_f32_avx512(const uint16_t* in, float* out,
+                                                                     size_t n) noexcept {
+   size_t i = 0;
+   for (; i + 16 <= n; i += 16) {
+      const __m512i wide = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+      _mm512_storeu_si512(out + i, _mm512_slli_epi32(wide, 16));
+   }
+   return i;
+}
+
+__attribute__((target("avx512f"))) inline size_t f32_to_bf16_avx512(const float* in, uint16_t* out,
+                                                                     size_t n) noexcept {
+   const __m512i one = _mm512_set1_epi32(1);
+   const __m512i bias = _mm512_set1_epi32(0x7FFF);
+   const __m512i abs_mask = _mm512_set1_epi32(0x7FFFFFFF);
+   const __m512i inf = _mm512_set1_epi32(0x7F800000);
+   const __m512i quiet = _mm512_set1_epi32(0x00400000);
+   size_t i = 0;
+   for (; i + 16 <= n; i += 16) {
+      const __m512i bits = _mm512_loadu_si512(in + i);
+      const __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(bits, 16), one);
+      const __m512i rounded = _mm512_srli_epi32(_mm512_add_epi32(bits, _mm512_add_epi32(bias, lsb)), 16);
+      const __mmask16 is_nan = _mm512_cmpgt_epu32_mask(_mm512_and_si512(bits, abs_mask), inf);
+      const __m512i nan = _mm512_srli_epi32(_mm512_or_si512(bits, quiet), 16);
+      const __m512i result = _mm512_mask_blend_epi32(is_nan, rounded, nan);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvtepi32_epi16(result));
+   }
+   return i;
+}
+
+// VCVTNEPS2BF16: native round-to-nearest-even (denormal inputs flush to zero)
+__attribute__((target("avx512f,avx512bf16"))) inline size_t f32_to_bf16_avx512_bf16(const float* in, uint16_t* out,
+                                                                                     size_t n) noexcept {
+   size_t i = 0;
+   for (; i + 16 <= n; i += 16) {
+      const __m256bh h = _mm512_cvtneps_pbh(_mm512_loadu_ps(in + i));
+      std::memcpy(out + i, &h, sizeof(h));
+   }
+   return i;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+} // namespace detail
+
+// ============================================================================
+// Bulk Conversion
+// ============================================================================
+// Converts min(in.size(), out.size()) values and returns the count converted.
+
+inline size_t f16_to_f32(std::span<const uint16_t> in, std::span<float> out,
+                         half_isa isa = best_half_isa()) noexcept {
+   const size_t n = std::min(in.size(), out.size());
+   size_t i = 0;
+#if defined(ZMEM_HALF_X86)
+   if (isa >= half_isa::avx512f) {
+      i = detail::f16_to_f32_avx512(in.data(), out.data(), n);
+   }
+   else if (isa == half_isa::avx2_f16c) {
+      i = detail::f16_to_f32_avx2(in.data(), out.data(), n);
+   }
+#else
+   (void)isa;
+#endif
+   for (; i < n; ++i) {
+      out[i] = f16_to_f32(in[i]);
+   }
+   return n;
+}
+
+inline size_t f32_to_f16(std::span<const float> in, std::span<uint16_t> out,
+                         half_isa isa = best_half_isa()) noexcept {
+   const size_t n = std::min(in.size(), out.size());
+   size_t i = 0;
+#if defined(ZMEM_HALF_X86)
+   if (isa >= half_isa::avx512f) {
+      i = detail::f32_to_f16_avx512(in.data(), out.data(), n);
+   }
+   else if (isa == half_isa::avx2_f16c) {
+      i = detail::f32_to_f16_avx2(in.data(), out.data(), n);
+   }
+#else
+   (void)isa;
+#endif
+   for (; i < n; ++i) {
+      out[i] = f32_to_f16(in[i]);
+   }
+   return n;
+}
+
+inline size_t bf16_to_f32(std::span<const uint16_t> in, std::span<float> out,
+                          half_isa isa = best_half_isa()) noexcept {
+   const size_t n = std::min(in.size(), out.size());
+   size_t i = 0;
+#if defined(ZMEM_HALF_X86)
+   if (isa >= half_isa::avx512f) {
+      i = detail::bf16_to_f32_avx512(in.data(), out.data(), n);
+   }
+   else if (isa == half_isa::avx2_f16c) {
+      i = detail::bf16_to_f32_avx2(in.data(), out.data(), n);
+   }
+#else
+   (void)isa;
+#endif
+   for (; i < n; ++i) {
+      out[i] = bf16_to_f32(in[i]);
+   }
+   return n;
+}
+
+inline size_t f32_to_bf16(std::span<const float> in, std::span<uint16_t> out,
+                          half_isa isa = best_half_isa()) noexcept {
+   const size_t n = std::min(in.size(), out.size());
+   size_t i = 0;
+#if defined(ZMEM_HALF_X86)
+   if (isa == half_isa::avx512_bf16) {
+      i = detail::f32_to_bf16_avx512_bf16(in.data(), out.data(), n);
+   }
+   else if (isa == half_isa::avx512f) {
+      i = detail::f32_to_bf16_avx512(in.data(), out.data(), n);
+   }
+   else if (isa == half_isa::avx2_f16c) {
+      i = detail::f32_to_bf16_avx2(in.data(), out.data(), n);
+   }
+#else
+   (void)isa;
+#endif
+   for (; i < n; ++i) {
+      out[i] = f32_to_bf16(in[i]);
+   }
+   return n;
+}
+
+// ============================================================================
+// Zero-Copy Views
+// ============================================================================
+
+struct f16_format {
+   static float to_f32(uint16_t h) noexcept { return zmem::f16_to_f32(h); }
+   static size_t to_f32(std::span<const uint16_t> in, std::span<float> out) noexcept {
+      return zmem::f16_to_f32(in, out);
+   }
+};
+
+struct bf16_format {
+   static float to_f32(uint16_t h) noexcept { return zmem::bf16_to_f32(h); }
+   static size_t to_f32(std::span<const uint16_t> in, std::span<float> out) noexcept {
+      return zmem::bf16_to_f32(in, out);
+   }
+};
+
+// Read-only view of half-precision values in a ZMEM buffer, e.g. a `[bf16]` field
+// obtained zero-copy from glz::lazy_zmem_view. Elements read as float; use to_f32()
+// to widen a whole range at vector speed.
+template <class Format>
+struct half_view {
+   struct iterator {
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = float;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = float;
+
+      const uint16_t* p{};
+
+      float operator*() const noexcept { return Format::to_f32(*p); }
+      float operator[](difference_type n) const noexcept { return Format::to_f32(p[n]); }
+      iterator& operator++() noexcept {
+         ++p;
+         return *this;
+      }
+      iterator operator++(int) noexcept { return {p++}; }
+      iterator& operator--() noexcept {
+         --p;
+         return *this;
+      }
+      iterator operator--(int) noexcept { return {p--}; }
+      iterator& operator+=(difference_type n) noexcept {
+         p += n;
+         return *this;
+      }
+      iterator& operator-=(difference_type n) noexcept {
+         p -= n;
+         return *this;
+      }
+      friend iterator operator+(iterator it, difference_type n) noexcept { return {it.p + n}; }
+      friend iterator operator+(difference_type n, iterator it) noexcept { return {it.p + n}; }
+      friend iterator operator-(iterator it, difference_type n) noexcept { return {it.p - n}; }
+      friend difference_type operator-(iterator a, iterator b) noexcept { return a.p - b.p; }
+      friend auto operator<=>(iterator a, iterator b) noexcept = default;
+   };
+
+   half_view() = default;
+   half_view(std::span<const uint16_t> bits) noexcept : bits_(bits) {}
+   half_view(const uint16_t* data, size_t size) noexcept : bits_(data, size) {}
+
+   size_t size() const noexcept { return bits_.size(); }
+   bool empty() const noexcept { return bits_.empty(); }
+   float operator[](size_t i) const noexcept { return Format::to_f32(bits_[i]); }
+   iterator begin() const noexcept { return {bits_.data()}; }
+   iterator end() const noexcept { return {bits_.data() + bits_.size()}; }
+   std::span<const uint16_t> bits() const noexcept { return bits_; }
+
+   // Bulk widening into caller storage (no allocation)
+   size_t to_f32(std::span<float> out) const noexcept { return Format::to_f32(bits_, out); }
+
+   std::vector<float> to_vector() const {
+      std::vector<float> out(bits_.size());
+      to_f32(out);
+      return out;
+   }
+
+  private:
+   std::span<const uint16_t> bits_{};
+};
+
+using f16_view = half_view<f16_format>;
+using bf16_view = half_view<bf16_format>;
+
+// ============================================================================
+// Write-Time Quantization
+// ============================================================================
+// Narrow a native float vector for storage as `[bf16]` / `[f16]` (a std::vector<uint16_t>
+// field in the wire struct), halving the bytes written and sent.
+
+inline void quantize_bf16(std::span<const float> values, std::vector<uint16_t>& out) {
+   out.resize(values.size());
+   f32_to_bf16(values, out);
+}
+
+inline void quantize_f16(std::span<const float> values, std::vector<uint16_t>& out) {
+   out.resize(values.size());
+   f32_to_f16(values, out);
+}
+
+} // namespace zmem
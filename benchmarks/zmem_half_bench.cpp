@@ -0,0 +1,167 @@
+// ZMEM Half-Precision Conversion Benchmark
+// Measures bulk f16/bf16 <-> f32 conversion (zmem_half.hpp) for every instruction
+// set the CPU supports, and the end-to-end cost of widening a `[bf16]` embedding
+// read zero-copy through lazy_zmem_view.
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_half.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Test Data Structures
+// ============================================================================
+
+// Native representation
+struct Embedding {
+   uint64_t id{};
+   std::vector<float> values{};
+};
+
+// Wire representation with quantized values (`values::[bf16]`)
+struct EmbeddingBf16 {
+   uint64_t id{};
+   std::vector<uint16_t> values{};
+};
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+template <typename Func>
+double benchmark(Func&& func, size_t iterations) {
+   // Warmup
+   for (size_t i = 0; i < iterations / 10 + 1; ++i) {
+      func();
+   }
+
+   auto start = std::chrono::high_resolution_clock::now();
+   for (size_t i = 0; i < iterations; ++i) {
+      func();
+   }
+   auto end = std::chrono::high_resolution_clock::now();
+
+   auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+   return static_cast<double>(duration.count()) / static_cast<double>(iterations);
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t count = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1 << 20);
+   const size_t iterations = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200);
+
+   std::vector<float> source(count);
+   std::mt19937 rng{3};
+   std::normal_distribution<float> dist{0.0f, 1.0f};
+   for (auto& v : source) v = dist(rng);
+
+   std::vector<uint16_t> halves(count);
+   std::vector<float> widened(count);
+
+   const zmem::half_isa best = zmem::best_half_isa();
+
+   std::cout << "ZMEM Half-Precision Benchmark\n";
+   std::cout << "=============================\n\n";
+   std::cout << "Elements: " << count << "\n";
+   std::cout << "Best instruction set: " << zmem::half_isa_name(best) << "\n\n";
+
+   // --------------------------------------------------------------------------
+   // Bulk conversion per instruction set
+   // --------------------------------------------------------------------------
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "| Conversion | ISA | Time (ns) | Throughput (M elem/s) |\n";
+   std::cout << "|------------|-----|-----------|-----------------------|\n";
+
+   auto report = [&](const char* name, zmem::half_isa isa, double ns) {
+      std::cout << "| " << name << " | " << zmem::half_isa_name(isa) << " | " << ns << " | "
+                << (static_cast<double>(count) / ns * 1000.0) << " |\n";
+   };
+
+   for (auto isa : {zmem::half_isa::scalar, zmem::half_isa::avx2_f16c, zmem::half_isa::avx512f,
+                    zmem::half_isa::avx512_bf16}) {
+      if (isa > best) break;
+
+      report("f32 -> f16", isa, benchmark([&] { zmem::f32_to_f16(source, halves, isa); }, iterations));
+      report("f16 -> f32", isa, benchmark([&] { zmem::f16_to_f32(halves, widened, isa); }, iterations));
+      report("f32 -> bf16", isa, benchmark([&] { zmem::f32_to_bf16(source, halves, isa); }, iterations));
+      report("bf16 -> f32", isa, benchmark([&] { zmem::bf16_to_f32(halves, widened, isa); }, iterations));
+   }
+
+   // --------------------------------------------------------------------------
+   // End-to-end: [f32] vs quantized [bf16] embedding
+   // --------------------------------------------------------------------------
+
+   const Embedding embedding{42, source};
+   EmbeddingBf16 quantized{42, {}};
+   zmem::quantize_bf16(embedding.values, quantized.values);
+
+   std::string f32_buffer;
+   std::string bf16_buffer;
+   if (auto ec = glz::write_zmem(embedding, f32_buffer); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, f32_buffer) << "\n";
+      return 1;
+   }
+   if (auto ec = glz::write_zmem(quantized, bf16_buffer); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, bf16_buffer) << "\n";
+      return 1;
+   }
+
+   std::string write_buffer;
+   const double write_f32_ns = benchmark([&] { (void)glz::write_zmem(embedding, write_buffer); }, iterations);
+   const double write_bf16_ns = benchmark([&] {
+      zmem::quantize_bf16(embedding.values, quantized.values);
+      (void)glz::write_zmem(quantized, write_buffer);
+   }, iterations);
+
+   // Zero-copy [f32] read: copy straight out of the buffer
+   double sink = 0.0;
+   const double read_f32_ns = benchmark([&] {
+      glz::lazy_zmem_view<Embedding> view{f32_buffer};
+      auto values = view.get<1>();
+      sink += values[values.size() / 2];
+      std::copy(values.begin(), values.end(), widened.begin());
+   }, iterations);
+
+   // Zero-copy [bf16] read: per-element widening through the view
+   const double read_bf16_loop_ns = benchmark([&] {
+      glz::lazy_zmem_view<EmbeddingBf16> view{bf16_buffer};
+      auto field = view.get<1>();
+      zmem::bf16_view values{field.data(), field.size()};
+      for (size_t i = 0; i < values.size(); ++i) widened[i] = values[i];
+      sink += widened[count / 2];
+   }, iterations);
+
+   // Zero-copy [bf16] read: bulk widening
+   const double read_bf16_bulk_ns = benchmark([&] {
+      glz::lazy_zmem_view<EmbeddingBf16> view{bf16_buffer};
+      auto field = view.get<1>();
+      zmem::bf16_view values{field.data(), field.size()};
+      values.to_f32(widened);
+      sink += widened[count / 2];
+   }, iterations);
+
+   std::cout << "\n| Embedding | Wire size (bytes) | Time (ns) |\n";
+   std::cout << "|-----------|-------------------|-----------|\n";
+   std::cout << "| Write [f32] | " << f32_buffer.size() << " | " << write_f32_ns << " |\n";
+   std::cout << "| Quantize + write [bf16] | " << bf16_buffer.size() << " | " << write_bf16_ns << " |\n";
+   std::cout << "| Read [f32] to floats | " << f32_buffer.size() << " | " << read_f32_ns << " |\n";
+   std::cout << "| Read [bf16] to floats (element loop) | " << bf16_buffer.size() << " | " << read_bf16_loop_ns
+             << " |\n";
+   std::cout << "| Read [bf16] to floats (bulk) | " << bf16_buffer.size() << " | " << read_bf16_bulk_ns << " |\n";
+
+   std::cout << "\nChecksum: " << sink << "\n";
+
+   return 0;
+}
@@ -0,0 +1,166 @@
+// ZMEM Huge Pages
+// Anonymous memory backed by 2 MB pages (Linux): an allocator and output buffer
+// type for glz::write_zmem, used for multi-hundred-MB snapshots where 4 KB page
+// TLB misses dominate writing and random access. See also mapped_file::load.
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+
+namespace zmem {
+
+enum class huge_pages : uint32_t {
+   none, // 4 KB pages; transparent huge pages disabled for the range
+   transparent, // 2 MB aligned memory with MADV_HUGEPAGE (THP "madvise" or "always" mode)
+   reserved, // MAP_HUGETLB from the preallocated pool (vm.nr_hugepages), transparent if exhausted
+};
+
+inline const char* huge_pages_name(huge_pages pages) noexcept {
+   switch (pages) {
+      case huge_pages::none: return "4 KB pages";
+      case huge_pages::transparent: return "THP (MADV_HUGEPAGE)";
+      case huge_pages::reserved: return "MAP_HUGETLB";
+   }
+   return "?";
+}
+
+constexpr size_t huge_page_size = size_t(2) << 20;
+
+namespace detail {
+
+inline size_t round_to_huge_page(size_t bytes) noexcept {
+   return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+}
+
+// Maps `bytes` (a multiple of huge_page_size) of zeroed anonymous memory. Returns
+// nullptr on failure.
+inline void* map_anonymous(size_t bytes, huge_pages pages) noexcept {
+#if defined(MAP_HUGETLB)
+   if (pages == huge_pages::reserved) {
+      void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (p != MAP_FAILED) return p;
+   }
+#endif
+   if (pages == huge_pages::none) {
+      void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED) return nullptr;
+#if defined(MADV_NOHUGEPAGE)
+      (void)::madvise(p, bytes, MADV_NOHUGEPAGE);
+#endif
+      return p;
+   }
+
+   // THP only backs 2 MB aligned ranges: over-allocate and trim both ends
+   void* raw = ::mmap(nullptr, bytes + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   if (raw == MAP_FAILED) return nullptr;
+   const uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+   const uintptr_t aligned = (begin + huge_page_size - 1) & ~uintptr_t(huge_page_size - 1);
+   if (aligned > begin) ::munmap(raw, aligned - begin);
+   if (const size_t tail = huge_page_size - (aligned - begin); tail > 0) {
+      ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+   }
+   void* p = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+   (void)::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+   return p;
+}
+
+inline void unmap_anonymous(void* p, size_t bytes) noexcept { ::munmap(p, bytes); }
+
+} // namespace detail
+
+// Allocations of at least `threshold` bytes are mapped with the requested page mode
+// (rounded up to 2 MB); smaller ones use std::allocator.
+template <class T>
+class huge_page_allocator {
+  public:
+   using value_type = T;
+   using propagate_on_container_copy_assignment = std::true_type;
+   using propagate_on_container_move_assignment = std::true_type;
+   using propagate_on_container_swap = std::true_type;
+
+   huge_page_allocator() = default;
+   explicit huge_page_allocator(huge_pages pages, size_t threshold = huge_page_size) noexcept
+      : pages_(pages), threshold_(threshold) {}
+   template <class U>
+   huge_page_allocator(const huge_page_allocator<U>& other) noexcept
+      : pages_(other.pages()), threshold_(other.threshold()) {}
+
+   T* allocate(size_t n) {
+      const size_t bytes = n * sizeof(T);
+      if (bytes < threshold_) return std::allocator<T>{}.allocate(n);
+      void* p = detail::map_anonymous(detail::round_to_huge_page(bytes), pages_);
+      if (!p) throw std::bad_alloc{};
+      return static_cast<T*>(p);
+   }
+
+   void deallocate(T* p, size_t n) noexcept {
+      const size_t bytes = n * sizeof(T);
+      if (bytes < threshold_) {
+         std::allocator<T>{}.deallocate(p, n);
+      }
+      else {
+         detail::unmap_anonymous(p, detail::round_to_huge_page(bytes));
+      }
+   }
+
+   huge_pages pages() const noexcept { return pages_; }
+   size_t threshold() const noexcept { return threshold_; }
+
+   template <class U>
+   bool operator==(const huge_page_allocator<U>& other) const noexcept {
+      return pages_ == other.pages() && threshold_ == other.threshold();
+   }
+
+  private:
+   huge_pages pages_{huge_pages::transparent};
+   size_t threshold_{huge_page_size};
+};
+
+// Output buffer for glz::write_zmem / write_zmem_preallocated; converts to std::string_view
+using huge_page_string = std::basic_string<char, std::char_traits<char>, huge_page_allocator<char>>;
+
+// Bytes of the mapping containing `address` that are currently backed by huge pages
+// (THP, huge page cache folios or hugetlbfs), from /proc/self/smaps. For reporting.
+inline size_t huge_page_bytes(const void* address) {
+   std::ifstream smaps("/proc/self/smaps");
+   const uintptr_t target = reinterpret_cast<uintptr_t>(address);
+   std::string line;
+   bool inside = false;
+   size_t rss = 0;
+   size_t huge = 0;
+   size_t kernel_page = 0;
+   while (std::getline(smaps, line)) {
+      const size_t dash = line.find('-');
+      const size_t space = line.find(' ');
+      if (dash != std::string::npos && space != std::string::npos && dash < space &&
+          line.find_first_not_of("0123456789abcdef") == dash) {
+         if (inside) break;
+         const uintptr_t begin = std::stoull(line.substr(0, dash), nullptr, 16);
+         const uintptr_t end = std::stoull(line.substr(dash + 1, space - dash - 1), nullptr, 16);
+         inside = target >= begin && target < end;
+         continue;
+      }
+      if (!inside) continue;
+      const auto field = [&](const char* name) -> size_t {
+         const std::string prefix = std::string(name) + ":";
+         if (line.compare(0, prefix.size(), prefix) != 0) return 0;
+         return size_t(std::stoull(line.substr(prefix.size()))) * 1024;
+      };
+      rss += field("Rss");
+      huge += field("AnonHugePages") + field("FilePmdMapped") + field("ShmemPmdMapped");
+      kernel_page += field("KernelPageSize");
+   }
+   return kernel_page >= huge_page_size ? rss : huge;
+}
+
+} // namespace zmem
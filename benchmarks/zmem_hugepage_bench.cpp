@@ -0,0 +1,259 @@
+// ZMEM Huge Page Benchmark
+// Writes large messages into 4 KB, THP and MAP_HUGETLB backed buffers
+// (zmem_huge_pages.hpp), then times dependent random lookups for the access
+// patterns of "Access Complexity Summary" in buffers and mapped files.
+//
+// Usage: zmem_hugepage_bench [size_mb=1024] [lookups=2000000]
+//
+// All pages are touched before lookups are timed, so the differences are TLB
+// misses and page walks rather than page faults.
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_fixtures.hpp"
+#include "zmem_huge_pages.hpp"
+#include "zmem_layout.hpp"
+#include "zmem_mapped_file.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Test Data Structures
+// ============================================================================
+
+struct Matrix {
+   std::vector<std::vector<uint64_t>> rows{};
+};
+
+constexpr zmem::vector_field ticks_field{0, sizeof(Tick)};
+constexpr zmem::vector_field records_field{8, 0};
+constexpr zmem::vector_field features_field{16, sizeof(float)}; // Within a Record element
+constexpr zmem::vector_field rows_field{0, 0};
+
+// Smallest inner vector, so a random inner index is always in range
+constexpr uint64_t min_features = 16;
+constexpr uint64_t min_row = 8;
+
+// ============================================================================
+// Access Patterns
+// ============================================================================
+
+// Each lookup derives its indices from `r` and returns a value read from the message
+struct access_pattern {
+   const char* name;
+   uint64_t (*lookup)(std::string_view message, uint64_t count, uint64_t r);
+};
+
+uint64_t fixed_array_element(std::string_view message, uint64_t count, uint64_t r) {
+   const std::string_view tick = zmem::element(message, ticks_field, r % count);
+   uint64_t timestamp = 0;
+   if (tick.size() == sizeof(Tick)) std::memcpy(&timestamp, tick.data(), 8);
+   return timestamp;
+}
+
+uint64_t variable_element_inline_field(std::string_view message, uint64_t count, uint64_t r) {
+   const std::string_view record = zmem::element(message, records_field, r % count);
+   if (record.empty()) return 0;
+   glz::lazy_zmem_view<Record> view{record};
+   return view.get<0>();
+}
+
+uint64_t variable_struct_vector_element(std::string_view message, uint64_t count, uint64_t r) {
+   const std::string_view record = zmem::element(message, records_field, r % count);
+   const std::string_view feature = zmem::element(record, features_field, (r >> 40) % min_features);
+   uint32_t bits = 0;
+   if (feature.size() == 4) std::memcpy(&bits, feature.data(), 4);
+   return bits;
+}
+
+uint64_t nested_vector_element(std::string_view message, uint64_t count, uint64_t r) {
+   // Inner vectors are [count:8][elements...]
+   const std::string_view row = zmem::element(message, rows_field, r % count);
+   const uint64_t j = (r >> 40) % min_row;
+   if (row.size() < 16 + j * 8) return 0;
+   return zmem::detail::load_u64(row.data() + 8 + j * 8);
+}
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+using clock_type = std::chrono::steady_clock;
+
+// Dependent chain of lookups: each index depends on the previous value, so the
+// time per lookup is the full miss latency (TLB walk included)
+double lookup_ns(const access_pattern& pattern, std::string_view message, uint64_t count, size_t lookups,
+                 uint64_t& checksum) {
+   uint64_t r = 32;
+   const auto start = clock_type::now();
+   for (size_t i = 0; i < lookups; ++i) r = mix(r + pattern.lookup(message, count, r));
+   const double ns = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+   checksum += r;
+   return ns / static_cast<double>(lookups);
+}
+
+uint64_t touch_pages(std::string_view bytes) {
+   uint64_t sum = 0;
+   for (size_t p = 0; p < bytes.size(); p += 4096) sum += uint8_t(bytes[p]);
+   return sum;
+}
+
+double huge_percent(std::string_view bytes) {
+   if (bytes.empty()) return 0.0;
+   const double huge = static_cast<double>(zmem::huge_page_bytes(bytes.data()));
+   return std::min(100.0, 100.0 * huge / static_cast<double>(bytes.size()));
+}
+
+struct row_result {
+   std::string backing{};
+   double write_mb_s{}; // 0 for file-backed rows
+   double huge_percent{};
+   std::vector<double> ns{}; // Per access pattern
+};
+
+void print_rows(const std::vector<access_pattern>& patterns, const std::vector<row_result>& rows) {
+   for (size_t p = 0; p < patterns.size(); ++p) {
+      const double baseline = rows.front().ns[p];
+      for (const auto& row : rows) {
+         std::cout << "| " << patterns[p].name << " | " << row.backing << " | ";
+         if (row.write_mb_s > 0.0) {
+            std::cout << row.write_mb_s;
+         }
+         else {
+            std::cout << "-";
+         }
+         std::cout << " | " << row.huge_percent << " | " << row.ns[p] << " | " << baseline / row.ns[p] << "x |\n";
+      }
+   }
+}
+
+// Writes `value` into each buffer backing and the resulting message to a file, then
+// runs every pattern against each buffer and mapping of that file
+template <class T>
+bool run_shape(T&& value, uint64_t count, const std::vector<access_pattern>& patterns, size_t lookups,
+               uint64_t& checksum) {
+   const std::string path = "zmem_hugepage_bench.zmem";
+   std::vector<row_result> rows;
+
+   for (const auto pages : {zmem::huge_pages::none, zmem::huge_pages::transparent, zmem::huge_pages::reserved}) {
+      zmem::huge_page_string buffer{zmem::huge_page_allocator<char>{pages}};
+      const auto start = clock_type::now();
+      if (auto ec = glz::write_zmem(value, buffer); ec) {
+         std::cerr << "ZMEM write error: " << glz::format_error(ec, buffer) << "\n";
+         return false;
+      }
+      const double seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+
+      row_result row{};
+      row.backing = std::string{"buffer: "} + zmem::huge_pages_name(pages);
+      row.write_mb_s = static_cast<double>(buffer.size()) / seconds / (1024.0 * 1024.0);
+      row.huge_percent = huge_percent(buffer);
+      for (const auto& pattern : patterns) row.ns.push_back(lookup_ns(pattern, buffer, count, lookups, checksum));
+      rows.push_back(std::move(row));
+
+      if (pages == zmem::huge_pages::none) {
+         std::ofstream out(path, std::ios::binary | std::ios::trunc);
+         out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+         if (!out) {
+            std::cerr << "Could not write " << path << "\n";
+            return false;
+         }
+      }
+   }
+
+   struct file_case {
+      const char* backing;
+      bool load;
+      zmem::huge_pages pages;
+      zmem::map_advice advice;
+   };
+   for (const file_case c : {file_case{"mmap", false, zmem::huge_pages::none, zmem::map_advice::normal},
+                             file_case{"mmap + MADV_HUGEPAGE", false, zmem::huge_pages::none,
+                                       zmem::map_advice::hugepage},
+                             file_case{"mapped_file::load, THP", true, zmem::huge_pages::transparent,
+                                       zmem::map_advice::normal},
+                             file_case{"mapped_file::load, MAP_HUGETLB", true, zmem::huge_pages::reserved,
+                                       zmem::map_advice::normal}}) {
+      zmem::mapped_file file;
+      if (!(c.load ? file.load(path, c.pages) : file.open(path))) {
+         std::cerr << "Could not open " << path << "\n";
+         return false;
+      }
+      if (!c.load) file.advise(c.advice);
+      checksum += touch_pages(file.bytes());
+
+      row_result row{};
+      row.backing = c.backing;
+      row.huge_percent = huge_percent(file.bytes());
+      for (const auto& pattern : patterns) {
+         row.ns.push_back(lookup_ns(pattern, file.bytes(), count, lookups, checksum));
+      }
+      rows.push_back(std::move(row));
+   }
+   std::remove(path.c_str());
+
+   print_rows(patterns, rows);
+   return true;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const uint64_t size_mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+   const size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2'000'000;
+   const uint64_t bytes = size_mb << 20;
+
+   std::cout << "ZMEM Huge Page Benchmark\n";
+   std::cout << "========================\n\n";
+   std::cout << "Message size: ~" << size_mb << " MB per shape, " << lookups << " dependent lookups per row\n";
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "\n| Access pattern | Backing | Write (MB/s) | Huge pages (%) | ns/lookup | vs 4 KB |\n";
+   std::cout << "|----------------|---------|--------------|----------------|-----------|---------|\n";
+
+   uint64_t checksum = 0;
+   {
+      FixedShape log = make_fixed_shape(bytes);
+      const uint64_t count = log.ticks.size();
+      if (!run_shape(log, count, {{"Fixed struct array element", fixed_array_element}}, lookups, checksum)) {
+         return 1;
+      }
+   }
+   {
+      Dataset dataset = make_dataset(bytes);
+      const uint64_t count = dataset.records.size();
+      if (!run_shape(dataset, count,
+                     {{"[VariableStruct] element, inline field", variable_element_inline_field},
+                      {"Variable struct vector element", variable_struct_vector_element}},
+                     lookups, checksum)) {
+         return 1;
+      }
+   }
+   {
+      // Rows of 8-71 elements, ~336 bytes each with their offset table entry
+      Matrix matrix;
+      matrix.rows.resize(bytes / 336);
+      for (uint64_t i = 0; i < matrix.rows.size(); ++i) {
+         matrix.rows[i].resize(min_row + mix(i) % 64);
+         for (uint64_t j = 0; j < matrix.rows[i].size(); ++j) matrix.rows[i][j] = i * 64 + j;
+      }
+      const uint64_t count = matrix.rows.size();
+      if (!run_shape(matrix, count, {{"[[T]] nested element", nested_vector_element}}, lookups, checksum)) {
+         return 1;
+      }
+   }
+
+   std::cout << "\nChecksum: " << checksum << "\n";
+   return 0;
+}
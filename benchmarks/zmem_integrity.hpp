@@ -0,0 +1,222 @@
+// ZMEM Integrity Trailer
+// Optional 8-byte checksum after each framed message (Appendix D of ZMEM_FORMAT.md):
+// CRC32C or XXH3-64 over the size header and message bytes. The size header catches
+// truncation; the trailer catches bit flips in shared memory and on disk.
+//
+// The writers checksum the message in place as soon as glaze has written it. Messages
+// that fit in L1/L2 are still there, so the checksum reads cache; for DRAM-sized
+// messages it is a second traversal of memory and the overhead is expected to be
+// bandwidth-bound. The validator applies the "Validation" size rules to each frame
+// before checking its trailer.
+
+#pragma once
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_checksum.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <string_view>
+
+namespace zmem {
+
+enum class integrity : uint32_t {
+   none, // No trailer: plain size-prefixed framing
+   crc32c, // CRC32C, zero-extended to 64 bits
+   xxh3 // XXH3-64, seed 0
+};
+
+inline constexpr size_t integrity_trailer_size = 8;
+
+inline const char* integrity_name(integrity algo) noexcept {
+   switch (algo) {
+      case integrity::none: return "none";
+      case integrity::crc32c: return "CRC32C";
+      case integrity::xxh3: return "XXH3";
+   }
+   return "unknown";
+}
+
+inline size_t trailer_size(integrity algo) noexcept { return algo == integrity::none ? 0 : integrity_trailer_size; }
+
+// Trailer value for a framed message (size header included)
+inline uint64_t integrity_checksum(std::string_view message, integrity algo,
+                                   checksum_isa isa = best_checksum_isa()) noexcept {
+   switch (algo) {
+      case integrity::none: return 0;
+      case integrity::crc32c: return crc32c(message, 0, isa);
+      case integrity::xxh3: return xxh3_64(message, isa);
+   }
+   return 0;
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+namespace detail {
+
+template <class Buffer>
+void append_trailer(Buffer& buffer, size_t message_begin, integrity algo) {
+   if (algo == integrity::none) return;
+   const std::string_view message{buffer.data() + message_begin, buffer.size() - message_begin};
+   const uint64_t sum = integrity_checksum(message, algo);
+   char trailer[integrity_trailer_size];
+   std::memcpy(trailer, &sum, sizeof(trailer));
+   buffer.append(trailer, sizeof(trailer));
+}
+
+// The end of a message log as a glaze output buffer: a contiguous range whose index 0
+// is log[offset] and whose resize resizes the log, so a message is written in place
+// after the frames already there
+template <class Buffer>
+struct log_tail {
+   using value_type = typename Buffer::value_type;
+   using size_type = size_t;
+   using iterator = value_type*;
+   using const_iterator = const value_type*;
+
+   Buffer& log;
+   size_t offset;
+
+   size_t size() const noexcept { return log.size() - offset; }
+   bool empty() const noexcept { return size() == 0; }
+   void resize(size_t n) { log.resize(offset + n); }
+   value_type* data() noexcept { return log.data() + offset; }
+   const value_type* data() const noexcept { return log.data() + offset; }
+   value_type* begin() noexcept { return data(); }
+   value_type* end() noexcept { return data() + size(); }
+   const value_type* begin() const noexcept { return data(); }
+   const value_type* end() const noexcept { return data() + size(); }
+   value_type& operator[](size_t i) noexcept { return data()[i]; }
+   const value_type& operator[](size_t i) const noexcept { return data()[i]; }
+};
+
+} // namespace detail
+
+// glz::write_zmem followed by the trailer. `buffer` holds one framed message on success
+// and is left as glz::write_zmem left it on error.
+template <class T, class Buffer>
+auto write_zmem_checked(const T& value, Buffer& buffer, integrity algo) {
+   auto ec = glz::write_zmem(value, buffer);
+   if (!ec) detail::append_trailer(buffer, 0, algo);
+   return ec;
+}
+
+// glz::write_zmem_preallocated followed by the trailer. The first call on a buffer may
+// grow it by the trailer; a reused buffer keeps its capacity.
+template <class T, class Buffer>
+auto write_zmem_preallocated_checked(const T& value, Buffer& buffer, integrity algo) {
+   auto ec = glz::write_zmem_preallocated(value, buffer);
+   if (!ec) detail::append_trailer(buffer, 0, algo);
+   return ec;
+}
+
+// Appends one framed message and its trailer to a message log. The message is written
+// with glz::write_zmem_preallocated at the end of the log and checksummed there, with no
+// intermediate copy. On error the log is left as it was.
+template <class T, class Buffer>
+auto append_zmem_checked(const T& value, Buffer& log, integrity algo) {
+   static_assert(std::ranges::contiguous_range<detail::log_tail<Buffer>>);
+   const size_t begin = log.size();
+   detail::log_tail<Buffer> tail{log, begin};
+   auto ec = glz::write_zmem_preallocated(value, tail);
+   if (ec) {
+      log.resize(begin);
+   }
+   else {
+      detail::append_trailer(log, begin, algo);
+   }
+   return ec;
+}
+
+// ============================================================================
+// Validation
+// ============================================================================
+
+enum class validate_error : uint32_t {
+   none,
+   truncated_header, // Fewer than 8 bytes for the size field
+   truncated_message, // Fewer than 8 + size bytes
+   missing_trailer, // Message complete, trailer cut off
+   checksum_mismatch,
+   decode_error // Frame valid, glz::read_zmem failed
+};
+
+inline const char* validate_error_name(validate_error ec) noexcept {
+   switch (ec) {
+      case validate_error::none: return "none";
+      case validate_error::truncated_header: return "truncated header";
+      case validate_error::truncated_message: return "truncated message";
+      case validate_error::missing_trailer: return "missing trailer";
+      case validate_error::checksum_mismatch: return "checksum mismatch";
+      case validate_error::decode_error: return "decode error";
+   }
+   return "unknown";
+}
+
+// Validates the variable struct frame at the start of `bytes`. On success `message` is
+// the framed message without its trailer (ready for glz::read_zmem) and `frame_size`
+// includes the trailer.
+inline validate_error validate_frame(std::string_view bytes, integrity algo, std::string_view& message,
+                                     size_t& frame_size, checksum_isa isa = best_checksum_isa()) noexcept {
+   if (bytes.size() < 8) return validate_error::truncated_header;
+   uint64_t size;
+   std::memcpy(&size, bytes.data(), 8);
+   if (size > bytes.size() - 8) return validate_error::truncated_message;
+   message = bytes.substr(0, 8 + size);
+   frame_size = message.size() + trailer_size(algo);
+   if (algo == integrity::none) return validate_error::none;
+   if (bytes.size() - message.size() < integrity_trailer_size) return validate_error::missing_trailer;
+   uint64_t stored;
+   std::memcpy(&stored, bytes.data() + message.size(), 8);
+   return stored == integrity_checksum(message, algo, isa) ? validate_error::none
+                                                           : validate_error::checksum_mismatch;
+}
+
+inline validate_error validate_frame(std::string_view bytes, integrity algo,
+                                     checksum_isa isa = best_checksum_isa()) noexcept {
+   std::string_view message;
+   size_t frame_size;
+   return validate_frame(bytes, algo, message, frame_size, isa);
+}
+
+// Validates the frame, then decodes it
+template <class T>
+validate_error read_zmem_checked(T& value, std::string_view bytes, integrity algo) {
+   std::string_view message;
+   size_t frame_size;
+   if (const validate_error ec = validate_frame(bytes, algo, message, frame_size); ec != validate_error::none) {
+      return ec;
+   }
+   if (auto ec = glz::read_zmem(value, message); ec) return validate_error::decode_error;
+   return validate_error::none;
+}
+
+struct frame_log_result {
+   validate_error error{};
+   uint64_t messages{}; // Valid messages before the first error
+   uint64_t offset{}; // Byte offset of the first invalid frame, or the log size
+};
+
+// Walks a log of framed messages (each followed by its trailer), calling
+// on_message(std::string_view message) for each valid one. Stops at the first error.
+template <class OnMessage>
+frame_log_result validate_frame_log(std::string_view log, integrity algo, OnMessage&& on_message) {
+   const checksum_isa isa = best_checksum_isa();
+   frame_log_result result;
+   while (result.offset < log.size()) {
+      std::string_view message;
+      size_t frame_size;
+      result.error = validate_frame(log.substr(result.offset), algo, message, frame_size, isa);
+      if (result.error != validate_error::none) return result;
+      on_message(message);
+      result.messages += 1;
+      result.offset += frame_size;
+   }
+   return result;
+}
+
+} // namespace zmem
@@ -0,0 +1,233 @@
+// ZMEM Integrity Trailer Benchmark
+// Cost of the optional CRC32C / XXH3 trailer (zmem_integrity.hpp) against the plain
+// write, for a single Record, a cache-resident Dataset and a DRAM-sized one. Write rows
+// report the overhead over write_zmem or write_zmem_preallocated; verify rows report the
+// trailer check alone and read_zmem_checked against read_zmem. A message log of Records
+// is appended with append_zmem_checked (written in place at the end of the log) against
+// write_zmem_preallocated plus an append, and walked with validate_frame_log. Before
+// timing, every shape and the log are checked to round-trip and to reject a single
+// flipped bit.
+//
+// Usage: zmem_integrity_bench [size_mb=64] [repetitions=5]
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_bandwidth.hpp"
+#include "zmem_fixtures.hpp"
+#include "zmem_integrity.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+constexpr zmem::integrity checked_modes[] = {zmem::integrity::crc32c, zmem::integrity::xxh3};
+
+std::string size_label(size_t bytes) {
+   if (bytes >= (size_t(1) << 20)) return std::to_string(bytes >> 20) + " MB";
+   if (bytes >= (size_t(1) << 10)) return std::to_string(bytes >> 10) + " KB";
+   return std::to_string(bytes) + " B";
+}
+
+void print_row(const std::string& shape, const char* operation, zmem::integrity algo, double gb_s,
+               double baseline_gb_s) {
+   std::cout << "| " << shape << " | " << operation << " | " << zmem::integrity_name(algo) << " | " << gb_s << " | ";
+   if (baseline_gb_s > 0.0) {
+      std::cout << 100.0 * (baseline_gb_s / gb_s - 1.0) << "% |\n";
+   }
+   else {
+      std::cout << "- |\n";
+   }
+}
+
+// Round trip and a flipped bit in the middle of the message, for every mode
+template <class T>
+bool check_shape(const T& value) {
+   for (const zmem::integrity algo : checked_modes) {
+      std::string frame;
+      if (auto ec = zmem::write_zmem_checked(value, frame, algo); ec) {
+         std::cerr << "ZMEM write error: " << glz::format_error(ec, frame) << "\n";
+         return false;
+      }
+      T decoded{};
+      if (zmem::read_zmem_checked(decoded, frame, algo) != zmem::validate_error::none) {
+         std::cerr << zmem::integrity_name(algo) << " frame did not validate\n";
+         return false;
+      }
+      frame[frame.size() / 2] ^= 0x10;
+      if (zmem::validate_frame(frame, algo) != zmem::validate_error::checksum_mismatch) {
+         std::cerr << zmem::integrity_name(algo) << " missed a flipped bit\n";
+         return false;
+      }
+   }
+   return true;
+}
+
+template <class T>
+bool run_shape(const char* name, const T& value, size_t repetitions) {
+   if (!check_shape(value)) return false;
+
+   std::string buffer;
+   (void)glz::write_zmem(value, buffer);
+   const size_t bytes = buffer.size();
+   const std::string shape = std::string(name) + " (" + size_label(bytes) + ")";
+
+   std::string write_buffer;
+   const double write_gb_s =
+      zmem::best_gb_per_s([&] { (void)glz::write_zmem(value, write_buffer); }, bytes, repetitions);
+   print_row(shape, "write_zmem", zmem::integrity::none, write_gb_s, 0.0);
+   for (const zmem::integrity algo : checked_modes) {
+      print_row(shape, "write_zmem_checked", algo,
+                zmem::best_gb_per_s([&] { (void)zmem::write_zmem_checked(value, write_buffer, algo); }, bytes,
+                                    repetitions),
+                write_gb_s);
+   }
+
+   std::string prealloc_buffer;
+   const double prealloc_gb_s =
+      zmem::best_gb_per_s([&] { (void)glz::write_zmem_preallocated(value, prealloc_buffer); }, bytes, repetitions);
+   print_row(shape, "write_zmem_preallocated", zmem::integrity::none, prealloc_gb_s, 0.0);
+   for (const zmem::integrity algo : checked_modes) {
+      print_row(shape, "write_zmem_preallocated_checked", algo,
+                zmem::best_gb_per_s(
+                   [&] { (void)zmem::write_zmem_preallocated_checked(value, prealloc_buffer, algo); }, bytes,
+                   repetitions),
+                prealloc_gb_s);
+   }
+
+   T decoded{};
+   const double read_gb_s = zmem::best_gb_per_s([&] { (void)glz::read_zmem(decoded, buffer); }, bytes, repetitions);
+   print_row(shape, "read_zmem", zmem::integrity::none, read_gb_s, 0.0);
+   for (const zmem::integrity algo : checked_modes) {
+      std::string frame;
+      (void)zmem::write_zmem_checked(value, frame, algo);
+      print_row(shape, "validate_frame", algo,
+                zmem::best_gb_per_s([&] { (void)zmem::validate_frame(frame, algo); }, bytes, repetitions), 0.0);
+      print_row(shape, "read_zmem_checked", algo,
+                zmem::best_gb_per_s([&] { (void)zmem::read_zmem_checked(decoded, frame, algo); }, bytes,
+                                    repetitions),
+                read_gb_s);
+   }
+   return true;
+}
+
+// Baseline log append: encode into a scratch buffer, then copy it onto the log
+template <class T>
+void append_copied(const std::vector<T>& values, std::string& log, std::string& scratch) {
+   log.clear();
+   for (const T& value : values) {
+      (void)glz::write_zmem_preallocated(value, scratch);
+      log.append(scratch);
+   }
+}
+
+template <class T>
+bool append_checked(const std::vector<T>& values, std::string& log, zmem::integrity algo) {
+   log.clear();
+   for (const T& value : values) {
+      if (auto ec = zmem::append_zmem_checked(value, log, algo); ec) {
+         std::cerr << "ZMEM write error: " << glz::format_error(ec, log) << "\n";
+         return false;
+      }
+   }
+   return true;
+}
+
+// The log must hold every message, each equal to its own write_zmem_checked frame, and
+// a flipped bit in the middle message must stop the walk there
+template <class T>
+bool check_log(const std::vector<T>& values) {
+   for (const zmem::integrity algo : checked_modes) {
+      std::string log;
+      if (!append_checked(values, log, algo)) return false;
+      std::string expected;
+      std::string frame;
+      for (const T& value : values) {
+         (void)zmem::write_zmem_checked(value, frame, algo);
+         expected.append(frame);
+      }
+      std::vector<size_t> offsets;
+      const zmem::frame_log_result walked = zmem::validate_frame_log(
+         log, algo, [&](std::string_view message) { offsets.push_back(size_t(message.data() - log.data())); });
+      if (log != expected || walked.error != zmem::validate_error::none || walked.messages != values.size() ||
+          walked.offset != log.size()) {
+         std::cerr << zmem::integrity_name(algo) << " log did not validate\n";
+         return false;
+      }
+      const size_t middle = values.size() / 2;
+      uint64_t size;
+      std::memcpy(&size, log.data() + offsets[middle], 8);
+      log[offsets[middle] + 8 + size / 2] ^= 0x10;
+      const zmem::frame_log_result corrupt = zmem::validate_frame_log(log, algo, [](std::string_view) {});
+      if (corrupt.error != zmem::validate_error::checksum_mismatch || corrupt.messages != middle) {
+         std::cerr << zmem::integrity_name(algo) << " log missed a flipped bit\n";
+         return false;
+      }
+   }
+   return true;
+}
+
+template <class T>
+bool run_log(const char* name, const std::vector<T>& values, size_t repetitions) {
+   if (!check_log(values)) return false;
+
+   std::string log;
+   std::string scratch;
+   append_copied(values, log, scratch);
+   const size_t bytes = log.size();
+   const std::string shape =
+      std::string(name) + " log (" + std::to_string(values.size()) + " msgs, " + size_label(bytes) + ")";
+
+   const double copied_gb_s =
+      zmem::best_gb_per_s([&] { append_copied(values, log, scratch); }, bytes, repetitions);
+   print_row(shape, "write_zmem_preallocated + append", zmem::integrity::none, copied_gb_s, 0.0);
+   for (const zmem::integrity algo : {zmem::integrity::none, zmem::integrity::crc32c, zmem::integrity::xxh3}) {
+      print_row(shape, "append_zmem_checked", algo,
+                zmem::best_gb_per_s([&] { (void)append_checked(values, log, algo); }, bytes, repetitions),
+                copied_gb_s);
+   }
+   for (const zmem::integrity algo : checked_modes) {
+      (void)append_checked(values, log, algo);
+      print_row(shape, "validate_frame_log", algo,
+                zmem::best_gb_per_s([&] { (void)zmem::validate_frame_log(log, algo, [](std::string_view) {}); },
+                                    bytes, repetitions),
+                0.0);
+   }
+   return true;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t size_mb = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64);
+   const size_t repetitions = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5);
+
+   std::cout << "ZMEM Integrity Trailer Benchmark\n";
+   std::cout << "================================\n\n";
+   std::cout << "Checksums: " << zmem::checksum_isa_name(zmem::best_checksum_isa()) << ", best of " << repetitions
+             << " timings, GB/s = 10^9 bytes of message per second\n";
+   std::cout << "Overhead is the extra time per message over the unchecked operation.\n\n";
+   std::cout << std::fixed << std::setprecision(2);
+   std::cout << "| Shape | Operation | Trailer | GB/s | Overhead |\n";
+   std::cout << "|-------|-----------|---------|------|----------|\n";
+
+   bool ok = run_shape("Record", make_record(7), repetitions);
+   ok = ok && run_shape("Dataset", make_dataset(size_t(256) << 10), repetitions);
+   ok = ok && run_shape("Dataset", make_dataset(size_mb << 20), repetitions);
+   if (ok) {
+      std::vector<Record> records;
+      for (size_t i = 0; i < 4096; ++i) records.push_back(make_record(i));
+      ok = run_log("Record", records, repetitions);
+   }
+   return ok ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+// ZMEM Latency Measurement
+// Per-operation timing for tail latency reporting: an HDR-style log-linear
+// histogram, a TSC (x86) or clock_gettime timer, and CPU pinning / isolation for
+// the measuring thread.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define ZMEM_HAS_TSC 1
+#endif
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace zmem {
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+// Log-linear buckets: values below 2048 are exact, larger values keep 11 significant
+// bits (relative error < 0.1%). Covers the full uint64_t range in ~440 KB.
+class hdr_histogram {
+  public:
+   static constexpr uint32_t sub_bits = 11;
+   static constexpr uint64_t sub_count = uint64_t(1) << sub_bits;
+   static constexpr uint64_t half_count = sub_count / 2;
+
+   hdr_histogram() : counts_(sub_count + (64 - sub_bits) * half_count) {}
+
+   void record(uint64_t value) noexcept {
+      ++counts_[index_of(value)];
+      ++total_;
+      min_ = std::min(min_, value);
+      max_ = std::max(max_, value);
+   }
+
+   void merge(const hdr_histogram& other) noexcept {
+      for (size_t i = 0; i < counts_.size(); ++i) counts_[i] += other.counts_[i];
+      total_ += other.total_;
+      min_ = std::min(min_, other.min_);
+      max_ = std::max(max_, other.max_);
+   }
+
+   void reset() noexcept {
+      std::fill(counts_.begin(), counts_.end(), 0);
+      total_ = 0;
+      min_ = UINT64_MAX;
+      max_ = 0;
+   }
+
+   uint64_t count() const noexcept { return total_; }
+   uint64_t min() const noexcept { return total_ ? min_ : 0; }
+   uint64_t max() const noexcept { return max_; }
+
+   // Highest value equivalent to the sample at `percentile` (0-100), capped at max()
+   uint64_t value_at_percentile(double percentile) const noexcept {
+      if (total_ == 0) return 0;
+      const double clamped = std::clamp(percentile, 0.0, 100.0);
+      const uint64_t rank = std::max<uint64_t>(1, uint64_t(clamped / 100.0 * double(total_) + 0.5));
+      uint64_t seen = 0;
+      for (size_t i = 0; i < counts_.size(); ++i) {
+         seen += counts_[i];
+         if (seen >= rank) return std::min(highest_equivalent(i), max_);
+      }
+      return max_;
+   }
+
+  private:
+   static size_t index_of(uint64_t value) noexcept {
+      if (value < sub_count) return size_t(value);
+      const uint32_t shift = uint32_t(std::bit_width(value)) - sub_bits;
+      return size_t(sub_count + (shift - 1) * half_count + ((value >> shift) - half_count));
+   }
+
+   static uint64_t highest_equivalent(size_t index) noexcept {
+      if (index < sub_count) return index;
+      const uint64_t shift = (index - sub_count) / half_count + 1;
+      const uint64_t top = (index - sub_count) % half_count + half_count;
+      return ((top + 1) << shift) - 1;
+   }
+
+   std::vector<uint64_t> counts_;
+   uint64_t total_{};
+   uint64_t min_{UINT64_MAX};
+   uint64_t max_{};
+};
+
+// ============================================================================
+// Timer
+// ============================================================================
+
+enum class timer_source { tsc, monotonic };
+
+inline const char* timer_source_name(timer_source source) noexcept {
+   return source == timer_source::tsc ? "rdtsc" : "clock_gettime(CLOCK_MONOTONIC)";
+}
+
+// Brackets one operation. TSC reads are fenced so the measured instructions cannot
+// move outside the interval; ticks are converted to ns with a frequency calibrated
+// against steady_clock (assumes an invariant TSC).
+class op_timer {
+  public:
+   explicit op_timer(timer_source source = default_source()) : source_(source) {
+      if (source_ == timer_source::tsc) calibrate();
+   }
+
+   static timer_source default_source() noexcept {
+#if defined(ZMEM_HAS_TSC)
+      return timer_source::tsc;
+#else
+      return timer_source::monotonic;
+#endif
+   }
+
+   timer_source source() const noexcept { return source_; }
+
+   uint64_t start() const noexcept {
+#if defined(ZMEM_HAS_TSC)
+      if (source_ == timer_source::tsc) {
+         _mm_lfence();
+         return __rdtsc();
+      }
+#endif
+      return monotonic_ns();
+   }
+
+   uint64_t stop() const noexcept {
+#if defined(ZMEM_HAS_TSC)
+      if (source_ == timer_source::tsc) {
+         unsigned aux;
+         const uint64_t t = __rdtscp(&aux);
+         _mm_lfence();
+         return t;
+      }
+#endif
+      return monotonic_ns();
+   }
+
+   uint64_t to_ns(uint64_t ticks) const noexcept {
+      return source_ == timer_source::tsc ? uint64_t(double(ticks) * ns_per_tick_ + 0.5) : ticks;
+   }
+
+   // Cost of an empty start/stop pair in ns (minimum over many samples)
+   uint64_t overhead_ns() const noexcept {
+      uint64_t best = UINT64_MAX;
+      for (int i = 0; i < 10000; ++i) {
+         const uint64_t t0 = start();
+         const uint64_t t1 = stop();
+         best = std::min(best, t1 - t0);
+      }
+      return to_ns(best);
+   }
+
+  private:
+   static uint64_t monotonic_ns() noexcept {
+      return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now().time_since_epoch())
+                         .count());
+   }
+
+   void calibrate() noexcept {
+#if defined(ZMEM_HAS_TSC)
+      const auto wall0 = std::chrono::steady_clock::now();
+      const uint64_t tsc0 = __rdtsc();
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      const uint64_t tsc1 = __rdtsc();
+      const auto wall1 = std::chrono::steady_clock::now();
+      const double ns = std::chrono::duration<double, std::nano>(wall1 - wall0).count();
+      ns_per_tick_ = tsc1 > tsc0 ? ns / double(tsc1 - tsc0) : 1.0;
+#else
+      source_ = timer_source::monotonic;
+#endif
+   }
+
+   timer_source source_;
+   double ns_per_tick_{1.0};
+};
+
+// Times `iterations` calls of `func` one by one into `histogram` (ns)
+template <class Func>
+void record_latencies(Func&& func, size_t iterations, const op_timer& timer, hdr_histogram& histogram) {
+   for (size_t i = 0; i < iterations; ++i) {
+      const uint64_t t0 = timer.start();
+      func();
+      const uint64_t t1 = timer.stop();
+      histogram.record(timer.to_ns(t1 - t0));
+   }
+}
+
+// ============================================================================
+// Thread Placement
+// ============================================================================
+
+// Restricts the calling thread to `cpu`
+inline bool pin_current_thread_to_cpu(uint32_t cpu) noexcept {
+#if defined(__linux__)
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   CPU_SET(cpu, &set);
+   return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+   (void)cpu;
+   return false;
+#endif
+}
+
+struct isolation_result {
+   bool realtime{}; // SCHED_FIFO: not preempted by normal threads (needs CAP_SYS_NICE)
+   bool memory_locked{}; // mlockall: no page faults from reclaim (needs RLIMIT_MEMLOCK)
+};
+
+// Best-effort isolation of the calling thread. For full isolation also boot with
+// isolcpus/nohz_full for the pinned CPU and move IRQs off it.
+inline isolation_result isolate_current_thread() noexcept {
+   isolation_result result;
+#if defined(__linux__)
+   sched_param param{};
+   param.sched_priority = ::sched_get_priority_max(SCHED_FIFO);
+   result.realtime = ::sched_setscheduler(0, SCHED_FIFO, &param) == 0;
+   result.memory_locked = ::mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#endif
+   return result;
+}
+
+} // namespace zmem
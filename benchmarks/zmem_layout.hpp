@@ -0,0 +1,191 @@
+// ZMEM Layout Navigation
+// Byte-level helpers for locating vector data inside a variable struct message,
+// for readers that fetch or prefetch byte ranges themselves instead of handing a
+// complete buffer to lazy_zmem_view.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace zmem {
+
+// Vector reference stored in an inline section (see "Vector Field Wire Representation")
+struct vector_ref {
+   uint64_t offset{}; // Relative to the inline base of the containing struct
+   uint64_t count{};
+};
+
+// Location of one vector field within a variable struct
+struct vector_field {
+   uint64_t ref_offset{}; // Position of the vector reference within the inline section
+   uint64_t element_size{}; // Fixed element size in bytes, 0 for variable elements (offset table)
+   uint64_t inline_base{8}; // Byte 8 unless the struct's max field alignment exceeds 8
+};
+
+// Byte range [begin, end) relative to the start of a message
+struct byte_range {
+   uint64_t begin{};
+   uint64_t end{};
+
+   uint64_t size() const noexcept { return end - begin; }
+};
+
+namespace detail {
+
+inline uint64_t load_u64(const char* p) noexcept {
+   uint64_t v;
+   std::memcpy(&v, p, 8);
+   return v;
+}
+
+} // namespace detail
+
+// Total size of a variable struct message from its size header, 0 if truncated
+inline uint64_t message_size(std::string_view message) noexcept {
+   return message.size() < 8 ? 0 : 8 + detail::load_u64(message.data());
+}
+
+// Size header, padding and inline section up to and including the vector reference
+inline byte_range vector_ref_prefix(const vector_field& field) noexcept {
+   return {0, field.inline_base + field.ref_offset + 16};
+}
+
+// Start of the vector data (the offset table for variable elements)
+inline uint64_t vector_data_begin(const vector_field& field, const vector_ref& ref) noexcept {
+   return field.inline_base + ref.offset;
+}
+
+// Offset table entries `index` and `index + 1` of a variable element vector
+inline byte_range offset_table_pair(const vector_field& field, const vector_ref& ref, uint64_t index) noexcept {
+   const uint64_t begin = vector_data_begin(field, ref) + index * 8;
+   return {begin, begin + 16};
+}
+
+// Element `index` of a variable element vector, given its two offset table entries
+inline byte_range variable_element_range(const vector_field& field, const vector_ref& ref, uint64_t offset_begin,
+                                         uint64_t offset_end) noexcept {
+   const uint64_t elements = vector_data_begin(field, ref) + (ref.count + 1) * 8;
+   return {elements + offset_begin, elements + offset_end};
+}
+
+// Element `index` of a fixed element vector
+inline byte_range fixed_element_range(const vector_field& field, const vector_ref& ref, uint64_t index) noexcept {
+   const uint64_t begin = vector_data_begin(field, ref) + index * field.element_size;
+   return {begin, begin + field.element_size};
+}
+
+// Reads the vector reference of `field` from a message prefix. Returns false if the
+// prefix is too short or the reference points outside the message.
+inline bool read_vector_ref(std::string_view message, const vector_field& field, vector_ref& ref) noexcept {
+   const byte_range prefix = vector_ref_prefix(field);
+   if (message.size() < prefix.end) return false;
+   const uint64_t total = message_size(message);
+   ref.offset = detail::load_u64(message.data() + prefix.end - 16);
+   ref.count = detail::load_u64(message.data() + prefix.end - 8);
+   const uint64_t begin = vector_data_begin(field, ref);
+   const uint64_t per_element = field.element_size ? field.element_size : 8;
+   return begin <= total && ref.count <= (total - begin) / per_element;
+}
+
+// Element `index` of the vector `field` in a fully addressable message (loaded or
+// memory mapped). Variable elements are self-contained messages that can be handed
+// directly to lazy_zmem_view. Returns an empty view if the index or layout is invalid.
+inline std::string_view element(std::string_view message, const vector_field& field, uint64_t index) noexcept {
+   vector_ref ref;
+   if (!read_vector_ref(message, field, ref) || index >= ref.count) return {};
+   byte_range range;
+   if (field.element_size) {
+      range = fixed_element_range(field, ref, index);
+   }
+   else {
+      const byte_range pair = offset_table_pair(field, ref, index);
+      if (pair.end > message.size()) return {};
+      const uint64_t offset_begin = detail::load_u64(message.data() + pair.begin);
+      const uint64_t offset_end = detail::load_u64(message.data() + pair.begin + 8);
+      if (offset_begin > offset_end || offset_end > message.size()) return {};
+      range = variable_element_range(field, ref, offset_begin, offset_end);
+   }
+   if (range.end > message.size() || range.begin > range.end) return {};
+   return message.substr(range.begin, range.size());
+}
+
+// Nested vectors ([[T]], [[[T]]], ...) have an offset table at every level but the
+// last ("Nested Vectors"). Each inner vector is [count:8][offset table][inner vectors]
+// above the last level and [count:8][elements] at it.
+
+// Element `path` of the nested vector `field`, one index per level (outermost first),
+// following one offset table per level above the last. `element_size` is the size of
+// the innermost fixed element. Returns an empty view if any index or offset is invalid.
+inline std::string_view nested_element(std::string_view message, const vector_field& field,
+                                       std::span<const uint64_t> path, uint64_t element_size) noexcept {
+   if (path.empty()) return {};
+   const uint64_t outer_size = path.size() == 1 ? element_size : 0; // Offset table entries otherwise
+   vector_ref ref;
+   if (!read_vector_ref(message, {field.ref_offset, outer_size, field.inline_base}, ref)) return {};
+   uint64_t count = ref.count;
+   uint64_t data = vector_data_begin(field, ref);
+   for (size_t level = 0; level + 1 < path.size(); ++level) {
+      if (path[level] >= count) return {};
+      // Count first, so a corrupt count cannot overflow the table size
+      if (data > message.size() || count > (message.size() - data) / 8) return {};
+      const uint64_t elements = data + (count + 1) * 8;
+      if (elements > message.size()) return {};
+      const uint64_t inner = elements + detail::load_u64(message.data() + data + path[level] * 8);
+      if (inner < elements || inner > message.size() - 8) return {};
+      count = detail::load_u64(message.data() + inner);
+      data = inner + 8;
+   }
+   if (path.back() >= count || data > message.size()) return {};
+   if (element_size && path.back() > (message.size() - data) / element_size) return {};
+   const uint64_t begin = data + path.back() * element_size;
+   if (begin > message.size() || element_size > message.size() - begin) return {};
+   return message.substr(begin, element_size);
+}
+
+// A map field is a vector of sorted entries with the key first ("Maps"), so
+// `field.element_size` is the entry size: {key, value} for fixed maps and
+// {key, offset, count} for vector and string values.
+
+// Entry with `key` by binary search, or an empty view if absent
+template <class Key>
+std::string_view find_map_entry(std::string_view message, const vector_field& field, Key key) noexcept {
+   vector_ref ref;
+   if (field.element_size < sizeof(Key) || !read_vector_ref(message, field, ref)) return {};
+   const char* entries = message.data() + vector_data_begin(field, ref);
+   auto key_at = [&](uint64_t index) {
+      Key k;
+      std::memcpy(&k, entries + index * field.element_size, sizeof(Key));
+      return k;
+   };
+   uint64_t lo = 0;
+   uint64_t hi = ref.count;
+   while (lo < hi) {
+      const uint64_t mid = lo + (hi - lo) / 2;
+      if (key_at(mid) < key) {
+         lo = mid + 1;
+      }
+      else {
+         hi = mid;
+      }
+   }
+   if (lo == ref.count || key_at(lo) != key) return {};
+   return {entries + lo * field.element_size, field.element_size};
+}
+
+// Bytes of a vector or string value referenced by `entry` (from find_map_entry), whose
+// offset is relative to the inline base of the struct holding the map
+template <class Key>
+std::string_view map_vector_value(std::string_view message, const vector_field& field,
+                                  std::string_view entry, uint64_t element_size = 1) noexcept {
+   constexpr uint64_t ref_at = (sizeof(Key) + 7) / 8 * 8;
+   if (entry.size() < ref_at + 16) return {};
+   const uint64_t begin = field.inline_base + detail::load_u64(entry.data() + ref_at);
+   const uint64_t count = detail::load_u64(entry.data() + ref_at + 8);
+   if (begin > message.size() || count > (message.size() - begin) / element_size) return {};
+   return message.substr(begin, count * element_size);
+}
+
+} // namespace zmem
@@ -0,0 +1,179 @@
+// ZMEM Mapped File
+// Read-only memory mapping of a ZMEM file (POSIX), shared by the file-backed
+// benchmarks, plus page cache control for cold-read measurements. Files can
+// instead be loaded into huge-page memory (zmem_huge_pages.hpp) for random access.
+
+#pragma once
+
+#include "zmem_huge_pages.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace zmem {
+
+enum class map_advice : uint32_t {
+   normal,
+   sequential,
+   random, // Disables kernel readahead: each fault reads a single page
+   willneed,
+   hugepage, // MADV_HUGEPAGE; file mappings only with CONFIG_READ_ONLY_THP_FOR_FS (khugepaged)
+};
+
+class mapped_file {
+  public:
+   mapped_file() = default;
+   explicit mapped_file(const std::string& path) { (void)open(path); }
+   ~mapped_file() { close(); }
+
+   mapped_file(const mapped_file&) = delete;
+   mapped_file& operator=(const mapped_file&) = delete;
+   mapped_file(mapped_file&& other) noexcept { swap(other); }
+   mapped_file& operator=(mapped_file&& other) noexcept {
+      if (this != &other) {
+         close();
+         swap(other);
+      }
+      return *this;
+   }
+
+   // Returns false (with errno set) and leaves the object closed on failure
+   bool open(const std::string& path) {
+      close();
+      fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd_ < 0) return false;
+      struct stat st{};
+      if (::fstat(fd_, &st) != 0) {
+         close();
+         return false;
+      }
+      size_ = size_t(st.st_size);
+      if (size_ == 0) return true;
+      void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+      if (p == MAP_FAILED) {
+         close();
+         return false;
+      }
+      data_ = static_cast<const char*>(p);
+      mapping_size_ = size_;
+      return true;
+   }
+
+   // Reads the whole file into private anonymous memory backed by `pages`. Unlike a
+   // file mapping this gets 2 MB TLB entries on any filesystem, at the cost of a copy
+   // and of memory not shared with the page cache.
+   bool load(const std::string& path, huge_pages pages) {
+      close();
+      fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd_ < 0) return false;
+      struct stat st{};
+      if (::fstat(fd_, &st) != 0) {
+         close();
+         return false;
+      }
+      size_ = size_t(st.st_size);
+      if (size_ == 0) return true;
+      const size_t mapping_size = detail::round_to_huge_page(size_);
+      char* p = static_cast<char*>(detail::map_anonymous(mapping_size, pages));
+      if (!p) {
+         close();
+         return false;
+      }
+      data_ = p;
+      mapping_size_ = mapping_size;
+      for (size_t done = 0; done < size_;) {
+         const ssize_t n = ::pread(fd_, p + done, size_ - done, off_t(done));
+         if (n <= 0) {
+            close();
+            return false;
+         }
+         done += size_t(n);
+      }
+      ::mprotect(p, mapping_size, PROT_READ);
+      return true;
+   }
+
+   void close() noexcept {
+      if (data_) ::munmap(const_cast<char*>(data_), mapping_size_);
+      if (fd_ >= 0) ::close(fd_);
+      data_ = nullptr;
+      size_ = 0;
+      mapping_size_ = 0;
+      fd_ = -1;
+   }
+
+   bool is_open() const noexcept { return fd_ >= 0; }
+   const char* data() const noexcept { return data_; }
+   size_t size() const noexcept { return size_; }
+   std::string_view bytes() const noexcept { return {data_, size_}; }
+   int fd() const noexcept { return fd_; }
+
+   bool advise(map_advice advice) const noexcept {
+      if (!data_) return false;
+      int flag = MADV_NORMAL;
+      switch (advice) {
+         case map_advice::normal: flag = MADV_NORMAL; break;
+         case map_advice::sequential: flag = MADV_SEQUENTIAL; break;
+         case map_advice::random: flag = MADV_RANDOM; break;
+         case map_advice::willneed: flag = MADV_WILLNEED; break;
+         case map_advice::hugepage:
+#if defined(MADV_HUGEPAGE)
+            flag = MADV_HUGEPAGE;
+            break;
+#else
+            return false;
+#endif
+      }
+      return ::madvise(const_cast<char*>(data_), size_, flag) == 0;
+   }
+
+   // Bytes of the mapping in memory (page cache for file mappings), per mincore(2)
+   size_t resident_bytes() const {
+      if (!data_) return 0;
+      const size_t page = size_t(::sysconf(_SC_PAGESIZE));
+      std::vector<unsigned char> pages((mapping_size_ + page - 1) / page);
+      if (::mincore(const_cast<char*>(data_), mapping_size_, pages.data()) != 0) return 0;
+      size_t resident = 0;
+      for (const unsigned char p : pages) resident += p & 1;
+      return resident * page;
+   }
+
+  private:
+   void swap(mapped_file& other) noexcept {
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(mapping_size_, other.mapping_size_);
+      std::swap(fd_, other.fd_);
+   }
+
+   const char* data_{};
+   size_t size_{};
+   size_t mapping_size_{};
+   int fd_{-1};
+};
+
+// Evicts the file's pages from the page cache so the next read goes to the device.
+// Pages still mapped by a live mapping are not evicted: close mappings first.
+inline bool drop_page_cache(const std::string& path) noexcept {
+   const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+   if (fd < 0) return false;
+   bool ok = ::fdatasync(fd) == 0;
+#if defined(POSIX_FADV_DONTNEED)
+   ok &= ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+#else
+   ok = false;
+#endif
+   ::close(fd);
+   return ok;
+}
+
+} // namespace zmem
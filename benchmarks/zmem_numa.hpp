@@ -0,0 +1,248 @@
+// ZMEM NUMA Replication
+// Per-node copies of hot read-only regions (typically part of a mapped_file) so
+// worker threads on every socket read node-local memory. Topology comes from
+// /sys/devices/system/node, or is simulated to exercise the code on one node.
+// Placement uses mbind(2) through raw syscalls; no libnuma dependency.
+
+#pragma once
+
+#include "zmem_huge_pages.hpp"
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace zmem {
+
+namespace detail {
+
+// Node index recorded by numa_topology::pin_current_thread, -1 if not pinned
+inline int& pinned_node() noexcept {
+   static thread_local int node = -1;
+   return node;
+}
+
+} // namespace detail
+
+struct numa_node {
+   uint32_t id{};
+   std::vector<uint32_t> cpus{};
+};
+
+class numa_topology {
+  public:
+   // Online nodes and their CPUs; a single node covering all CPUs if sysfs is unavailable
+   static numa_topology detect() {
+      numa_topology topology;
+      for (uint32_t id = 0; id < max_nodes; ++id) {
+         std::ifstream in("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist");
+         std::string list;
+         if (!in || !std::getline(in, list)) continue;
+         numa_node node{id, parse_cpu_list(list)};
+         if (!node.cpus.empty()) topology.nodes_.push_back(std::move(node));
+      }
+      if (topology.nodes_.empty()) topology.nodes_.push_back({0, online_cpus()});
+      return topology;
+   }
+
+   // `nodes` fake nodes over the online CPUs (round robin; CPUs are shared when there
+   // are fewer CPUs than nodes). Memory is not actually placed: replicas all live on
+   // the real node, so only the code paths, not the interconnect, are exercised. At
+   // least one node is created.
+   static numa_topology simulated(uint32_t nodes) {
+      nodes = std::max<uint32_t>(1, nodes);
+      numa_topology topology;
+      topology.simulated_ = true;
+      const std::vector<uint32_t> cpus = online_cpus();
+      for (uint32_t id = 0; id < nodes; ++id) topology.nodes_.push_back({id, {}});
+      for (size_t i = 0; i < std::max<size_t>(cpus.size(), nodes); ++i) {
+         topology.nodes_[i % nodes].cpus.push_back(cpus[i % cpus.size()]);
+      }
+      return topology;
+   }
+
+   size_t node_count() const noexcept { return nodes_.size(); }
+   const numa_node& node(size_t index) const noexcept { return nodes_[index]; }
+   bool simulated() const noexcept { return simulated_; }
+
+   // Index (not id) of the node owning `cpu`, 0 if unknown
+   size_t node_of_cpu(uint32_t cpu) const noexcept {
+      for (size_t i = 0; i < nodes_.size(); ++i) {
+         for (const uint32_t c : nodes_[i].cpus) {
+            if (c == cpu) return i;
+         }
+      }
+      return 0;
+   }
+
+   // Index of the node the calling thread was pinned to, else the one it is running on
+   size_t current_node() const noexcept {
+      if (detail::pinned_node() >= 0) return size_t(detail::pinned_node()) % nodes_.size();
+      const int cpu = ::sched_getcpu();
+      return cpu < 0 ? 0 : node_of_cpu(uint32_t(cpu));
+   }
+
+   // Restricts the calling thread to the CPUs of node `index`
+   bool pin_current_thread(size_t index) const noexcept {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (const uint32_t cpu : nodes_[index].cpus) CPU_SET(cpu, &set);
+      if (::sched_setaffinity(0, sizeof(set), &set) != 0) return false;
+      detail::pinned_node() = int(index);
+      return true;
+   }
+
+  private:
+   static constexpr uint32_t max_nodes = 1024;
+
+   // "0-3,8,10-11"
+   static std::vector<uint32_t> parse_cpu_list(const std::string& list) {
+      std::vector<uint32_t> cpus;
+      std::stringstream ss(list);
+      std::string part;
+      while (std::getline(ss, part, ',')) {
+         if (part.empty() || part[0] < '0' || part[0] > '9') continue;
+         const size_t dash = part.find('-');
+         const uint32_t first = uint32_t(std::stoul(part.substr(0, dash)));
+         const uint32_t last = dash == std::string::npos ? first : uint32_t(std::stoul(part.substr(dash + 1)));
+         for (uint32_t cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+      }
+      return cpus;
+   }
+
+   static std::vector<uint32_t> online_cpus() {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      std::vector<uint32_t> cpus;
+      if (::sched_getaffinity(0, sizeof(set), &set) == 0) {
+         for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+         }
+      }
+      if (cpus.empty()) cpus.push_back(0);
+      return cpus;
+   }
+
+   std::vector<numa_node> nodes_{};
+   bool simulated_{};
+};
+
+namespace detail {
+
+// From <numaif.h>
+constexpr int mpol_bind = 2;
+constexpr unsigned mpol_mf_move = 1u << 1;
+constexpr unsigned long mpol_f_node = 1ul << 0;
+constexpr unsigned long mpol_f_addr = 1ul << 1;
+
+// Binds the pages of [p, p + bytes) to node `id`; pages not yet touched are allocated there
+inline bool bind_to_node(void* p, size_t bytes, uint32_t id) noexcept {
+#if defined(SYS_mbind)
+   unsigned long mask[16]{};
+   if (id >= sizeof(mask) * 8) return false;
+   mask[id / (sizeof(unsigned long) * 8)] = 1ul << (id % (sizeof(unsigned long) * 8));
+   return ::syscall(SYS_mbind, p, bytes, mpol_bind, mask, sizeof(mask) * 8 + 1, mpol_mf_move) == 0;
+#else
+   (void)p;
+   (void)bytes;
+   (void)id;
+   return false;
+#endif
+}
+
+} // namespace detail
+
+// Node id of the page holding `address` (touched pages only), -1 if unknown
+inline int node_of_address(const void* address) noexcept {
+#if defined(SYS_get_mempolicy)
+   int node = -1;
+   if (::syscall(SYS_get_mempolicy, &node, nullptr, 0, address, detail::mpol_f_node | detail::mpol_f_addr) != 0) {
+      return -1;
+   }
+   return node;
+#else
+   (void)address;
+   return -1;
+#endif
+}
+
+// Read-only copies of `source`, one per node. On a single real node the source is
+// used directly and nothing is copied.
+class replicated_region {
+  public:
+   replicated_region() = default;
+   replicated_region(std::string_view source, const numa_topology& topology, huge_pages pages = huge_pages::none)
+      : source_(source), topology_(&topology) {
+      if (topology.node_count() < 2 && !topology.simulated()) return;
+      const size_t mapping_size = detail::round_to_huge_page(std::max<size_t>(source.size(), 1));
+      for (size_t i = 0; i < topology.node_count(); ++i) {
+         char* p = static_cast<char*>(detail::map_anonymous(mapping_size, pages));
+         if (!p) {
+            release();
+            return;
+         }
+         if (!topology.simulated()) (void)detail::bind_to_node(p, mapping_size, topology.node(i).id);
+         std::memcpy(p, source.data(), source.size());
+         ::mprotect(p, mapping_size, PROT_READ);
+         replicas_.push_back({p, mapping_size});
+      }
+   }
+   ~replicated_region() { release(); }
+
+   replicated_region(const replicated_region&) = delete;
+   replicated_region& operator=(const replicated_region&) = delete;
+   replicated_region(replicated_region&& other) noexcept { swap(other); }
+   replicated_region& operator=(replicated_region&& other) noexcept {
+      if (this != &other) {
+         release();
+         swap(other);
+      }
+      return *this;
+   }
+
+   // False on a single real node, or if a copy could not be allocated
+   bool replicated() const noexcept { return !replicas_.empty(); }
+   size_t replica_count() const noexcept { return replicas_.size(); }
+
+   // Copy on node index `node` (see numa_topology::node), the source if not replicated
+   std::string_view on_node(size_t node) const noexcept {
+      if (replicas_.empty()) return source_;
+      return {replicas_[node % replicas_.size()].first, source_.size()};
+   }
+
+   // Copy local to the calling thread. Threads that migrate between nodes should
+   // be pinned (numa_topology::pin_current_thread) or call this per batch.
+   std::string_view local() const noexcept {
+      return replicas_.empty() ? source_ : on_node(topology_->current_node());
+   }
+
+  private:
+   void release() noexcept {
+      for (auto& [p, size] : replicas_) detail::unmap_anonymous(p, size);
+      replicas_.clear();
+   }
+
+   void swap(replicated_region& other) noexcept {
+      std::swap(source_, other.source_);
+      std::swap(topology_, other.topology_);
+      std::swap(replicas_, other.replicas_);
+   }
+
+   std::string_view source_{};
+   const numa_topology* topology_{};
+   std::vector<std::pair<char*, size_t>> replicas_{};
+};
+
+} // namespace zmem
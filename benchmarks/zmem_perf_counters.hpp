@@ -0,0 +1,193 @@
+// ZMEM Hardware Performance Counters
+// Opt-in perf_event_open(2) collector for the calling thread: cycles, instructions,
+// L1D and LLC misses, branch misses and dTLB misses. Each event is opened on its
+// own so the kernel can multiplex when there are more events than counters; counts
+// are scaled by time enabled / time running. Events the PMU, hypervisor or
+// perf_event_paranoid setting does not allow are reported as unavailable.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace zmem {
+
+enum class perf_event : uint32_t {
+   cycles,
+   instructions,
+   l1d_misses,
+   llc_misses,
+   branch_misses,
+   dtlb_misses,
+};
+
+constexpr size_t perf_event_count = 6;
+
+inline const char* perf_event_name(perf_event event) noexcept {
+   switch (event) {
+      case perf_event::cycles: return "Cycles";
+      case perf_event::instructions: return "Instructions";
+      case perf_event::l1d_misses: return "L1D misses";
+      case perf_event::llc_misses: return "LLC misses";
+      case perf_event::branch_misses: return "Branch misses";
+      case perf_event::dtlb_misses: return "dTLB misses";
+   }
+   return "?";
+}
+
+// Counts over one measured interval; negative when the event is unavailable
+struct perf_sample {
+   std::array<double, perf_event_count> counts{-1, -1, -1, -1, -1, -1};
+
+   double operator[](perf_event event) const noexcept { return counts[size_t(event)]; }
+   bool available(perf_event event) const noexcept { return counts[size_t(event)] >= 0; }
+
+   // Instructions per cycle, negative if either count is unavailable
+   double ipc() const noexcept {
+      if (!available(perf_event::cycles) || !available(perf_event::instructions) || (*this)[perf_event::cycles] == 0) {
+         return -1;
+      }
+      return (*this)[perf_event::instructions] / (*this)[perf_event::cycles];
+   }
+
+   // Counts divided by `ops`, unavailable events left negative
+   perf_sample per_op(size_t ops) const noexcept {
+      perf_sample r = *this;
+      for (auto& c : r.counts) {
+         if (c >= 0 && ops) c /= static_cast<double>(ops);
+      }
+      return r;
+   }
+};
+
+class perf_counters {
+  public:
+   perf_counters() {
+#if defined(__linux__)
+      for (size_t i = 0; i < perf_event_count; ++i) fds_[i] = open_event(perf_event(i));
+#endif
+   }
+   ~perf_counters() { close(); }
+
+   perf_counters(const perf_counters&) = delete;
+   perf_counters& operator=(const perf_counters&) = delete;
+   perf_counters(perf_counters&& other) noexcept : fds_(std::exchange(other.fds_, closed_fds())) {}
+   perf_counters& operator=(perf_counters&& other) noexcept {
+      if (this != &other) {
+         close();
+         fds_ = std::exchange(other.fds_, closed_fds());
+      }
+      return *this;
+   }
+
+   // True if at least one event could be opened
+   bool valid() const noexcept {
+      for (const int fd : fds_) {
+         if (fd >= 0) return true;
+      }
+      return false;
+   }
+
+   bool available(perf_event event) const noexcept { return fds_[size_t(event)] >= 0; }
+
+   void start() noexcept {
+#if defined(__linux__)
+      for (const int fd : fds_) {
+         if (fd >= 0) ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      }
+      for (const int fd : fds_) {
+         if (fd >= 0) ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+   }
+
+   perf_sample stop() noexcept {
+      perf_sample sample;
+#if defined(__linux__)
+      for (const int fd : fds_) {
+         if (fd >= 0) ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      }
+      for (size_t i = 0; i < perf_event_count; ++i) {
+         if (fds_[i] < 0) continue;
+         uint64_t values[3]{}; // value, time enabled, time running
+         if (::read(fds_[i], values, sizeof(values)) != ssize_t(sizeof(values)) || values[2] == 0) continue;
+         sample.counts[i] = static_cast<double>(values[0]) * static_cast<double>(values[1]) /
+                            static_cast<double>(values[2]);
+      }
+#endif
+      return sample;
+   }
+
+  private:
+   static std::array<int, perf_event_count> closed_fds() noexcept {
+      std::array<int, perf_event_count> fds;
+      fds.fill(-1);
+      return fds;
+   }
+
+   void close() noexcept {
+#if defined(__linux__)
+      for (int& fd : fds_) {
+         if (fd >= 0) ::close(fd);
+         fd = -1;
+      }
+#endif
+   }
+
+#if defined(__linux__)
+   static int open_event(perf_event event) noexcept {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      constexpr uint64_t read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      switch (event) {
+         case perf_event::cycles:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+         case perf_event::instructions:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+         case perf_event::l1d_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | read_miss;
+            break;
+         case perf_event::llc_misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+         case perf_event::branch_misses:
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+         case perf_event::dtlb_misses:
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB | read_miss;
+            break;
+      }
+      // This thread, any CPU
+      return int(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+   }
+#endif
+
+   std::array<int, perf_event_count> fds_ = closed_fds();
+};
+
+} // namespace zmem
@@ -0,0 +1,554 @@
+// ZMEM Write Pipeline
+// Capture-to-disk writer split into stages, each on its own thread (optionally pinned):
+//
+//    producers -> checksum -> compress (optional) -> I/O -> back to producers
+//
+// Producer threads append framed messages (glz::write_zmem output of variable structs)
+// to pooled batch buffers. Full batches move between stages through lock-free
+// single-producer single-consumer rings; the I/O stage writes every batch it has with
+// one writev(2) and hands the buffers back to their producers. Each producer owns a
+// fixed number of buffers, so a slow stage stalls producers instead of growing memory.
+//
+// File format: a sequence of batch records, each a pipeline_batch_header followed by
+// its payload padded to 8 bytes. The payload is the concatenated messages, or a
+// message-log block container (zmem_block_container.hpp) when compressed; the CRC32C
+// covers the concatenated messages. POSIX only.
+
+#pragma once
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_block_container.hpp"
+#include "zmem_checksum.hpp"
+#include "zmem_latency.hpp"
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace zmem {
+
+enum class pipeline_error : uint32_t {
+   none = 0,
+   io_error,
+   compress_error,
+   truncated,
+   bad_magic,
+   checksum_mismatch,
+};
+
+inline constexpr char pipeline_magic[4] = {'Z', 'M', 'P', 'B'};
+
+enum pipeline_flags : uint32_t {
+   pipeline_flag_checksum = 1, // crc32c is set
+   pipeline_flag_compressed = 2, // Payload is a message-log block container
+};
+
+struct pipeline_batch_header {
+   char magic[4]{};
+   uint32_t flags{};
+   uint64_t messages{};
+   uint64_t raw_size{}; // Concatenated messages
+   uint64_t stored_size{}; // Payload bytes that follow, before padding
+   uint32_t crc32c{};
+   uint32_t reserved{};
+};
+static_assert(sizeof(pipeline_batch_header) == 40);
+
+struct pipeline_options {
+   size_t producers = 1;
+   size_t batch_bytes = 1024 * 1024; // A batch is handed off once it holds this many bytes
+   size_t buffers_per_producer = 8; // Memory is bounded by producers * buffers * batch_bytes
+   size_t max_gather = 16; // Batches written per writev
+   bool checksum = true;
+   bool compress = false;
+   block_options compression{};
+   // CPUs for the checksum, compress and I/O stages, in that order; missing or
+   // negative entries leave a stage unpinned
+   std::vector<int> stage_cpus{};
+};
+
+// Per-stage counters. Idle time is spent waiting for input: the stage is faster than
+// its upstream. For producers, stalled time is spent waiting for a free buffer: some
+// downstream stage is the bottleneck.
+struct stage_metrics {
+   uint64_t batches{};
+   uint64_t bytes_in{};
+   uint64_t bytes_out{};
+   uint64_t busy_ns{};
+   uint64_t idle_ns{};
+   uint64_t calls{}; // writev calls (I/O stage)
+};
+
+struct producer_metrics {
+   uint64_t messages{};
+   uint64_t bytes{};
+   uint64_t batches{};
+   uint64_t stalls{}; // Batch acquisitions that had to wait
+   uint64_t stalled_ns{};
+};
+
+struct pipeline_metrics {
+   producer_metrics producers{}; // Summed over producers
+   stage_metrics checksum{};
+   stage_metrics compress{};
+   stage_metrics io{};
+};
+
+// ============================================================================
+// Single-Producer Single-Consumer Ring
+// ============================================================================
+
+// Bounded lock-free ring. One thread pushes, one thread pops; each side caches the
+// other's index so the shared cache line is only read when the ring looks full/empty.
+template <class T>
+class spsc_ring {
+  public:
+   explicit spsc_ring(size_t capacity)
+      : slots_(std::bit_ceil(std::max<size_t>(capacity, 2))), mask_(slots_.size() - 1) {}
+
+   bool try_push(const T& value) noexcept {
+      const size_t tail = tail_.load(std::memory_order_relaxed);
+      if (tail - head_cache_ > mask_) {
+         head_cache_ = head_.load(std::memory_order_acquire);
+         if (tail - head_cache_ > mask_) return false;
+      }
+      slots_[tail & mask_] = value;
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+   }
+
+   bool try_pop(T& value) noexcept {
+      const size_t head = head_.load(std::memory_order_relaxed);
+      if (head == tail_cache_) {
+         tail_cache_ = tail_.load(std::memory_order_acquire);
+         if (head == tail_cache_) return false;
+      }
+      value = slots_[head & mask_];
+      head_.store(head + 1, std::memory_order_release);
+      return true;
+   }
+
+   size_t capacity() const noexcept { return slots_.size(); }
+
+  private:
+   std::vector<T> slots_;
+   size_t mask_;
+   alignas(64) std::atomic<size_t> head_{0};
+   size_t tail_cache_{0}; // Consumer's view of tail_
+   alignas(64) std::atomic<size_t> tail_{0};
+   size_t head_cache_{0}; // Producer's view of head_
+};
+
+namespace detail {
+
+inline uint64_t pipeline_now_ns() noexcept {
+   return uint64_t(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+         .count());
+}
+
+// Spins briefly, then yields
+inline void pipeline_backoff(uint32_t& spins) noexcept {
+   if (++spins < 64) {
+#if defined(ZMEM_HAS_TSC)
+      _mm_pause();
+#endif
+   }
+   else {
+      std::this_thread::yield();
+   }
+}
+
+} // namespace detail
+
+struct pipeline_batch {
+   pipeline_batch_header header{};
+   std::string data{}; // Concatenated framed messages
+   std::string compressed{}; // Block container when compression is on
+   uint32_t producer{};
+
+   std::string_view payload() const noexcept {
+      return (header.flags & pipeline_flag_compressed) ? std::string_view{compressed} : std::string_view{data};
+   }
+};
+
+class write_pipeline;
+
+// ============================================================================
+// Producer
+// ============================================================================
+
+// Handle used by exactly one producer thread
+class pipeline_producer {
+  public:
+   // Encodes `value` into the current batch; false on encode error or after an I/O error
+   template <class T>
+   bool write(const T& value) {
+      if (auto ec = glz::write_zmem(value, scratch_); ec) return false;
+      return append(scratch_);
+   }
+
+   // Appends an already framed message
+   bool append(std::string_view message);
+
+   // Hands off the current batch even if it is not full
+   bool flush();
+
+   const producer_metrics& metrics() const noexcept { return metrics_; }
+
+  private:
+   friend class write_pipeline;
+
+   pipeline_producer(write_pipeline& pipeline, uint32_t index, size_t buffers, size_t batch_bytes);
+
+   void acquire();
+
+   write_pipeline* pipeline_;
+   std::vector<std::unique_ptr<pipeline_batch>> pool_;
+   spsc_ring<pipeline_batch*> free_; // I/O stage -> producer
+   spsc_ring<pipeline_batch*> out_; // Producer -> checksum stage
+   pipeline_batch* current_{};
+   std::string scratch_{};
+   producer_metrics metrics_{};
+};
+
+// ============================================================================
+// Pipeline
+// ============================================================================
+
+class write_pipeline {
+  public:
+   // Writes to `fd` (not closed by the pipeline). Stage threads start immediately.
+   write_pipeline(int fd, const pipeline_options& opts = {})
+      : fd_(fd), opts_(opts), to_compress_(total_buffers()), to_io_(total_buffers()) {
+      opts_.producers = std::max<size_t>(opts_.producers, 1);
+      opts_.buffers_per_producer = std::max<size_t>(opts_.buffers_per_producer, 1);
+      opts_.max_gather = std::max<size_t>(opts_.max_gather, 1);
+      for (size_t p = 0; p < opts_.producers; ++p) {
+         producers_.emplace_back(
+            new pipeline_producer(*this, uint32_t(p), opts_.buffers_per_producer, opts_.batch_bytes));
+      }
+      checksum_thread_ = std::thread([this] { run_checksum(); });
+      if (opts_.compress) compress_thread_ = std::thread([this] { run_compress(); });
+      io_thread_ = std::thread([this] { run_io(); });
+   }
+
+   write_pipeline(const write_pipeline&) = delete;
+   write_pipeline& operator=(const write_pipeline&) = delete;
+
+   ~write_pipeline() { finish(); }
+
+   pipeline_producer& producer(size_t index) noexcept { return *producers_[index]; }
+   size_t producer_count() const noexcept { return producers_.size(); }
+
+   // Flushes every producer's partial batch, drains the stages and joins them. Call
+   // once the producer threads have stopped writing.
+   pipeline_error finish() {
+      if (finished_) return error();
+      finished_ = true;
+      for (auto& p : producers_) p->flush();
+      producers_done_.store(true, std::memory_order_release);
+      if (checksum_thread_.joinable()) checksum_thread_.join();
+      if (compress_thread_.joinable()) compress_thread_.join();
+      if (io_thread_.joinable()) io_thread_.join();
+      return error();
+   }
+
+   pipeline_error error() const noexcept { return error_.load(std::memory_order_acquire); }
+
+   // Complete after finish()
+   pipeline_metrics metrics() const {
+      pipeline_metrics m;
+      for (const auto& p : producers_) {
+         const producer_metrics& pm = p->metrics();
+         m.producers.messages += pm.messages;
+         m.producers.bytes += pm.bytes;
+         m.producers.batches += pm.batches;
+         m.producers.stalls += pm.stalls;
+         m.producers.stalled_ns += pm.stalled_ns;
+      }
+      m.checksum = checksum_metrics_;
+      m.compress = compress_metrics_;
+      m.io = io_metrics_;
+      return m;
+   }
+
+  private:
+   friend class pipeline_producer;
+
+   // Every ring can hold every buffer, so handing a batch on never blocks
+   size_t total_buffers() const noexcept {
+      return std::max<size_t>(opts_.producers, 1) * std::max<size_t>(opts_.buffers_per_producer, 1);
+   }
+
+   void fail(pipeline_error ec) noexcept {
+      pipeline_error expected = pipeline_error::none;
+      error_.compare_exchange_strong(expected, ec, std::memory_order_acq_rel);
+   }
+
+   void pin(size_t stage) const noexcept {
+      if (stage < opts_.stage_cpus.size() && opts_.stage_cpus[stage] >= 0) {
+         (void)pin_current_thread_to_cpu(uint32_t(opts_.stage_cpus[stage]));
+      }
+   }
+
+   // Waits for the next batch from `pop`, accounting the wait as idle time. Returns
+   // nullptr once `upstream_done` is set and nothing is left.
+   template <class Pop>
+   static pipeline_batch* next(Pop&& pop, const std::atomic<bool>& upstream_done, stage_metrics& metrics) {
+      pipeline_batch* batch = nullptr;
+      if (pop(batch)) return batch;
+      const uint64_t t0 = detail::pipeline_now_ns();
+      uint32_t spins = 0;
+      while (true) {
+         // Read the flag before the last pop so nothing pushed before it is missed
+         const bool done = upstream_done.load(std::memory_order_acquire);
+         if (pop(batch) || done) break;
+         detail::pipeline_backoff(spins);
+      }
+      metrics.idle_ns += detail::pipeline_now_ns() - t0;
+      return batch;
+   }
+
+   void run_checksum() {
+      pin(0);
+      auto& downstream = opts_.compress ? to_compress_ : to_io_;
+      size_t cursor = 0;
+      auto pop = [&](pipeline_batch*& batch) {
+         for (size_t i = 0; i < producers_.size(); ++i) {
+            auto& ring = producers_[(cursor + i) % producers_.size()]->out_;
+            if (ring.try_pop(batch)) {
+               cursor = (cursor + i + 1) % producers_.size();
+               return true;
+            }
+         }
+         return false;
+      };
+      while (pipeline_batch* batch = next(pop, producers_done_, checksum_metrics_)) {
+         const uint64_t t0 = detail::pipeline_now_ns();
+         std::memcpy(batch->header.magic, pipeline_magic, 4);
+         batch->header.raw_size = batch->data.size();
+         batch->header.stored_size = batch->data.size();
+         batch->header.flags = 0;
+         batch->header.crc32c = 0;
+         if (opts_.checksum) {
+            batch->header.crc32c = crc32c(batch->data);
+            batch->header.flags |= pipeline_flag_checksum;
+         }
+         checksum_metrics_.batches += 1;
+         checksum_metrics_.bytes_in += batch->data.size();
+         checksum_metrics_.bytes_out += batch->data.size();
+         checksum_metrics_.busy_ns += detail::pipeline_now_ns() - t0;
+         (void)downstream.try_push(batch);
+      }
+      checksum_done_.store(true, std::memory_order_release);
+   }
+
+   void run_compress() {
+      pin(1);
+      auto pop = [&](pipeline_batch*& batch) { return to_compress_.try_pop(batch); };
+      while (pipeline_batch* batch = next(pop, checksum_done_, compress_metrics_)) {
+         const uint64_t t0 = detail::pipeline_now_ns();
+         if (compress_message_log(batch->data, batch->compressed, opts_.compression) != block_error::none) {
+            fail(pipeline_error::compress_error);
+         }
+         else if (batch->compressed.size() < batch->data.size()) {
+            batch->header.flags |= pipeline_flag_compressed;
+            batch->header.stored_size = batch->compressed.size();
+         }
+         compress_metrics_.batches += 1;
+         compress_metrics_.bytes_in += batch->data.size();
+         compress_metrics_.bytes_out += batch->header.stored_size;
+         compress_metrics_.busy_ns += detail::pipeline_now_ns() - t0;
+         (void)to_io_.try_push(batch);
+      }
+      compress_done_.store(true, std::memory_order_release);
+   }
+
+   void run_io() {
+      pin(2);
+      const std::atomic<bool>& upstream_done = opts_.compress ? compress_done_ : checksum_done_;
+      static constexpr char zeros[8]{};
+      std::vector<pipeline_batch*> gathered;
+      std::vector<iovec> iov;
+      gathered.reserve(opts_.max_gather);
+      iov.reserve(opts_.max_gather * 3);
+      auto pop = [&](pipeline_batch*& batch) { return to_io_.try_pop(batch); };
+      while (pipeline_batch* first = next(pop, upstream_done, io_metrics_)) {
+         const uint64_t t0 = detail::pipeline_now_ns();
+         gathered.assign(1, first);
+         pipeline_batch* batch;
+         while (gathered.size() < opts_.max_gather && to_io_.try_pop(batch)) gathered.push_back(batch);
+
+         iov.clear();
+         size_t bytes = 0;
+         for (pipeline_batch* b : gathered) {
+            const std::string_view payload = b->payload();
+            const size_t padding = detail::padded_size_8(payload.size()) - payload.size();
+            iov.push_back({&b->header, sizeof(pipeline_batch_header)});
+            iov.push_back({const_cast<char*>(payload.data()), payload.size()});
+            if (padding) iov.push_back({const_cast<char*>(zeros), padding});
+            bytes += sizeof(pipeline_batch_header) + payload.size() + padding;
+            io_metrics_.bytes_in += b->data.size();
+         }
+         if (error() == pipeline_error::none && !write_all(iov)) fail(pipeline_error::io_error);
+         io_metrics_.batches += gathered.size();
+         io_metrics_.bytes_out += bytes;
+
+         for (pipeline_batch* b : gathered) {
+            b->data.clear();
+            b->header = {};
+            (void)producers_[b->producer]->free_.try_push(b);
+         }
+         io_metrics_.busy_ns += detail::pipeline_now_ns() - t0;
+      }
+   }
+
+   // writev until every byte is written (IOV_MAX-sized chunks, partial writes resumed)
+   bool write_all(std::vector<iovec>& iov) {
+      size_t first = 0;
+      while (first < iov.size()) {
+         const int count = int(std::min<size_t>(iov.size() - first, 1024));
+         const ssize_t written = ::writev(fd_, iov.data() + first, count);
+         ++io_metrics_.calls;
+         if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+         }
+         size_t left = size_t(written);
+         while (first < iov.size() && left >= iov[first].iov_len) {
+            left -= iov[first].iov_len;
+            ++first;
+         }
+         if (left > 0) {
+            iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+            iov[first].iov_len -= left;
+         }
+      }
+      return true;
+   }
+
+   int fd_;
+   pipeline_options opts_;
+   std::vector<std::unique_ptr<pipeline_producer>> producers_;
+   spsc_ring<pipeline_batch*> to_compress_;
+   spsc_ring<pipeline_batch*> to_io_;
+
+   std::atomic<bool> producers_done_{false};
+   std::atomic<bool> checksum_done_{false};
+   std::atomic<bool> compress_done_{false};
+   std::atomic<pipeline_error> error_{pipeline_error::none};
+   bool finished_{false};
+
+   // Each written only by its stage thread; read after join
+   stage_metrics checksum_metrics_{};
+   stage_metrics compress_metrics_{};
+   stage_metrics io_metrics_{};
+
+   std::thread checksum_thread_;
+   std::thread compress_thread_;
+   std::thread io_thread_;
+};
+
+// ============================================================================
+// Producer Implementation
+// ============================================================================
+
+inline pipeline_producer::pipeline_producer(write_pipeline& pipeline, uint32_t index, size_t buffers,
+                                            size_t batch_bytes)
+   : pipeline_(&pipeline), free_(buffers), out_(buffers) {
+   pool_.reserve(buffers);
+   for (size_t i = 0; i < buffers; ++i) {
+      auto batch = std::make_unique<pipeline_batch>();
+      batch->producer = index;
+      // Room for the message that crosses batch_bytes
+      batch->data.reserve(batch_bytes + batch_bytes / 4);
+      (void)free_.try_push(batch.get());
+      pool_.push_back(std::move(batch));
+   }
+}
+
+inline void pipeline_producer::acquire() {
+   if (free_.try_pop(current_)) return;
+   const uint64_t t0 = detail::pipeline_now_ns();
+   uint32_t spins = 0;
+   // The I/O stage returns buffers even after an error, so this always ends
+   while (!free_.try_pop(current_)) detail::pipeline_backoff(spins);
+   ++metrics_.stalls;
+   metrics_.stalled_ns += detail::pipeline_now_ns() - t0;
+}
+
+inline bool pipeline_producer::append(std::string_view message) {
+   if (pipeline_->error() != pipeline_error::none) return false;
+   if (!current_) acquire();
+   current_->data.append(message);
+   current_->header.messages += 1;
+   ++metrics_.messages;
+   metrics_.bytes += message.size();
+   if (current_->data.size() >= pipeline_->opts_.batch_bytes) return flush();
+   return true;
+}
+
+inline bool pipeline_producer::flush() {
+   if (!current_ || current_->header.messages == 0) return true;
+   (void)out_.try_push(current_);
+   ++metrics_.batches;
+   current_ = nullptr;
+   return pipeline_->error() == pipeline_error::none;
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+// Calls `on_batch(std::string_view messages, uint64_t count)` with the concatenated
+// messages of every batch in a pipeline file, decompressing and verifying checksums.
+template <class OnBatch>
+pipeline_error read_pipeline_file(std::string_view file, OnBatch&& on_batch) {
+   std::string raw;
+   size_t pos = 0;
+   while (pos < file.size()) {
+      if (file.size() - pos < sizeof(pipeline_batch_header)) return pipeline_error::truncated;
+      pipeline_batch_header header;
+      std::memcpy(&header, file.data() + pos, sizeof(header));
+      if (std::memcmp(header.magic, pipeline_magic, 4) != 0) return pipeline_error::bad_magic;
+      pos += sizeof(header);
+      if (header.stored_size > file.size() - pos) return pipeline_error::truncated;
+      const std::string_view payload = file.substr(pos, size_t(header.stored_size));
+      pos += detail::padded_size_8(size_t(header.stored_size));
+
+      std::string_view messages = payload;
+      if (header.flags & pipeline_flag_compressed) {
+         block_reader reader{payload};
+         if (reader.error() != block_error::none) return pipeline_error::compress_error;
+         raw.clear();
+         for (size_t b = 0; b < reader.block_count(); ++b) {
+            const block_view block = reader.block(b);
+            if (block.bytes.empty()) return pipeline_error::compress_error;
+            raw.append(block.bytes);
+         }
+         messages = raw;
+      }
+      if (messages.size() != header.raw_size) return pipeline_error::truncated;
+      if ((header.flags & pipeline_flag_checksum) && crc32c(messages) != header.crc32c) {
+         return pipeline_error::checksum_mismatch;
+      }
+      on_batch(messages, header.messages);
+   }
+   return pipeline_error::none;
+}
+
+} // namespace zmem
@@ -0,0 +1,225 @@
+// ZMEM Write Pipeline Benchmark
+// Capture-to-disk throughput for Record messages: everything inline on one thread
+// (encode, CRC32C, optional compression, write per batch) against the staged writer in
+// zmem_pipeline.hpp with 1..N producers. Stage rows report busy time as a share of the
+// run; a stage near 100% is the bottleneck, and producer stall time is backpressure from
+// it. Every file is read back and verified.
+//
+// Usage: zmem_pipeline_bench [messages=2000000] [max_producers=4] [path=zmem_pipeline.bin]
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_fixtures.hpp"
+#include "zmem_pipeline.hpp"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+constexpr size_t record_pool = 4096; // Distinct messages, cycled through
+
+struct run_result {
+   double seconds{};
+   uint64_t messages{};
+   uint64_t raw_bytes{};
+   uint64_t file_bytes{};
+   zmem::pipeline_metrics metrics{};
+   bool pipelined{};
+};
+
+// The single-threaded path the pipeline replaces: batches are built, checksummed,
+// compressed and written by the encoding thread, in the same file format
+bool run_inline(int fd, const std::vector<Record>& records, size_t messages, const zmem::pipeline_options& opts,
+                run_result& result) {
+   zmem::pipeline_batch batch;
+   batch.data.reserve(opts.batch_bytes + opts.batch_bytes / 4);
+   std::string scratch;
+   static constexpr char zeros[8]{};
+
+   auto write_batch = [&] {
+      std::memcpy(batch.header.magic, zmem::pipeline_magic, 4);
+      batch.header.raw_size = batch.data.size();
+      batch.header.stored_size = batch.data.size();
+      batch.header.flags = zmem::pipeline_flag_checksum;
+      batch.header.crc32c = zmem::crc32c(batch.data);
+      if (opts.compress &&
+          zmem::compress_message_log(batch.data, batch.compressed, opts.compression) == zmem::block_error::none &&
+          batch.compressed.size() < batch.data.size()) {
+         batch.header.flags |= zmem::pipeline_flag_compressed;
+         batch.header.stored_size = batch.compressed.size();
+      }
+      const std::string_view payload = batch.payload();
+      iovec iov[3] = {{&batch.header, sizeof(batch.header)},
+                      {const_cast<char*>(payload.data()), payload.size()},
+                      {const_cast<char*>(zeros), zmem::detail::padded_size_8(payload.size()) - payload.size()}};
+      const size_t total = iov[0].iov_len + iov[1].iov_len + iov[2].iov_len;
+      if (::writev(fd, iov, 3) != ssize_t(total)) return false;
+      batch.data.clear();
+      batch.header = {};
+      return true;
+   };
+
+   const auto start = std::chrono::steady_clock::now();
+   for (size_t i = 0; i < messages; ++i) {
+      if (auto ec = glz::write_zmem(records[i % records.size()], scratch); ec) return false;
+      batch.data.append(scratch);
+      batch.header.messages += 1;
+      result.raw_bytes += scratch.size();
+      if (batch.data.size() >= opts.batch_bytes && !write_batch()) return false;
+   }
+   if (batch.header.messages > 0 && !write_batch()) return false;
+   result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   result.messages = messages;
+   return true;
+}
+
+bool run_pipelined(int fd, const std::vector<Record>& records, size_t messages, size_t producers,
+                   zmem::pipeline_options opts, run_result& result) {
+   opts.producers = producers;
+   // Producers on the first CPUs and the three stages after them, when there are enough
+   const bool pin = std::thread::hardware_concurrency() >= producers + 3;
+   if (pin) opts.stage_cpus = {int(producers), int(producers + 1), int(producers + 2)};
+
+   const auto start = std::chrono::steady_clock::now();
+   zmem::write_pipeline pipeline{fd, opts};
+   std::vector<std::thread> threads;
+   std::atomic<bool> encoded{true};
+   for (size_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p] {
+         if (pin) (void)zmem::pin_current_thread_to_cpu(uint32_t(p));
+         zmem::pipeline_producer& producer = pipeline.producer(p);
+         for (size_t i = p; i < messages; i += producers) {
+            if (!producer.write(records[i % records.size()])) {
+               encoded = false;
+               return;
+            }
+         }
+         producer.flush();
+      });
+   }
+   for (auto& t : threads) t.join();
+   const zmem::pipeline_error ec = pipeline.finish();
+   result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   result.metrics = pipeline.metrics();
+   result.messages = result.metrics.producers.messages;
+   result.raw_bytes = result.metrics.producers.bytes;
+   result.pipelined = true;
+   if (ec != zmem::pipeline_error::none) std::cerr << "Pipeline error " << uint32_t(ec) << "\n";
+   return encoded && ec == zmem::pipeline_error::none;
+}
+
+// Reads the file back: checksums, message count and raw size must match the run
+bool verify(const std::string& path, run_result& result) {
+   std::ifstream file(path, std::ios::binary);
+   std::stringstream contents;
+   contents << file.rdbuf();
+   const std::string bytes = contents.str();
+   result.file_bytes = bytes.size();
+
+   uint64_t messages = 0;
+   uint64_t raw_bytes = 0;
+   const zmem::pipeline_error ec = zmem::read_pipeline_file(bytes, [&](std::string_view batch, uint64_t count) {
+      messages += count;
+      raw_bytes += batch.size();
+   });
+   if (ec != zmem::pipeline_error::none || messages != result.messages || raw_bytes != result.raw_bytes) {
+      std::cerr << "Verification failed for " << path << " (error " << uint32_t(ec) << ", " << messages
+                << " messages)\n";
+      return false;
+   }
+   return true;
+}
+
+double percent(uint64_t ns, double seconds) { return seconds > 0 ? 100.0 * double(ns) / (seconds * 1e9) : 0.0; }
+
+void print_row(const char* mode, size_t producers, bool compress, const run_result& r) {
+   std::cout << "| " << mode << " | " << producers << " | " << (compress ? "yes" : "no") << " | "
+             << double(r.messages) / r.seconds / 1e6 << " | " << double(r.raw_bytes) / r.seconds / 1e6 << " | "
+             << double(r.file_bytes) / 1e6 << " | ";
+   if (r.pipelined) {
+      const auto& m = r.metrics;
+      const double producer_seconds = r.seconds * double(producers);
+      std::cout << percent(m.checksum.busy_ns, r.seconds) << "% | ";
+      if (compress) {
+         std::cout << percent(m.compress.busy_ns, r.seconds) << "% | ";
+      }
+      else {
+         std::cout << "- | ";
+      }
+      std::cout << percent(m.io.busy_ns, r.seconds) << "% | "
+                << (m.io.calls ? double(m.io.batches) / double(m.io.calls) : 0.0) << " | "
+                << percent(m.producers.stalled_ns, producer_seconds) << "% |\n";
+   }
+   else {
+      std::cout << "- | - | - | 1.00 | - |\n";
+   }
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t messages = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000);
+   const size_t max_producers = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4);
+   const std::string path = argc > 3 ? argv[3] : "zmem_pipeline.bin";
+
+   std::vector<Record> records;
+   records.reserve(record_pool);
+   for (size_t i = 0; i < record_pool; ++i) records.push_back(make_record(i));
+
+   std::cout << "ZMEM Write Pipeline Benchmark\n";
+   std::cout << "=============================\n\n";
+   std::cout << "Messages: " << messages << " Records, file: " << path << ", CRC32C: "
+             << zmem::checksum_isa_name(zmem::best_checksum_isa()) << "\n\n";
+   std::cout << std::fixed << std::setprecision(2);
+   std::cout << "| Mode | Producers | Compress | M msg/s | Raw MB/s | File MB | Checksum busy | Compress busy "
+                "| I/O busy | Batches/writev | Producer stalled |\n";
+   std::cout << "|------|-----------|----------|---------|----------|---------|---------------|---------------"
+                "|----------|----------------|------------------|\n";
+
+   for (const bool compress : {false, true}) {
+      zmem::pipeline_options opts;
+      opts.compress = compress;
+
+      auto run = [&](const char* mode, size_t producers) {
+         const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+         if (fd < 0) {
+            std::cerr << "Cannot open " << path << "\n";
+            return false;
+         }
+         run_result result;
+         const bool ok = producers == 0 ? run_inline(fd, records, messages, opts, result)
+                                        : run_pipelined(fd, records, messages, producers, opts, result);
+         ::close(fd);
+         if (!ok || !verify(path, result)) return false;
+         print_row(mode, std::max<size_t>(producers, 1), compress, result);
+         return true;
+      };
+
+      if (!run("Inline", 0)) return 1;
+      for (size_t producers = 1; producers <= max_producers; producers *= 2) {
+         if (!run("Pipeline", producers)) return 1;
+      }
+   }
+
+   std::remove(path.c_str());
+   return 0;
+}
@@ -0,0 +1,294 @@
+// ZMEM Prefetching Iteration
+// Iterators over `[VariableStruct]` vectors and message logs that issue software
+// prefetches for the size header and inline section of the element `distance`
+// steps ahead, hiding cache and TLB misses when element bodies are scattered.
+// The distance is fixed or auto-tuned from the measured time per element.
+//
+// Prefetches do not fault pages in: for cold mmap'd files combine with
+// map_advice::willneed or the async reader (zmem_async_reader.hpp).
+
+#pragma once
+
+#include "zmem_layout.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace zmem {
+
+struct prefetch_options {
+   uint32_t distance{8}; // Elements ahead; 0 disables prefetching
+   uint32_t bytes{64}; // Bytes prefetched per element: size header + inline section
+   bool auto_tune{false}; // Pick the distance from the first elements' timings
+};
+
+namespace detail {
+
+inline void prefetch_read(const char* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+   __builtin_prefetch(p, 0, 3);
+#elif defined(_MSC_VER)
+   _mm_prefetch(p, _MM_HINT_T0);
+#else
+   (void)p;
+#endif
+}
+
+inline void prefetch_lines(const char* p, uint32_t bytes) noexcept {
+   for (uint32_t b = 0; b < bytes; b += 64) prefetch_read(p + b);
+}
+
+// Tries each candidate distance on batches of elements (two rounds, best time kept)
+// and settles on the fastest. Timing covers the caller's loop body, so the chosen
+// distance reflects both miss latency and work per element.
+struct distance_tuner {
+   static constexpr uint32_t candidates[] = {0, 1, 2, 4, 8, 16, 32, 64};
+   static constexpr uint32_t candidate_count = sizeof(candidates) / sizeof(candidates[0]);
+   static constexpr uint32_t batch = 1024;
+   static constexpr uint32_t rounds = 2;
+
+   bool active{};
+   uint32_t trial{};
+   uint32_t counted{};
+   std::chrono::steady_clock::time_point batch_start{};
+   double best_ns[candidate_count]{};
+
+   // Returns the distance to use from now on
+   uint32_t start() noexcept {
+      active = true;
+      trial = 0;
+      counted = 0;
+      for (auto& t : best_ns) t = 0.0;
+      batch_start = std::chrono::steady_clock::now();
+      return candidates[0];
+   }
+
+   uint32_t step(uint32_t current) noexcept {
+      if (++counted < batch) return current;
+      counted = 0;
+      const auto now = std::chrono::steady_clock::now();
+      const double ns = std::chrono::duration<double, std::nano>(now - batch_start).count();
+      batch_start = now;
+      double& best = best_ns[trial % candidate_count];
+      if (best == 0.0 || ns < best) best = ns;
+      if (++trial < candidate_count * rounds) return candidates[trial % candidate_count];
+
+      active = false;
+      uint32_t chosen = 0;
+      for (uint32_t i = 1; i < candidate_count; ++i) {
+         if (best_ns[i] < best_ns[chosen]) chosen = i;
+      }
+      return candidates[chosen];
+   }
+};
+
+} // namespace detail
+
+// ============================================================================
+// [VariableStruct] Vectors
+// ============================================================================
+
+// Elements of a variable element vector field, in place (loaded or mmap'd message)
+class variable_vector_view {
+  public:
+   variable_vector_view() = default;
+   variable_vector_view(std::string_view message, const vector_field& field) noexcept {
+      vector_ref ref;
+      if (field.element_size != 0 || !read_vector_ref(message, field, ref)) return;
+      const uint64_t table = vector_data_begin(field, ref);
+      const uint64_t elements = table + (ref.count + 1) * 8;
+      if (elements > message.size()) return;
+      offsets_ = message.data() + table;
+      elements_ = message.data() + elements;
+      elements_size_ = message.size() - elements;
+      count_ = ref.count;
+   }
+
+   bool valid() const noexcept { return offsets_ != nullptr; }
+   uint64_t size() const noexcept { return count_; }
+
+   // Element `i` as a self-contained message for lazy_zmem_view; empty if corrupt
+   std::string_view operator[](uint64_t i) const noexcept {
+      const uint64_t begin = detail::load_u64(offsets_ + i * 8);
+      const uint64_t end = detail::load_u64(offsets_ + i * 8 + 8);
+      if (begin > end || end > elements_size_) return {};
+      return {elements_ + begin, size_t(end - begin)};
+   }
+
+   // Prefetches the start of element `i`. Loads its offset table entry, which sits in
+   // a sequential table the hardware prefetcher already covers.
+   void prefetch(uint64_t i, uint32_t bytes) const noexcept {
+      const uint64_t begin = detail::load_u64(offsets_ + i * 8);
+      if (begin < elements_size_) detail::prefetch_lines(elements_ + begin, bytes);
+   }
+
+   class scan_range;
+
+   // Iterates every element in order, or the elements listed in `indices` (gather;
+   // every index must be below size())
+   inline scan_range scan(const prefetch_options& opts = {}) const noexcept;
+   inline scan_range gather(const uint64_t* indices, size_t count, const prefetch_options& opts = {}) const noexcept;
+
+  private:
+   const char* offsets_{};
+   const char* elements_{};
+   uint64_t elements_size_{};
+   uint64_t count_{};
+};
+
+class variable_vector_view::scan_range {
+  public:
+   class iterator {
+     public:
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() = default;
+
+      std::string_view operator*() const noexcept { return range_->view_[range_->index(pos_)]; }
+
+      iterator& operator++() noexcept {
+         ++pos_;
+         range_->advance(pos_);
+         return *this;
+      }
+      void operator++(int) noexcept { ++*this; }
+
+      bool operator==(const iterator& other) const noexcept { return pos_ == other.pos_; }
+
+     private:
+      friend class scan_range;
+
+      iterator(scan_range* range, uint64_t pos) noexcept : range_(range), pos_(pos) {}
+
+      scan_range* range_{};
+      uint64_t pos_{};
+   };
+
+   scan_range(const variable_vector_view& view, const uint64_t* indices, uint64_t count,
+              const prefetch_options& opts) noexcept
+      : view_(view), indices_(indices), count_(count), opts_(opts) {}
+
+   iterator begin() noexcept {
+      distance_ = opts_.auto_tune ? tuner_.start() : opts_.distance;
+      for (uint64_t i = 0; i < distance_ && i < count_; ++i) view_.prefetch(index(i), opts_.bytes);
+      return {this, 0};
+   }
+   iterator end() noexcept { return {this, count_}; }
+
+   uint64_t size() const noexcept { return count_; }
+   // The distance in use (after auto-tuning: the one chosen)
+   uint32_t distance() const noexcept { return distance_; }
+
+  private:
+   uint64_t index(uint64_t pos) const noexcept { return indices_ ? indices_[pos] : pos; }
+
+   void advance(uint64_t pos) noexcept {
+      if (tuner_.active) distance_ = tuner_.step(distance_);
+      if (distance_ && pos + distance_ < count_) view_.prefetch(index(pos + distance_), opts_.bytes);
+   }
+
+   variable_vector_view view_{};
+   const uint64_t* indices_{};
+   uint64_t count_{};
+   prefetch_options opts_{};
+   uint32_t distance_{};
+   detail::distance_tuner tuner_{};
+};
+
+inline variable_vector_view::scan_range variable_vector_view::scan(const prefetch_options& opts) const noexcept {
+   return {*this, nullptr, count_, opts};
+}
+
+inline variable_vector_view::scan_range variable_vector_view::gather(const uint64_t* indices, size_t count,
+                                                                     const prefetch_options& opts) const noexcept {
+   return {*this, indices, count, opts};
+}
+
+// ============================================================================
+// Message Logs
+// ============================================================================
+
+// Back-to-back variable struct messages, each framed by its size header. Positions
+// are only known by walking the headers, so a lookahead cursor walks `distance`
+// messages ahead of the iterator and prefetches each message it reaches.
+class message_log_view {
+  public:
+   message_log_view() = default;
+   explicit message_log_view(std::string_view log) noexcept : log_(log) {}
+
+   class iterator {
+     public:
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+
+      iterator() = default;
+
+      std::string_view operator*() const noexcept { return log_.substr(pos_, size_t(length(pos_))); }
+
+      iterator& operator++() noexcept {
+         pos_ += length(pos_);
+         if (gap_ > 0) {
+            --gap_;
+         }
+         else {
+            ahead_ = pos_;
+         }
+         if (tuner_.active) distance_ = tuner_.step(distance_);
+         fill();
+         return *this;
+      }
+      void operator++(int) noexcept { ++*this; }
+
+      bool operator==(const iterator& other) const noexcept { return pos_ == other.pos_; }
+
+      uint32_t distance() const noexcept { return distance_; }
+
+     private:
+      friend class message_log_view;
+
+      iterator(std::string_view log, uint64_t pos, const prefetch_options& opts) noexcept
+         : log_(log), pos_(pos), ahead_(pos), bytes_(opts.bytes) {
+         distance_ = opts.auto_tune ? tuner_.start() : opts.distance;
+         fill();
+      }
+
+      // Message length including its size header, clamped to the log
+      uint64_t length(uint64_t pos) const noexcept {
+         if (log_.size() - pos < 8) return log_.size() - pos;
+         const uint64_t n = 8 + detail::load_u64(log_.data() + pos);
+         return n < 8 || n > log_.size() - pos ? log_.size() - pos : n;
+      }
+
+      // Keeps the cursor `distance_` messages ahead, prefetching each message it reaches
+      void fill() noexcept {
+         while (gap_ < distance_ && ahead_ < log_.size()) {
+            ahead_ += length(ahead_);
+            ++gap_;
+            if (ahead_ < log_.size()) detail::prefetch_lines(log_.data() + ahead_, bytes_);
+         }
+      }
+
+      std::string_view log_{};
+      uint64_t pos_{};
+      uint64_t ahead_{}; // Start of the message `gap_` messages after pos_
+      uint32_t gap_{};
+      uint32_t bytes_{};
+      uint32_t distance_{};
+      detail::distance_tuner tuner_{};
+   };
+
+   iterator begin(const prefetch_options& opts = {}) const noexcept { return {log_, 0, opts}; }
+   iterator end() const noexcept { return {log_, log_.size(), prefetch_options{0}}; }
+
+  private:
+   std::string_view log_{};
+};
+
+} // namespace zmem
@@ -0,0 +1,274 @@
+// ZMEM Projected Decode
+// read_zmem_fields<fields...>(value, buffer) decodes only the selected fields of a
+// variable struct message into a native object. Each field is located through the
+// inline section (zmem_struct_layout.hpp); the other fields' variable-section bytes are
+// never read, and their values in `value` are left as they were. This sits between
+// glz::read_zmem (decodes and allocates everything) and lazy_zmem_view (no ownership).
+//
+// Fields are selected by declaration index, as with lazy_zmem_view::get<I>(), and fields
+// of nested structs by a path of indices:
+//
+//    zmem::read_zmem_fields<5, zmem::path<0, 2>>(obj, buffer); // number, fixed_object.double_array
+//
+// A selected field may be any fixed type, a string, a vector of fixed types, strings or
+// variable structs, or a nested variable struct (decoded whole with glz::read_zmem).
+
+#pragma once
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_struct_layout.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace zmem {
+
+template <size_t... Indices>
+struct field_path {};
+
+template <size_t... Indices>
+inline constexpr field_path<Indices...> path{};
+
+namespace detail {
+
+// Fields the readers here decode themselves: everything zmem_struct_layout.hpp supports
+// except maps, vectors of maps and nested vectors, which only glz::read_zmem decodes
+template <class F>
+constexpr bool field_decodable() noexcept {
+   if constexpr (is_map_v<F>) {
+      return false;
+   }
+   else if constexpr (is_vector_v<F>) {
+      using E = typename F::value_type;
+      return !is_map_v<E> && !is_vector_v<E>;
+   }
+   else {
+      return true;
+   }
+}
+
+// Whether the field named by the path `First, Rest...` from T is decodable. Invalid
+// paths report true here and are rejected with their own message by decode_path.
+template <class T, size_t First, size_t... Rest>
+constexpr bool path_decodable() noexcept {
+   if constexpr (!is_struct_v<T> || First >= struct_layout<T>::count) {
+      return true;
+   }
+   else if constexpr (sizeof...(Rest) == 0) {
+      return field_decodable<field_type<T, First>>();
+   }
+   else {
+      return path_decodable<field_type<T, First>, Rest...>();
+   }
+}
+
+template <class T, auto Field>
+constexpr bool selection_decodable() noexcept {
+   if constexpr (std::is_integral_v<decltype(Field)>) {
+      return path_decodable<T, size_t(Field)>();
+   }
+   else {
+      return []<size_t... Indices>(field_path<Indices...>) {
+         return path_decodable<T, Indices...>();
+      }(Field);
+   }
+}
+
+// A struct being read: its self-contained message and inline base
+struct message_scope {
+   std::string_view message{};
+   uint64_t inline_base{};
+};
+
+// Bounds-checked view of a variable struct message, empty if truncated
+inline std::string_view framed_message(std::string_view bytes) noexcept {
+   if (bytes.size() < 8) return {};
+   uint64_t size;
+   std::memcpy(&size, bytes.data(), 8);
+   if (size > bytes.size() - 8) return {};
+   return bytes.substr(0, 8 + size);
+}
+
+// Reference at `at` whose target must hold `count * element_size` bytes; `data` is
+// its absolute position in the message
+inline bool read_reference(const message_scope& scope, uint64_t at, uint64_t element_size, uint64_t& data,
+                           uint64_t& count) noexcept {
+   if (at + 16 > scope.message.size()) return false;
+   uint64_t offset;
+   std::memcpy(&offset, scope.message.data() + at, 8);
+   std::memcpy(&count, scope.message.data() + at + 8, 8);
+   data = scope.inline_base + offset;
+   if (data > scope.message.size()) return false;
+   return element_size == 0 || count <= (scope.message.size() - data) / element_size;
+}
+
+// Nested variable struct referenced by the {offset} at `at`; empty message if invalid
+inline message_scope nested_scope(const message_scope& scope, uint64_t at, uint64_t inline_base) noexcept {
+   if (at + 8 > scope.message.size()) return {};
+   uint64_t offset;
+   std::memcpy(&offset, scope.message.data() + at, 8);
+   const uint64_t begin = scope.inline_base + offset;
+   if (begin > scope.message.size()) return {};
+   return {framed_message(scope.message.substr(begin)), inline_base};
+}
+
+// Fixed value at `p`, already bounds checked
+template <class F>
+void decode_fixed(F& target, const char* p) noexcept {
+   if constexpr (native_wire_layout<F>()) {
+      std::memcpy(&target, p, sizeof(F));
+   }
+   else if constexpr (is_std_array_v<F>) {
+      constexpr size_t stride = inline_layout<typename F::value_type>().size;
+      for (size_t i = 0; i < target.size(); ++i) decode_fixed(target[i], p + i * stride);
+   }
+   else if constexpr (is_optional_v<F>) {
+      using V = typename F::value_type;
+      if (p[0]) {
+         decode_fixed(target.emplace(), p + inline_layout<V>().align);
+      }
+      else {
+         target.reset();
+      }
+   }
+   else {
+      static_assert(is_struct_v<F> && !struct_layout<F>::variable, "decode_fixed needs a fixed type");
+      [&]<size_t... I>(std::index_sequence<I...>) {
+         (decode_fixed(field<I>(target), p + struct_layout<F>::offsets[I]), ...);
+      }(std::make_index_sequence<struct_layout<F>::count>{});
+   }
+}
+
+// Elements of a vector of variable elements: offset table then elements
+template <class OnElement>
+bool for_each_variable_element(const message_scope& scope, uint64_t data, uint64_t count, OnElement&& on_element) {
+   const uint64_t elements = data + (count + 1) * 8;
+   if (count > (scope.message.size() - data) / 8 || elements > scope.message.size()) return false;
+   const char* table = scope.message.data() + data;
+   for (uint64_t i = 0; i < count; ++i) {
+      uint64_t begin, end;
+      std::memcpy(&begin, table + i * 8, 8);
+      std::memcpy(&end, table + i * 8 + 8, 8);
+      if (begin > end || end > scope.message.size() - elements) return false;
+      if (!on_element(i, scope.message.substr(elements + begin, end - begin))) return false;
+   }
+   return true;
+}
+
+// Field of type F whose inline bytes start at `at`
+template <class F>
+bool decode_field(F& target, const message_scope& scope, uint64_t at) {
+   constexpr wire_layout layout = inline_layout<F>();
+   static_assert(layout.supported, "field type is not supported by read_zmem_fields");
+
+   if constexpr (!layout.variable) {
+      if (at + layout.size > scope.message.size()) return false;
+      decode_fixed(target, scope.message.data() + at);
+      return true;
+   }
+   else if constexpr (is_string_v<F>) {
+      uint64_t data, length;
+      if (!read_reference(scope, at, 1, data, length)) return false;
+      target.assign(scope.message.data() + data, length);
+      return true;
+   }
+   else if constexpr (is_vector_v<F>) {
+      using E = typename F::value_type;
+      constexpr wire_layout element = inline_layout<E>();
+      uint64_t data, count;
+      if constexpr (!element.variable) {
+         if (!read_reference(scope, at, element.size, data, count)) return false;
+         target.resize(count);
+         if constexpr (native_wire_stride<E>()) {
+            if (count) std::memcpy(target.data(), scope.message.data() + data, count * sizeof(E));
+         }
+         else {
+            const char* p = scope.message.data() + data;
+            for (uint64_t i = 0; i < count; ++i) decode_fixed(target[i], p + i * element.size);
+         }
+         return true;
+      }
+      else if constexpr (is_string_v<E> || is_variable_struct<E>()) {
+         if (!read_reference(scope, at, 0, data, count)) return false;
+         target.resize(count);
+         return for_each_variable_element(scope, data, count, [&](uint64_t i, std::string_view bytes) {
+            if constexpr (is_string_v<E>) {
+               target[i].assign(bytes.data(), bytes.size());
+               return true;
+            }
+            else {
+               return !glz::read_zmem(target[i], bytes);
+            }
+         });
+      }
+      else {
+         static_assert(!sizeof(E), "read_zmem_fields cannot project nested vectors or vectors of maps");
+      }
+   }
+   else if constexpr (is_struct_v<F>) {
+      const message_scope nested = nested_scope(scope, at, struct_layout<F>::inline_base);
+      return !nested.message.empty() && !glz::read_zmem(target, nested.message);
+   }
+   else {
+      static_assert(!sizeof(F), "read_zmem_fields cannot project maps");
+   }
+}
+
+// Follows `First, Rest...` from the struct whose inline bytes start at `at`
+template <size_t First, size_t... Rest, class T>
+bool decode_path(T& value, const message_scope& scope, uint64_t at) {
+   static_assert(First < struct_layout<T>::count, "field index out of range");
+   using F = field_type<T, First>;
+   const uint64_t field_at = at + struct_layout<T>::offsets[First];
+   if constexpr (sizeof...(Rest) == 0) {
+      return decode_field(field<First>(value), scope, field_at);
+   }
+   else {
+      static_assert(is_struct_v<F>, "only struct fields have nested fields");
+      if constexpr (struct_layout<F>::variable) {
+         const message_scope nested = nested_scope(scope, field_at, struct_layout<F>::inline_base);
+         if (nested.message.empty()) return false;
+         return decode_path<Rest...>(field<First>(value), nested, nested.inline_base);
+      }
+      else {
+         return decode_path<Rest...>(field<First>(value), scope, field_at);
+      }
+   }
+}
+
+template <size_t... Indices, class T>
+bool decode_selected(T& value, const message_scope& scope, field_path<Indices...>) {
+   return decode_path<Indices...>(value, scope, scope.inline_base);
+}
+
+template <auto Field, class T>
+bool decode_selected(T& value, const message_scope& scope) {
+   if constexpr (std::is_integral_v<decltype(Field)>) {
+      return decode_path<size_t(Field)>(value, scope, scope.inline_base);
+   }
+   else {
+      return decode_selected(value, scope, Field);
+   }
+}
+
+} // namespace detail
+
+// Decodes the selected fields (indices or zmem::path<...>) of the variable struct
+// message at the start of `buffer` into `value`. Returns false if the message is
+// truncated or a selected field's references point outside it; fields decoded before
+// the failure keep their new values.
+template <auto... Fields, class T>
+bool read_zmem_fields(T& value, std::string_view buffer) {
+   static_assert(struct_layout<T>::variable, "fixed structs are read with a single memcpy");
+   static_assert(struct_layout<T>::supported, "T has a field type not supported by zmem_struct_layout.hpp");
+   static_assert((detail::selection_decodable<T, Fields>() && ...),
+                 "read_zmem_fields cannot project maps, vectors of maps or nested vectors: use glz::read_zmem");
+   const detail::message_scope scope{detail::framed_message(buffer), struct_layout<T>::inline_base};
+   if (scope.message.empty()) return false;
+   return (detail::decode_selected<Fields>(value, scope) && ...);
+}
+
+} // namespace zmem
@@ -0,0 +1,261 @@
+// ZMEM Projected Decode Benchmark
+// zmem::read_zmem_fields (zmem_projection.hpp) against a full glz::read_zmem and
+// against lazy_zmem_view copies of the same fields, for TestObj and a wide 12-field
+// order message. Every operation decodes into a fresh object, as a consumer that keeps
+// the native values would, so allocation counts include every string and vector built.
+// Projected fields are checked against the full decode before timing, including every
+// field of the game world entities (zmem_workloads.hpp), whose nested fixed structs have
+// a size that is not a multiple of 8.
+//
+// Usage: zmem_projection_bench [iterations=1000000]
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_alloc_counter.hpp"
+#include "zmem_fixtures.hpp"
+#include "zmem_projection.hpp"
+#include "zmem_workloads.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Test Data Structures
+// ============================================================================
+
+struct WideOrder {
+   uint64_t id{};
+   uint64_t timestamp{};
+   double price{};
+   double quantity{};
+   std::string symbol{};
+   std::string venue{};
+   std::string trader{};
+   std::string notes{};
+   std::vector<std::string> tags{};
+   std::vector<double> fill_prices{};
+   std::vector<int32_t> fill_sizes{};
+   uint32_t flags{};
+};
+
+// ============================================================================
+// Test Data Initialization
+// ============================================================================
+
+WideOrder make_wide_order() {
+   WideOrder o;
+   o.id = 918273645;
+   o.timestamp = 1'700'000'000'123'456'789ull;
+   o.price = 101.25;
+   o.quantity = 2500.0;
+   o.symbol = "ACME.NASDAQ";
+   o.venue = "XNAS-primary-matching-engine-7";
+   o.trader = "desk-42/algo-vwap-participation-v3";
+   o.notes = "Client instructions: work passively until 15:30, then cross the spread if behind schedule";
+   o.tags = {"vwap", "passive", "client-337", "region-us-east", "priority-normal", "reviewed"};
+   for (int i = 0; i < 32; ++i) {
+      o.fill_prices.push_back(101.0 + 0.01 * i);
+      o.fill_sizes.push_back(100 + i * 5);
+   }
+   o.flags = 0x15;
+   return o;
+}
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+struct bench_result {
+   double ns{};
+   double allocations{}; // Operator new calls per operation, after warmup
+};
+
+template <typename Func>
+bench_result benchmark(Func&& func, size_t iterations) {
+   // Warmup
+   for (size_t i = 0; i < iterations / 10 + 1; ++i) {
+      func();
+   }
+
+   const zmem::allocation_stats before = zmem::thread_allocations();
+   auto start = std::chrono::high_resolution_clock::now();
+   for (size_t i = 0; i < iterations; ++i) {
+      func();
+   }
+   auto end = std::chrono::high_resolution_clock::now();
+   const zmem::allocation_stats allocated = zmem::thread_allocations() - before;
+
+   auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+   return {static_cast<double>(duration.count()) / static_cast<double>(iterations),
+           static_cast<double>(allocated.allocations) / static_cast<double>(iterations)};
+}
+
+void print_row(const char* message, const char* fields, const char* operation, const bench_result& r,
+               const bench_result& full) {
+   std::cout << "| " << message << " | " << fields << " | " << operation << " | " << r.ns << " | "
+             << r.allocations << " | " << 100.0 * (1.0 - r.ns / full.ns) << "% |\n";
+}
+
+template <class T>
+bool serialize(const T& value, std::string& buffer) {
+   if (auto ec = glz::write_zmem(value, buffer); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, buffer) << "\n";
+      return false;
+   }
+   return true;
+}
+
+bool fail(const char* what) {
+   std::cerr << "Projected decode disagrees with read_zmem: " << what << "\n";
+   return false;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t iterations = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000);
+
+   std::string test_buffer;
+   std::string wide_buffer;
+   if (!serialize(create_test_data(), test_buffer) || !serialize(make_wide_order(), wide_buffer)) return 1;
+
+   // Projections must match the full decode
+   {
+      TestObj full{};
+      TestObj projected{};
+      if (glz::read_zmem(full, test_buffer) ||
+          !zmem::read_zmem_fields<5, zmem::path<0, 2>>(projected, test_buffer)) {
+         return fail("TestObj read");
+      }
+      if (projected.number != full.number || projected.fixed_object.double_array != full.fixed_object.double_array ||
+          !projected.string.empty()) {
+         return fail("TestObj number, fixed_object.double_array");
+      }
+      WideOrder wide{};
+      WideOrder wide_projected{};
+      if (glz::read_zmem(wide, wide_buffer) || !zmem::read_zmem_fields<0, 2, 4, 8, 9>(wide_projected, wide_buffer)) {
+         return fail("WideOrder read");
+      }
+      if (wide_projected.id != wide.id || wide_projected.price != wide.price || wide_projected.symbol != wide.symbol ||
+          wide_projected.tags != wide.tags || wide_projected.fill_prices != wide.fill_prices) {
+         return fail("WideOrder id, price, symbol, tags, fill_prices");
+      }
+      std::string entity_buffer;
+      for (const workloads::Entity& entity : workloads::make_world_snapshot(64).entities) {
+         if (!serialize(entity, entity_buffer)) return 1;
+         workloads::Entity full_entity{};
+         workloads::Entity projected_entity{};
+         workloads::Entity rotation{};
+         if (glz::read_zmem(full_entity, entity_buffer) ||
+             !zmem::read_zmem_fields<0, 1, 2, 3, 4, 5, 6, 7, 8, 9>(projected_entity, entity_buffer) ||
+             !zmem::read_zmem_fields<zmem::path<5, 1>>(rotation, entity_buffer)) {
+            return fail("Entity read");
+         }
+         if (!(projected_entity == full_entity) || !(rotation.transform.rotation == full_entity.transform.rotation)) {
+            return fail("Entity, all fields and transform.rotation");
+         }
+      }
+   }
+
+   std::cout << "ZMEM Projected Decode Benchmark\n";
+   std::cout << "===============================\n\n";
+   std::cout << "Iterations: " << iterations << ", TestObj " << test_buffer.size() << " bytes, WideOrder "
+             << wide_buffer.size() << " bytes\n";
+   std::cout << "Each operation decodes into a fresh object. Saved = time saved against the full read_zmem.\n\n";
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "| Message | Fields | Operation | Time (ns) | Allocs/op | Saved |\n";
+   std::cout << "|---------|--------|-----------|-----------|-----------|-------|\n";
+
+   double sink = 0.0;
+
+   // TestObj: number and fixed_object.double_array
+   {
+      const bench_result full = benchmark([&] {
+         TestObj obj{};
+         (void)glz::read_zmem(obj, test_buffer);
+         sink += obj.number + double(obj.fixed_object.double_array.size());
+      }, iterations);
+      print_row("TestObj", "all", "read_zmem", full, full);
+
+      const bench_result projected = benchmark([&] {
+         TestObj obj{};
+         (void)zmem::read_zmem_fields<5, zmem::path<0, 2>>(obj, test_buffer);
+         sink += obj.number + double(obj.fixed_object.double_array.size());
+      }, iterations);
+      print_row("TestObj", "number, fixed_object.double_array", "read_zmem_fields", projected, full);
+
+      const bench_result scalar = benchmark([&] {
+         TestObj obj{};
+         (void)zmem::read_zmem_fields<5>(obj, test_buffer);
+         sink += obj.number;
+      }, iterations);
+      print_row("TestObj", "number", "read_zmem_fields", scalar, full);
+
+      const bench_result lazy = benchmark([&] {
+         TestObj obj{};
+         glz::lazy_zmem_view<TestObj> view{test_buffer};
+         obj.number = view.get<5>();
+         obj.string = std::string(view.get<4>());
+         sink += obj.number + double(obj.string.size());
+      }, iterations);
+      print_row("TestObj", "number, string", "lazy_zmem_view + copy", lazy, full);
+
+      const bench_result projected_string = benchmark([&] {
+         TestObj obj{};
+         (void)zmem::read_zmem_fields<5, 4>(obj, test_buffer);
+         sink += obj.number + double(obj.string.size());
+      }, iterations);
+      print_row("TestObj", "number, string", "read_zmem_fields", projected_string, full);
+   }
+
+   // WideOrder: the columns a risk check needs
+   {
+      const bench_result full = benchmark([&] {
+         WideOrder order{};
+         (void)glz::read_zmem(order, wide_buffer);
+         sink += order.price + double(order.symbol.size());
+      }, iterations);
+      print_row("WideOrder", "all", "read_zmem", full, full);
+
+      const bench_result scalars = benchmark([&] {
+         WideOrder order{};
+         (void)zmem::read_zmem_fields<0, 2, 3>(order, wide_buffer);
+         sink += order.price * order.quantity + double(order.id);
+      }, iterations);
+      print_row("WideOrder", "id, price, quantity", "read_zmem_fields", scalars, full);
+
+      const bench_result lazy = benchmark([&] {
+         WideOrder order{};
+         glz::lazy_zmem_view<WideOrder> view{wide_buffer};
+         order.id = view.get<0>();
+         order.price = view.get<2>();
+         order.symbol = std::string(view.get<4>());
+         sink += order.price + double(order.symbol.size() + order.id);
+      }, iterations);
+      print_row("WideOrder", "id, price, symbol", "lazy_zmem_view + copy", lazy, full);
+
+      const bench_result mixed = benchmark([&] {
+         WideOrder order{};
+         (void)zmem::read_zmem_fields<0, 2, 4>(order, wide_buffer);
+         sink += order.price + double(order.symbol.size() + order.id);
+      }, iterations);
+      print_row("WideOrder", "id, price, symbol", "read_zmem_fields", mixed, full);
+
+      const bench_result vectors = benchmark([&] {
+         WideOrder order{};
+         (void)zmem::read_zmem_fields<0, 2, 4, 8, 9>(order, wide_buffer);
+         sink += order.price + double(order.tags.size() + order.fill_prices.size());
+      }, iterations);
+      print_row("WideOrder", "id, price, symbol, tags, fill_prices", "read_zmem_fields", vectors, full);
+   }
+
+   std::cout << "\nChecksum: " << static_cast<uint64_t>(sink) << "\n";
+   return 0;
+}
@@ -0,0 +1,220 @@
+// ZMEM Benchmark Reports
+// Machine-readable results (JSON through Glaze) with the provenance needed to compare
+// two runs: build flags, revisions, CPU model. Each operation keeps the mean of every
+// repeated run so a comparison can put a confidence interval on the difference.
+
+#pragma once
+
+#include "glaze/json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/utsname.h>
+#endif
+
+// Set by CMakeLists.txt
+#ifndef ZMEM_BENCH_GIT_REVISION
+#define ZMEM_BENCH_GIT_REVISION "unknown"
+#endif
+#ifndef ZMEM_BENCH_GLAZE_REVISION
+#define ZMEM_BENCH_GLAZE_REVISION "unknown"
+#endif
+#ifndef ZMEM_BENCH_CXX_FLAGS
+#define ZMEM_BENCH_CXX_FLAGS "unknown"
+#endif
+#ifndef ZMEM_BENCH_BUILD_TYPE
+#define ZMEM_BENCH_BUILD_TYPE "unknown"
+#endif
+
+namespace zmem {
+
+// ============================================================================
+// Report Structure
+// ============================================================================
+
+struct build_info {
+   std::string compiler{};
+   std::string flags{};
+   std::string build_type{};
+   std::string revision{}; // This repository
+   std::string glaze_revision{};
+};
+
+struct machine_info {
+   std::string cpu_model{};
+   uint32_t hardware_threads{};
+   std::string kernel{};
+};
+
+struct operation_report {
+   std::string name{};
+   uint64_t bytes{}; // Serialized message size
+   std::vector<double> runs_ns{}; // Mean ns per operation, one entry per repeated run
+   double allocations_per_op{};
+   double allocated_bytes_per_op{};
+   uint64_t p50_ns{};
+   uint64_t p90_ns{};
+   uint64_t p99_ns{};
+   uint64_t p999_ns{};
+   uint64_t max_ns{};
+};
+
+struct benchmark_report {
+   std::string benchmark{};
+   std::string timestamp{}; // UTC, ISO 8601
+   build_info build{};
+   machine_info machine{};
+   uint64_t iterations{}; // Per run
+   std::vector<operation_report> operations{};
+};
+
+inline build_info current_build() {
+   build_info info;
+#if defined(__clang__)
+   info.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+   info.compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+   info.compiler = "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+   info.compiler = "unknown";
+#endif
+   info.flags = ZMEM_BENCH_CXX_FLAGS;
+   info.build_type = ZMEM_BENCH_BUILD_TYPE;
+   info.revision = ZMEM_BENCH_GIT_REVISION;
+   info.glaze_revision = ZMEM_BENCH_GLAZE_REVISION;
+   return info;
+}
+
+inline machine_info current_machine() {
+   machine_info info;
+   info.cpu_model = "unknown";
+   info.hardware_threads = std::thread::hardware_concurrency();
+   std::ifstream cpuinfo("/proc/cpuinfo");
+   for (std::string line; std::getline(cpuinfo, line);) {
+      if (line.rfind("model name", 0) == 0) {
+         const size_t colon = line.find(':');
+         if (colon != std::string::npos && colon + 2 <= line.size()) info.cpu_model = line.substr(colon + 2);
+         break;
+      }
+   }
+#if defined(__linux__) || defined(__APPLE__)
+   utsname name{};
+   if (::uname(&name) == 0) info.kernel = std::string(name.sysname) + " " + name.release;
+#endif
+   return info;
+}
+
+inline std::string utc_timestamp() {
+   const std::time_t now = std::time(nullptr);
+   std::tm utc{};
+#if defined(_WIN32)
+   gmtime_s(&utc, &now);
+#else
+   gmtime_r(&now, &utc);
+#endif
+   char buffer[32];
+   std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &utc);
+   return buffer;
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+// Two-sided 95% critical value of Student's t with `df` degrees of freedom
+inline double t_critical_95(double df) noexcept {
+   static constexpr double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                      2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                      2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+   if (!(df >= 1.0)) return table[0];
+   if (df <= 30.0) return table[size_t(df) - 1];
+   return 1.960 + 2.37 / df; // Within 0.002 of the exact value above 30
+}
+
+struct sample_stats {
+   size_t n{};
+   double mean{};
+   double variance{}; // Sample (n - 1) variance
+};
+
+inline sample_stats compute_stats(const std::vector<double>& samples) noexcept {
+   sample_stats s;
+   s.n = samples.size();
+   if (s.n == 0) return s;
+   for (const double x : samples) s.mean += x;
+   s.mean /= double(s.n);
+   if (s.n > 1) {
+      for (const double x : samples) s.variance += (x - s.mean) * (x - s.mean);
+      s.variance /= double(s.n - 1);
+   }
+   return s;
+}
+
+struct difference_interval {
+   double change{}; // (candidate - baseline) / baseline
+   double low{}; // 95% confidence bounds on `change`
+   double high{};
+   bool valid{}; // Needs at least two runs on each side
+};
+
+// Welch's interval on the difference of means (unequal variances), relative to the baseline mean
+inline difference_interval compare_samples(const std::vector<double>& baseline, const std::vector<double>& candidate) {
+   const sample_stats a = compute_stats(baseline);
+   const sample_stats b = compute_stats(candidate);
+   difference_interval d;
+   if (a.n == 0 || b.n == 0 || a.mean <= 0.0) return d;
+   d.change = (b.mean - a.mean) / a.mean;
+   d.low = d.high = d.change;
+   if (a.n < 2 || b.n < 2) return d;
+
+   const double va = a.variance / double(a.n);
+   const double vb = b.variance / double(b.n);
+   const double se = std::sqrt(va + vb);
+   double df = 1.0;
+   if (va + vb > 0.0) {
+      df = (va + vb) * (va + vb) / (va * va / double(a.n - 1) + vb * vb / double(b.n - 1));
+   }
+   const double margin = t_critical_95(std::floor(df)) * se / a.mean;
+   d.low = d.change - margin;
+   d.high = d.change + margin;
+   d.valid = true;
+   return d;
+}
+
+// ============================================================================
+// File I/O
+// ============================================================================
+
+// Returns an empty string on success, else the error message
+inline std::string save_report(const benchmark_report& report, const std::string& path) {
+   std::string json;
+   if (auto ec = glz::write<glz::opts{.prettify = true}>(report, json); ec) {
+      return glz::format_error(ec, json);
+   }
+   std::ofstream out(path, std::ios::binary);
+   if (!out.write(json.data(), std::streamsize(json.size()))) return "cannot write " + path;
+   return {};
+}
+
+inline std::string load_report(benchmark_report& report, const std::string& path) {
+   std::ifstream in(path, std::ios::binary);
+   if (!in) return "cannot open " + path;
+   const std::string json{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+   if (auto ec = glz::read_json(report, json); ec) {
+      return path + ": " + glz::format_error(ec, json);
+   }
+   return {};
+}
+
+} // namespace zmem
@@ -0,0 +1,183 @@
+// ZMEM Bandwidth Roofline
+// memcpy, streaming read, memset and non-temporal write bandwidth of this machine
+// (zmem_bandwidth.hpp), and write_zmem / read_zmem / zero-copy scan throughput as a
+// percentage of it, for a cache-resident and a DRAM-sized message. Writes are measured
+// against the faster of memset and the non-temporal write, reads against the stream read.
+//
+// Usage: zmem_roofline_bench [size_mb=512] [repetitions=5]
+//
+// Peak memory is roughly 4x size_mb (source object, two output buffers, decoded copy).
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_bandwidth.hpp"
+#include "zmem_fixtures.hpp"
+#include "zmem_layout.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Roofline
+// ============================================================================
+
+struct roofline {
+   double memcpy_gb_s{};
+   double read_gb_s{};
+   double memset_gb_s{};
+   double write_nt_gb_s{};
+
+   // Best way this machine has to produce new bytes
+   double write_gb_s() const noexcept { return std::max(memset_gb_s, write_nt_gb_s); }
+};
+
+roofline measure_roofline(size_t bytes, size_t repetitions, uint64_t& checksum) {
+   std::vector<char> source(bytes, 1);
+   std::vector<char> destination(bytes);
+   roofline r;
+   r.memcpy_gb_s = zmem::best_gb_per_s([&] { std::memcpy(destination.data(), source.data(), bytes); }, bytes,
+                                       repetitions);
+   r.read_gb_s = zmem::best_gb_per_s([&] { checksum += zmem::stream_read(source.data(), bytes); }, bytes,
+                                     repetitions);
+   r.memset_gb_s = zmem::best_gb_per_s([&] { std::memset(destination.data(), 3, bytes); }, bytes, repetitions);
+   r.write_nt_gb_s = zmem::best_gb_per_s([&] { zmem::stream_write_nt(destination.data(), bytes, 2); }, bytes,
+                                         repetitions);
+   checksum += uint8_t(destination[bytes / 2]);
+   return r;
+}
+
+// ============================================================================
+// ZMEM Operations
+// ============================================================================
+
+constexpr zmem::vector_field doubles_field{0, sizeof(double)};
+
+std::string size_label(size_t bytes) {
+   if (bytes >= (size_t(1) << 20)) return std::to_string(bytes >> 20) + " MB";
+   return std::to_string(bytes >> 10) + " KB";
+}
+
+// Writes are bounded by the write roof, reads and scans by the stream read
+enum class bound : uint32_t { write, read };
+
+void print_row(const std::string& size, const char* shape, const char* operation, double gb_s,
+               const roofline& limit, bound roof) {
+   const double roof_gb_s = roof == bound::write ? limit.write_gb_s() : limit.read_gb_s;
+   std::cout << "| " << size << " | " << shape << " | " << operation << " | " << gb_s << " | "
+             << 100.0 * gb_s / limit.memcpy_gb_s << " | " << 100.0 * gb_s / roof_gb_s << " | "
+             << (roof == bound::write ? "write" : "stream read") << " |\n";
+}
+
+// Write, preallocated write and read throughput over the serialized size
+template <class T>
+bool run_shape(const char* shape, const T& value, const std::string& size, const roofline& limit,
+               size_t repetitions) {
+   std::string buffer;
+   if (auto ec = glz::write_zmem(value, buffer); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, buffer) << "\n";
+      return false;
+   }
+   const size_t bytes = buffer.size();
+
+   std::string write_buffer;
+   print_row(size, shape, "write_zmem",
+             zmem::best_gb_per_s([&] { (void)glz::write_zmem(value, write_buffer); }, bytes, repetitions), limit,
+             bound::write);
+
+   std::string prealloc_buffer;
+   print_row(size, shape, "write_zmem_preallocated",
+             zmem::best_gb_per_s([&] { (void)glz::write_zmem_preallocated(value, prealloc_buffer); }, bytes,
+                                 repetitions),
+             limit, bound::write);
+
+   T decoded{};
+   print_row(size, shape, "read_zmem",
+             zmem::best_gb_per_s([&] { (void)glz::read_zmem(decoded, buffer); }, bytes, repetitions), limit,
+             bound::read);
+   return true;
+}
+
+// Sum of the doubles vector read in place: the zero-copy equivalent of a streaming read
+void run_zero_copy_scan(const VectorShape& value, const std::string& size, const roofline& limit,
+                        size_t repetitions, uint64_t& checksum) {
+   std::string buffer;
+   (void)glz::write_zmem(value, buffer);
+   zmem::vector_ref ref;
+   if (!zmem::read_vector_ref(buffer, doubles_field, ref)) return;
+   const char* data = buffer.data() + zmem::vector_data_begin(doubles_field, ref);
+   const size_t bytes = ref.count * sizeof(double);
+
+   double sum = 0.0;
+   const double gb_s = zmem::best_gb_per_s(
+      [&] {
+         double a = 0.0, b = 0.0, c = 0.0, d = 0.0;
+         uint64_t i = 0;
+         for (; i + 4 <= ref.count; i += 4) {
+            double v[4];
+            std::memcpy(v, data + i * 8, 32);
+            a += v[0];
+            b += v[1];
+            c += v[2];
+            d += v[3];
+         }
+         for (; i < ref.count; ++i) {
+            double v;
+            std::memcpy(&v, data + i * 8, 8);
+            a += v;
+         }
+         sum += a + b + c + d;
+      },
+      bytes, repetitions);
+   checksum += static_cast<uint64_t>(sum);
+   print_row(size, "Vector-heavy (doubles)", "zero-copy scan", gb_s, limit, bound::read);
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t size_mb = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512);
+   const size_t repetitions = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5);
+
+   // Cache-resident on most CPUs, then large enough to stream from DRAM
+   const std::vector<size_t> sizes{size_t(256) << 10, size_mb << 20};
+
+   std::cout << "ZMEM Bandwidth Roofline\n";
+   std::cout << "=======================\n\n";
+   std::cout << "Best of " << repetitions << " timings, GB/s = 10^9 bytes of message per second\n\n";
+   std::cout << std::fixed << std::setprecision(1);
+
+   uint64_t checksum = 0;
+   std::vector<roofline> limits;
+   std::cout << "| Size | memcpy (GB/s) | Stream read (GB/s) | memset (GB/s) | Non-temporal write (GB/s) |\n";
+   std::cout << "|------|---------------|--------------------|---------------|---------------------------|\n";
+   for (const size_t bytes : sizes) {
+      limits.push_back(measure_roofline(bytes, repetitions, checksum));
+      const roofline& r = limits.back();
+      std::cout << "| " << size_label(bytes) << " | " << r.memcpy_gb_s << " | " << r.read_gb_s << " | " << r.memset_gb_s
+                << " | " << r.write_nt_gb_s << " |\n";
+   }
+
+   std::cout << "\n| Size | Shape | Operation | GB/s | % of memcpy | % of roof | Roof |\n";
+   std::cout << "|------|-------|-----------|------|-------------|-----------|------|\n";
+   for (size_t s = 0; s < sizes.size(); ++s) {
+      const std::string size = size_label(sizes[s]);
+      bool ok = run_shape("Fixed structs [Tick]", make_fixed_shape(sizes[s]), size, limits[s], repetitions);
+      {
+         const VectorShape vectors = make_vector_shape(sizes[s]);
+         ok = ok && run_shape("Vector-heavy", vectors, size, limits[s], repetitions);
+         run_zero_copy_scan(vectors, size, limits[s], repetitions, checksum);
+      }
+      ok = ok && run_shape("[VariableStruct] (Record)", make_dataset(sizes[s]), size, limits[s], repetitions);
+      if (!ok) return 1;
+   }
+
+   std::cout << "\nChecksum: " << checksum << "\n";
+   return 0;
+}
@@ -0,0 +1,184 @@
+// ZMEM Thread Scaling Benchmark
+// Aggregate write_zmem, read_zmem and lazy-view throughput on 1..N threads, with
+// each thread using a private copy of the source or all threads sharing one.
+// Reads into a fresh TestObj allocate its strings and vectors on every call;
+// reads into a reused one do not, so the gap between them is malloc contention.
+//
+// Usage: zmem_scaling_bench [max_threads=hardware_concurrency] [ms_per_run=500]
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_alloc_counter.hpp"
+#include "zmem_fixtures.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+enum class operation { write, read_fresh, read_reused, lazy_view };
+
+const char* operation_name(operation op) {
+   switch (op) {
+      case operation::write: return "write_zmem";
+      case operation::read_fresh: return "read_zmem (fresh object)";
+      case operation::read_reused: return "read_zmem (reused object)";
+      case operation::lazy_view: return "lazy_zmem_view";
+   }
+   return "?";
+}
+
+struct alignas(64) thread_result {
+   uint64_t ops{};
+   uint64_t allocations{};
+   uint64_t checksum{};
+};
+
+struct scaling_result {
+   double ops_per_s{};
+   double allocations_per_op{};
+   uint64_t checksum{};
+};
+
+struct shared_source {
+   TestObj obj{};
+   std::string buffer{};
+};
+
+// Runs `op` on `threads` threads for `duration`. Private sources are copied by each
+// thread before the clock starts.
+scaling_result run_scaling(operation op, bool shared, size_t threads, const shared_source& source,
+                           std::chrono::milliseconds duration) {
+   std::vector<thread_result> results(threads);
+   std::atomic<size_t> ready{0};
+   std::atomic<bool> start{false};
+   std::atomic<bool> stop{false};
+
+   std::vector<std::thread> workers;
+   for (size_t t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t] {
+         const shared_source local = shared ? shared_source{} : source;
+         const TestObj& obj = shared ? source.obj : local.obj;
+         const std::string& buffer = shared ? source.buffer : local.buffer;
+         std::string out;
+         TestObj reused;
+         thread_result r;
+
+         ready.fetch_add(1);
+         while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+         const uint64_t allocations_before = zmem::thread_allocations().allocations;
+         while (!stop.load(std::memory_order_relaxed)) {
+            for (size_t i = 0; i < 64; ++i) {
+               switch (op) {
+                  case operation::write:
+                     (void)glz::write_zmem(obj, out);
+                     r.checksum += out.size();
+                     break;
+                  case operation::read_fresh: {
+                     TestObj fresh;
+                     (void)glz::read_zmem(fresh, buffer);
+                     r.checksum += fresh.string.size();
+                     break;
+                  }
+                  case operation::read_reused:
+                     (void)glz::read_zmem(reused, buffer);
+                     r.checksum += reused.string.size();
+                     break;
+                  case operation::lazy_view: {
+                     glz::lazy_zmem_view<TestObj> view{buffer};
+                     r.checksum += static_cast<uint64_t>(view.get<5>()) + view.get<4>().size();
+                     break;
+                  }
+               }
+            }
+            r.ops += 64;
+         }
+         r.allocations = zmem::thread_allocations().allocations - allocations_before;
+         results[t] = r;
+      });
+   }
+
+   while (ready.load() < threads) std::this_thread::yield();
+   const auto begin = std::chrono::steady_clock::now();
+   start.store(true, std::memory_order_release);
+   std::this_thread::sleep_for(duration);
+   stop.store(true);
+   for (auto& w : workers) w.join();
+   const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+   scaling_result result;
+   uint64_t ops = 0;
+   uint64_t allocations = 0;
+   for (const auto& r : results) {
+      ops += r.ops;
+      allocations += r.allocations;
+      result.checksum += r.checksum;
+   }
+   result.ops_per_s = static_cast<double>(ops) / seconds;
+   result.allocations_per_op = ops ? static_cast<double>(allocations) / static_cast<double>(ops) : 0.0;
+   return result;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+   const size_t max_threads = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : hardware);
+   const std::chrono::milliseconds duration{argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 500};
+
+   shared_source source;
+   source.obj = create_test_data();
+   if (auto ec = glz::write_zmem(source.obj, source.buffer); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, source.buffer) << "\n";
+      return 1;
+   }
+
+   std::vector<size_t> thread_counts;
+   for (size_t n = 1; n < max_threads; n *= 2) thread_counts.push_back(n);
+   thread_counts.push_back(max_threads);
+
+   std::cout << "ZMEM Thread Scaling Benchmark\n";
+   std::cout << "=============================\n\n";
+   std::cout << "Hardware threads: " << hardware << ", message: " << source.buffer.size() << " bytes, "
+             << duration.count() << " ms per run\n\n";
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "| Operation | Source | Threads | M ops/s | MB/s | Per-thread efficiency (%) | Allocs/op |\n";
+   std::cout << "|-----------|--------|---------|---------|------|---------------------------|-----------|\n";
+
+   uint64_t checksum = 0;
+   for (const operation op :
+        {operation::write, operation::read_fresh, operation::read_reused, operation::lazy_view}) {
+      for (const bool shared : {false, true}) {
+         double single_thread = 0.0;
+         for (const size_t threads : thread_counts) {
+            const scaling_result r = run_scaling(op, shared, threads, source, duration);
+            checksum += r.checksum;
+            if (threads == 1) single_thread = r.ops_per_s;
+            const double efficiency = 100.0 * r.ops_per_s / (single_thread * static_cast<double>(threads));
+            std::cout << "| " << operation_name(op) << " | " << (shared ? "shared" : "private") << " | " << threads
+                      << " | " << r.ops_per_s / 1e6 << " | "
+                      << r.ops_per_s * static_cast<double>(source.buffer.size()) / 1e6 << " | " << efficiency
+                      << " | " << r.allocations_per_op << " |\n";
+         }
+      }
+   }
+
+   if (hardware < max_threads) {
+      std::cout << "\nNote: more threads than hardware threads; efficiency beyond " << hardware
+                << " reflects time slicing\n";
+   }
+   std::cout << "\nChecksum: " << checksum << "\n";
+   return 0;
+}
@@ -0,0 +1,166 @@
+// ZMEM Padding Scrub Benchmark
+// Writing the wire bytes of [T] arrays of fixed structs whose padding holds garbage:
+// field by field into a zeroed element, against zmem::copy_scrubbed with scalar and AVX2
+// masks, a raw memcpy (fast but not a valid encoding when T has padding),
+// glz::write_zmem of the std::vector and zmem::write_zmem_batch, whose fixed struct
+// branch is the encoder that uses copy_scrubbed. Quote has 6 bytes of tail padding; Tick
+// has none, so copy_scrubbed is a memcpy. Outputs are checked against the per-field
+// encoding before timing.
+//
+// Usage: zmem_scrub_bench [elements=1000000] [runs=5]
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_batch_encode.hpp"
+#include "zmem_fixtures.hpp"
+#include "zmem_scrub.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Test Data Structures
+// ============================================================================
+
+static_assert(zmem::native_wire_stride<Quote>() && !zmem::padding_free<Quote>());
+static_assert(zmem::padding_free<Tick>());
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+// Baseline: zero each wire element, then copy its fields one by one
+template <class T>
+void write_per_field(const std::vector<T>& values, char* out) {
+   using layout = zmem::struct_layout<T>;
+   for (size_t i = 0; i < values.size(); ++i) {
+      char* element = out + i * sizeof(T);
+      std::memset(element, 0, sizeof(T));
+      [&]<size_t... I>(std::index_sequence<I...>) {
+         ((std::memcpy(element + layout::offsets[I], &zmem::detail::field<I>(values[i]),
+                       sizeof(zmem::detail::field_type<T, I>))),
+          ...);
+      }(std::make_index_sequence<layout::count>{});
+   }
+}
+
+// Best of `runs`, in ns per element; each run repeats func() `repeat` times
+template <class Func>
+double best_ns_per_element(Func&& func, size_t elements, size_t repeat, size_t runs) {
+   func(); // Warmup
+   double best = 0.0;
+   for (size_t r = 0; r < runs; ++r) {
+      auto start = std::chrono::high_resolution_clock::now();
+      for (size_t k = 0; k < repeat; ++k) func();
+      auto end = std::chrono::high_resolution_clock::now();
+      const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+                        double(elements * repeat);
+      if (r == 0 || ns < best) best = ns;
+   }
+   return best;
+}
+
+void print_row(const std::string& array, const char* method, double ns, size_t element_size, double baseline_ns) {
+   std::cout << "| " << array << " | " << method << " | " << ns << " | " << double(element_size) / ns << " | "
+             << baseline_ns / ns << "x |\n";
+}
+
+template <class T>
+bool run_array(const char* name, const std::vector<T>& values, size_t runs) {
+   const size_t n = values.size();
+   const size_t bytes = n * sizeof(T);
+   const size_t repeat = std::max<size_t>(1, (64u << 20) / bytes); // At least 64 MB written per run
+   const std::string array = std::string(name) + " x " + std::to_string(n);
+
+   std::string expected(bytes, '\0');
+   std::string out(bytes, '\0');
+   write_per_field(values, expected.data());
+   const zmem::scrub_isa best = zmem::best_scrub_isa();
+   for (const zmem::scrub_isa isa : {zmem::scrub_isa::scalar, best}) {
+      std::memset(out.data(), 0x5A, out.size());
+      zmem::copy_scrubbed(values.data(), n, out.data(), isa);
+      if (out != expected) {
+         std::cerr << name << ": copy_scrubbed (" << zmem::scrub_isa_name(isa) << ") differs from per-field\n";
+         return false;
+      }
+   }
+   std::string glaze;
+   if (auto ec = glz::write_zmem(values, glaze); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, glaze) << "\n";
+      return false;
+   }
+   const bool glaze_zeroed = glaze.size() >= 8 + bytes && glaze.compare(8, bytes, expected) == 0;
+
+   // write_zmem_batch writes the array message: [count:8], the elements, padding to 8
+   std::string batch;
+   std::string expected_batch(8, '\0');
+   const uint64_t count = n;
+   std::memcpy(expected_batch.data(), &count, 8);
+   expected_batch += expected;
+   expected_batch.resize(zmem::detail::align_up(expected_batch.size(), 8), '\0');
+   if (!zmem::write_zmem_batch(std::span<const T>{values}, batch, zmem::batch_format::array) ||
+       batch != expected_batch) {
+      std::cerr << name << ": write_zmem_batch differs from per-field\n";
+      return false;
+   }
+
+   const double baseline = best_ns_per_element([&] { write_per_field(values, out.data()); }, n, repeat, runs);
+   print_row(array, "per-field", baseline, sizeof(T), baseline);
+   print_row(array, "copy_scrubbed (scalar)",
+             best_ns_per_element(
+                [&] { zmem::copy_scrubbed(values.data(), n, out.data(), zmem::scrub_isa::scalar); }, n, repeat,
+                runs),
+             sizeof(T), baseline);
+   if (best != zmem::scrub_isa::scalar) {
+      print_row(array, "copy_scrubbed (AVX2)",
+                best_ns_per_element([&] { zmem::copy_scrubbed(values.data(), n, out.data(), best); }, n, repeat,
+                                    runs),
+                sizeof(T), baseline);
+   }
+   print_row(array, zmem::padding_free<T>() ? "memcpy" : "memcpy (padding not zeroed)",
+             best_ns_per_element([&] { std::memcpy(out.data(), values.data(), bytes); }, n, repeat, runs), sizeof(T),
+             baseline);
+   print_row(array, glaze_zeroed ? "write_zmem(std::vector)" : "write_zmem(std::vector) (padding not zeroed)",
+             best_ns_per_element([&] { (void)glz::write_zmem(values, glaze); }, n, repeat, runs), sizeof(T),
+             baseline);
+   print_row(array, "write_zmem_batch array",
+             best_ns_per_element(
+                [&] { (void)zmem::write_zmem_batch(std::span<const T>{values}, batch, zmem::batch_format::array); },
+                n, repeat, runs),
+             sizeof(T), baseline);
+   return true;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t count = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000);
+   const size_t runs = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5);
+   constexpr size_t cached = 4096; // Source and output fit in L2
+
+   std::cout << "ZMEM Padding Scrub Benchmark\n";
+   std::cout << "============================\n\n";
+   constexpr auto quote_mask = zmem::padding_mask<Quote>();
+   std::cout << "Quote: " << sizeof(Quote) << " bytes, " << std::count(quote_mask.begin(), quote_mask.end(), 0)
+             << " padding; Tick: " << sizeof(Tick) << " bytes, no padding. Best of " << runs
+             << " runs, scrub: " << zmem::scrub_isa_name(zmem::best_scrub_isa()) << "\n\n";
+   std::cout << std::fixed << std::setprecision(2);
+   std::cout << "| Array | Method | ns/element | GB/s | Speedup |\n";
+   std::cout << "|-------|--------|------------|------|---------|\n";
+
+   for (const size_t n : {std::min(cached, count), count}) {
+      if (!run_array("[Quote]", make_quotes(n), runs)) return 1;
+      if (!run_array("[Tick]", create_ticks(n), runs)) return 1;
+      if (n == count) break;
+   }
+   return 0;
+}
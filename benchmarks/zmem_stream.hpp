@@ -0,0 +1,640 @@
+// ZMEM Stream I/O
+// C++20 coroutine API for reading and writing size-framed ZMEM messages over
+// non-blocking byte streams (sockets, pipes, socketpairs) on an epoll event loop.
+//
+//    zmem::stream_result<Order> order = co_await zmem::async_read<Order>(stream);
+//    zmem::stream_error ec = co_await zmem::async_write(stream, order.value);
+//
+// A framed message is a variable struct message: its 8-byte size header says how
+// many bytes follow. Received messages land in pooled buffers, each stream reads
+// ahead so one wakeup yields every frame already received, and coroutine frames are
+// recycled, so the steady state performs no per-message allocation. Linux only.
+
+#pragma once
+
+#include "glaze/zmem.hpp"
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <coroutine>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace zmem {
+
+enum class stream_error : uint32_t {
+   none = 0,
+   closed, // Peer closed the stream at a frame boundary
+   truncated, // Peer closed the stream mid-frame
+   io_error,
+   too_large, // Size header exceeds stream_options::max_message_size
+   decode_error,
+   encode_error,
+};
+
+template <class V>
+struct stream_result {
+   V value{};
+   stream_error error{};
+
+   explicit operator bool() const noexcept { return error == stream_error::none; }
+};
+
+namespace detail {
+
+// ----------------------------------------------------------------------------
+// Coroutine frame recycling
+// ----------------------------------------------------------------------------
+// Per-thread free lists for frames up to 1 KB in 64-byte size classes.
+
+struct frame_cache {
+   static constexpr size_t granularity = 64;
+   static constexpr size_t classes = 16;
+   static constexpr size_t max_cached = 64;
+
+   struct node {
+      node* next;
+   };
+
+   node* free[classes]{};
+   size_t cached[classes]{};
+
+   ~frame_cache() {
+      for (auto* head : free) {
+         while (head) {
+            node* next = head->next;
+            ::operator delete(head);
+            head = next;
+         }
+      }
+   }
+};
+
+inline frame_cache& thread_frame_cache() {
+   thread_local frame_cache cache;
+   return cache;
+}
+
+inline void* allocate_frame(size_t n) {
+   const size_t c = (n + frame_cache::granularity - 1) / frame_cache::granularity;
+   if (c == 0 || c > frame_cache::classes) return ::operator new(n);
+   auto& cache = thread_frame_cache();
+   if (auto* p = cache.free[c - 1]) {
+      cache.free[c - 1] = p->next;
+      --cache.cached[c - 1];
+      return p;
+   }
+   return ::operator new(c * frame_cache::granularity);
+}
+
+inline void free_frame(void* p, size_t n) noexcept {
+   const size_t c = (n + frame_cache::granularity - 1) / frame_cache::granularity;
+   if (c == 0 || c > frame_cache::classes) return ::operator delete(p);
+   auto& cache = thread_frame_cache();
+   if (cache.cached[c - 1] >= frame_cache::max_cached) return ::operator delete(p);
+   auto* node = static_cast<frame_cache::node*>(p);
+   node->next = cache.free[c - 1];
+   cache.free[c - 1] = node;
+   ++cache.cached[c - 1];
+}
+
+struct task_promise_base {
+   // A child task is started inline by its awaiter. If it finishes before suspending,
+   // the awaiter continues without suspending; otherwise the child resumes its awaiter
+   // when done. This keeps loops of synchronous completions at constant stack depth.
+   enum class run_state : uint8_t { inline_start, completed_inline, suspended };
+
+   std::coroutine_handle<> continuation{};
+   std::exception_ptr exception{};
+   run_state state{run_state::suspended};
+
+   static void* operator new(size_t n) { return allocate_frame(n); }
+   static void operator delete(void* p, size_t n) noexcept { free_frame(p, n); }
+
+   std::suspend_always initial_suspend() noexcept { return {}; }
+
+   struct final_awaiter {
+      bool await_ready() noexcept { return false; }
+      template <class Promise>
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+         auto& promise = h.promise();
+         if (promise.state == run_state::inline_start) {
+            promise.state = run_state::completed_inline;
+            return std::noop_coroutine();
+         }
+         if (auto c = promise.continuation) return c;
+         return std::noop_coroutine();
+      }
+      void await_resume() noexcept {}
+   };
+   final_awaiter final_suspend() noexcept { return {}; }
+
+   void unhandled_exception() noexcept { exception = std::current_exception(); }
+};
+
+template <class T>
+struct task_promise : task_promise_base {
+   std::optional<T> value{};
+
+   template <class U>
+   void return_value(U&& v) {
+      value.emplace(std::forward<U>(v));
+   }
+   T result() {
+      if (exception) std::rethrow_exception(exception);
+      return std::move(*value);
+   }
+};
+
+template <>
+struct task_promise<void> : task_promise_base {
+   void return_void() noexcept {}
+   void result() {
+      if (exception) std::rethrow_exception(exception);
+   }
+};
+
+} // namespace detail
+
+// ============================================================================
+// Task
+// ============================================================================
+
+// Lazily started coroutine. Awaiting a task runs it inline and resumes the awaiter
+// when it finishes. Top-level tasks are handed to event_loop::spawn.
+template <class T = void>
+class [[nodiscard]] task {
+  public:
+   struct promise_type : detail::task_promise<T> {
+      task get_return_object() noexcept { return task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+   };
+
+   task() = default;
+   task(task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+   task& operator=(task&& other) noexcept {
+      if (this != &other) {
+         if (handle_) handle_.destroy();
+         handle_ = std::exchange(other.handle_, {});
+      }
+      return *this;
+   }
+   ~task() {
+      if (handle_) handle_.destroy();
+   }
+
+   bool done() const noexcept { return !handle_ || handle_.done(); }
+
+   auto operator co_await() && noexcept {
+      struct awaiter {
+         std::coroutine_handle<promise_type> handle;
+
+         bool await_ready() const noexcept { return false; }
+         bool await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            auto& promise = handle.promise();
+            promise.continuation = awaiting;
+            promise.state = detail::task_promise_base::run_state::inline_start;
+            handle.resume();
+            if (promise.state == detail::task_promise_base::run_state::completed_inline) return false;
+            promise.state = detail::task_promise_base::run_state::suspended;
+            return true;
+         }
+         T await_resume() { return handle.promise().result(); }
+      };
+      return awaiter{handle_};
+   }
+
+  private:
+   friend class event_loop;
+
+   explicit task(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+
+   std::coroutine_handle<promise_type> handle_{};
+};
+
+// ============================================================================
+// Event Loop
+// ============================================================================
+
+// Single-threaded epoll loop. File descriptors are registered edge-triggered once;
+// a coroutine waits for readiness only after a read or write returned EAGAIN.
+class event_loop {
+  public:
+   event_loop() : epoll_fd_(::epoll_create1(EPOLL_CLOEXEC)) {}
+   ~event_loop() {
+      tasks_.clear();
+      if (epoll_fd_ >= 0) ::close(epoll_fd_);
+   }
+
+   event_loop(const event_loop&) = delete;
+   event_loop& operator=(const event_loop&) = delete;
+
+   bool valid() const noexcept { return epoll_fd_ >= 0; }
+   uint64_t wakeups() const noexcept { return wakeups_; }
+
+   // Starts a top-level task; it runs until its first suspension
+   void spawn(task<void> t) {
+      auto handle = t.handle_;
+      tasks_.push_back(std::move(t));
+      handle.resume();
+   }
+
+   // Runs until every spawned task has finished (or none can make progress).
+   // Rethrows the first exception escaping a top-level task.
+   void run() {
+      epoll_event events[64];
+      while (true) {
+         sweep();
+         if (tasks_.empty() || waiting_ == 0) break;
+         const int n = ::epoll_wait(epoll_fd_, events, 64, -1);
+         if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+         }
+         ++wakeups_;
+         for (int i = 0; i < n; ++i) {
+            const int fd = events[i].data.fd;
+            const uint32_t ev = events[i].events;
+            auto it = fds_.find(fd);
+            if (it == fds_.end()) continue;
+            const auto reader = (ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) ? take(it->second.reader) : nullptr;
+            const auto writer = (ev & (EPOLLOUT | EPOLLHUP | EPOLLERR)) ? take(it->second.writer) : nullptr;
+            if (reader) reader.resume();
+            if (writer) writer.resume();
+         }
+      }
+      sweep();
+      if (exception_) std::rethrow_exception(std::exchange(exception_, nullptr));
+   }
+
+   bool add(int fd) {
+      epoll_event ev{};
+      ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+      ev.data.fd = fd;
+      if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) return false;
+      fds_[fd] = {};
+      return true;
+   }
+
+   void remove(int fd) noexcept {
+      ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+      fds_.erase(fd);
+   }
+
+   // co_await loop.readable(fd) / loop.writable(fd)
+   auto readable(int fd) noexcept { return readiness{this, fd, false}; }
+   auto writable(int fd) noexcept { return readiness{this, fd, true}; }
+
+  private:
+   struct waiters {
+      std::coroutine_handle<> reader{};
+      std::coroutine_handle<> writer{};
+   };
+
+   struct readiness {
+      event_loop* loop;
+      int fd;
+      bool write;
+
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> h) noexcept {
+         auto& w = loop->fds_[fd];
+         (write ? w.writer : w.reader) = h;
+         ++loop->waiting_;
+      }
+      void await_resume() const noexcept {}
+   };
+
+   std::coroutine_handle<> take(std::coroutine_handle<>& slot) noexcept {
+      if (slot) --waiting_;
+      return std::exchange(slot, {});
+   }
+
+   void sweep() {
+      std::erase_if(tasks_, [&](task<void>& t) {
+         if (!t.done()) return false;
+         if (auto& e = t.handle_.promise().exception; e && !exception_) exception_ = e;
+         return true;
+      });
+   }
+
+   int epoll_fd_{-1};
+   std::unordered_map<int, waiters> fds_{};
+   std::vector<task<void>> tasks_{};
+   size_t waiting_{};
+   uint64_t wakeups_{};
+   std::exception_ptr exception_{};
+};
+
+// ============================================================================
+// Buffer Pool
+// ============================================================================
+
+class buffer_pool;
+
+// Message bytes borrowed from a buffer_pool, returned on destruction.
+// Storage comes from operator new[], so it is suitably aligned for zero-copy views.
+class pooled_buffer {
+  public:
+   pooled_buffer() = default;
+   pooled_buffer(pooled_buffer&& other) noexcept
+      : pool_(std::exchange(other.pool_, nullptr)),
+        data_(std::move(other.data_)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+   pooled_buffer& operator=(pooled_buffer&& other) noexcept {
+      if (this != &other) {
+         release();
+         pool_ = std::exchange(other.pool_, nullptr);
+         data_ = std::move(other.data_);
+         size_ = std::exchange(other.size_, 0);
+         capacity_ = std::exchange(other.capacity_, 0);
+      }
+      return *this;
+   }
+   ~pooled_buffer() { release(); }
+
+   char* data() noexcept { return data_.get(); }
+   const char* data() const noexcept { return data_.get(); }
+   size_t size() const noexcept { return size_; }
+   std::string_view view() const noexcept { return {data_.get(), size_}; }
+
+  private:
+   friend class buffer_pool;
+
+   inline void release() noexcept;
+
+   buffer_pool* pool_{};
+   std::unique_ptr<char[]> data_{};
+   size_t size_{};
+   size_t capacity_{};
+};
+
+class buffer_pool {
+  public:
+   explicit buffer_pool(size_t max_cached = 64) : max_cached_(max_cached) {}
+
+   buffer_pool(const buffer_pool&) = delete;
+   buffer_pool& operator=(const buffer_pool&) = delete;
+
+   // A buffer of `size` bytes (contents unspecified), reusing the smallest cached buffer
+   // that fits. Smaller cached buffers stay cached for smaller messages.
+   pooled_buffer acquire(size_t size) {
+      pooled_buffer b;
+      b.pool_ = this;
+      auto fit = free_.end();
+      for (auto it = free_.begin(); it != free_.end(); ++it) {
+         if (it->second >= size && (fit == free_.end() || it->second < fit->second)) fit = it;
+      }
+      if (fit != free_.end()) {
+         std::iter_swap(fit, free_.end() - 1);
+         b.data_ = std::move(free_.back().first);
+         b.capacity_ = free_.back().second;
+         free_.pop_back();
+      }
+      else {
+         ++allocations_;
+         b.capacity_ = std::max<size_t>(size, 256);
+         b.data_.reset(new char[b.capacity_]);
+      }
+      b.size_ = size;
+      return b;
+   }
+
+   // Buffers allocated because none cached was large enough
+   uint64_t allocations() const noexcept { return allocations_; }
+
+  private:
+   friend class pooled_buffer;
+
+   // When the cache is full a buffer replaces the smallest cached one if it is larger,
+   // so the cache converges on buffers that fit the largest messages seen
+   void recycle(std::unique_ptr<char[]> data, size_t capacity) {
+      if (free_.size() < max_cached_) {
+         free_.emplace_back(std::move(data), capacity);
+         return;
+      }
+      auto smallest = std::min_element(free_.begin(), free_.end(),
+                                       [](const auto& a, const auto& b) { return a.second < b.second; });
+      if (smallest != free_.end() && smallest->second < capacity) *smallest = {std::move(data), capacity};
+   }
+
+   size_t max_cached_{};
+   std::vector<std::pair<std::unique_ptr<char[]>, size_t>> free_{};
+   uint64_t allocations_{};
+};
+
+inline void pooled_buffer::release() noexcept {
+   if (pool_ && data_) pool_->recycle(std::move(data_), capacity_);
+   pool_ = nullptr;
+   size_ = 0;
+   capacity_ = 0;
+}
+
+// ============================================================================
+// Non-blocking fd Stream
+// ============================================================================
+
+struct stream_options {
+   size_t read_ahead{64 * 1024}; // Bytes requested per read(); many small frames arrive in one call
+   uint64_t max_message_size{uint64_t(1) << 30};
+};
+
+// Adapter for a non-blocking socket or pipe. Takes ownership of the descriptor and
+// registers it with the loop. One reader and one writer coroutine at a time.
+class fd_stream {
+  public:
+   fd_stream(event_loop& loop, int fd, buffer_pool& pool, const stream_options& opts = {})
+      : loop_(&loop), pool_(&pool), fd_(fd), opts_(opts), read_buffer_(new char[opts.read_ahead]) {
+      if (fd_ >= 0) {
+         ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) | O_NONBLOCK);
+         int type = 0;
+         socklen_t length = sizeof(type);
+         socket_ = ::getsockopt(fd_, SOL_SOCKET, SO_TYPE, &type, &length) == 0;
+         loop_->add(fd_);
+      }
+   }
+   ~fd_stream() { close(); }
+
+   fd_stream(const fd_stream&) = delete;
+   fd_stream& operator=(const fd_stream&) = delete;
+   fd_stream(fd_stream&& other) noexcept
+      : loop_(other.loop_),
+        pool_(other.pool_),
+        fd_(std::exchange(other.fd_, -1)),
+        socket_(other.socket_),
+        opts_(other.opts_),
+        read_buffer_(std::move(other.read_buffer_)),
+        begin_(other.begin_),
+        end_(other.end_),
+        read_calls_(other.read_calls_),
+        encode_buffer_(std::move(other.encode_buffer_)) {}
+
+   void close() noexcept {
+      if (fd_ < 0) return;
+      loop_->remove(fd_);
+      ::close(fd_);
+      fd_ = -1;
+   }
+
+   // Half-closes the write side so the peer sees end of stream
+   void shutdown_write() noexcept {
+      if (fd_ >= 0) ::shutdown(fd_, SHUT_WR);
+   }
+
+   int fd() const noexcept { return fd_; }
+   buffer_pool& pool() const noexcept { return *pool_; }
+   const stream_options& options() const noexcept { return opts_; }
+   uint64_t read_calls() const noexcept { return read_calls_; }
+
+   // Serialization buffer of async_write, reused so encoding does not allocate
+   std::string& encode_buffer() noexcept { return encode_buffer_; }
+
+   // Reads exactly `n` bytes. Returns closed if the stream ended before the first byte,
+   // truncated if it ended later.
+   task<stream_error> read_exact(char* dst, size_t n) {
+      size_t got = 0;
+      while (got < n) {
+         if (begin_ < end_) {
+            const size_t take = std::min(n - got, end_ - begin_);
+            std::memcpy(dst + got, read_buffer_.get() + begin_, take);
+            begin_ += take;
+            got += take;
+            continue;
+         }
+         // Large remainders bypass the read-ahead buffer
+         const bool direct = n - got >= opts_.read_ahead;
+         const ssize_t r = direct ? ::read(fd_, dst + got, n - got) : ::read(fd_, read_buffer_.get(), opts_.read_ahead);
+         ++read_calls_;
+         if (r > 0) {
+            if (direct) {
+               got += size_t(r);
+            }
+            else {
+               begin_ = 0;
+               end_ = size_t(r);
+            }
+         }
+         else if (r == 0) {
+            co_return got == 0 ? stream_error::closed : stream_error::truncated;
+         }
+         else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            co_await loop_->readable(fd_);
+         }
+         else if (errno != EINTR) {
+            co_return stream_error::io_error;
+         }
+      }
+      co_return stream_error::none;
+   }
+
+   task<stream_error> write_all(const char* src, size_t n) {
+      size_t sent = 0;
+      while (sent < n) {
+         // MSG_NOSIGNAL: a closed peer is reported as an error instead of SIGPIPE
+         const ssize_t r =
+            socket_ ? ::send(fd_, src + sent, n - sent, MSG_NOSIGNAL) : ::write(fd_, src + sent, n - sent);
+         if (r >= 0) {
+            sent += size_t(r);
+         }
+         else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            co_await loop_->writable(fd_);
+         }
+         else if (errno != EINTR) {
+            co_return stream_error::io_error;
+         }
+      }
+      co_return stream_error::none;
+   }
+
+  private:
+   event_loop* loop_{};
+   buffer_pool* pool_{};
+   int fd_{-1};
+   bool socket_{};
+   stream_options opts_{};
+   std::unique_ptr<char[]> read_buffer_{};
+   size_t begin_{};
+   size_t end_{};
+   uint64_t read_calls_{};
+   std::string encode_buffer_{};
+};
+
+// A connected pair of non-blocking stream sockets, e.g. for in-process pipelines
+inline std::optional<std::pair<fd_stream, fd_stream>> make_socketpair(event_loop& loop, buffer_pool& pool,
+                                                                      const stream_options& opts = {}) {
+   int fds[2];
+   if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) != 0) return std::nullopt;
+   return std::pair<fd_stream, fd_stream>{std::piecewise_construct, std::forward_as_tuple(loop, fds[0], pool, opts),
+                                          std::forward_as_tuple(loop, fds[1], pool, opts)};
+}
+
+// ============================================================================
+// Framed Messages
+// ============================================================================
+
+// Reads one framed message (size header included) into a pooled buffer. The bytes
+// can be handed directly to glz::lazy_zmem_view.
+template <class Stream>
+task<stream_result<pooled_buffer>> async_read_message(Stream& stream) {
+   stream_result<pooled_buffer> result{};
+   uint64_t size = 0;
+   if (auto ec = co_await stream.read_exact(reinterpret_cast<char*>(&size), 8); ec != stream_error::none) {
+      result.error = ec;
+      co_return result;
+   }
+   if (size > stream.options().max_message_size) {
+      result.error = stream_error::too_large;
+      co_return result;
+   }
+   result.value = stream.pool().acquire(8 + size_t(size));
+   std::memcpy(result.value.data(), &size, 8);
+   if (auto ec = co_await stream.read_exact(result.value.data() + 8, size_t(size)); ec != stream_error::none) {
+      result.error = ec == stream_error::closed ? stream_error::truncated : ec;
+   }
+   co_return result;
+}
+
+// Reads one framed message and decodes it; the buffer goes back to the pool
+template <class T, class Stream>
+task<stream_result<T>> async_read(Stream& stream) {
+   stream_result<T> result{};
+   auto message = co_await async_read_message(stream);
+   if (!message) {
+      result.error = message.error;
+      co_return result;
+   }
+   if (auto ec = glz::read_zmem(result.value, message.value.view()); ec) {
+      result.error = stream_error::decode_error;
+   }
+   co_return result;
+}
+
+template <class Stream>
+task<stream_error> async_write_message(Stream& stream, std::string_view message) {
+   co_return co_await stream.write_all(message.data(), message.size());
+}
+
+// Encodes `value` (a variable struct, so the message carries its size header) into
+// the stream's encode buffer and writes it
+template <class T, class Stream>
+task<stream_error> async_write(Stream& stream, const T& value) {
+   std::string& buffer = stream.encode_buffer();
+   if (auto ec = glz::write_zmem(value, buffer); ec) co_return stream_error::encode_error;
+   co_return co_await stream.write_all(buffer.data(), buffer.size());
+}
+
+} // namespace zmem
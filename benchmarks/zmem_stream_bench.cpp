@@ -0,0 +1,228 @@
+// ZMEM Stream Benchmark
+// Receives framed TestObj messages over a socketpair and compares a hand-written
+// blocking framing loop (allocating a buffer per message) with the coroutine API
+// in zmem_stream.hpp (pooled buffers, read-ahead, one event loop).
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_fixtures.hpp"
+#include "zmem_stream.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+struct stream_stats {
+   double seconds{};
+   uint64_t messages{};
+   uint64_t read_calls{};
+   uint64_t wakeups{};
+   uint64_t allocations{};
+   uint64_t checksum{};
+};
+
+// Blocking producer: writes `count` copies of `message`, batched so the reader is the bottleneck
+std::thread start_producer(int fd, const std::string& message, size_t count) {
+   return std::thread([fd, &message, count] {
+      std::string batch;
+      for (size_t i = 0; i < 64; ++i) batch.append(message);
+      size_t remaining = count;
+      while (remaining > 0) {
+         const size_t n = std::min<size_t>(remaining, 64);
+         const char* p = batch.data();
+         size_t left = n * message.size();
+         while (left > 0) {
+            const ssize_t w = ::write(fd, p, left);
+            if (w <= 0) return;
+            p += w;
+            left -= size_t(w);
+         }
+         remaining -= n;
+      }
+      ::shutdown(fd, SHUT_WR);
+   });
+}
+
+bool read_full(int fd, char* dst, size_t n, uint64_t& read_calls) {
+   while (n > 0) {
+      const ssize_t r = ::read(fd, dst, n);
+      ++read_calls;
+      if (r <= 0) return false;
+      dst += r;
+      n -= size_t(r);
+   }
+   return true;
+}
+
+// The framing loop a gateway writes by hand: header, allocate, body, decode
+stream_stats run_blocking(const std::string& message, size_t count) {
+   stream_stats stats;
+   int fds[2];
+   if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) return stats;
+   std::thread producer = start_producer(fds[1], message, count);
+
+   TestObj obj;
+   const auto start = std::chrono::steady_clock::now();
+   while (true) {
+      uint64_t size = 0;
+      if (!read_full(fds[0], reinterpret_cast<char*>(&size), 8, stats.read_calls)) break;
+      std::string frame(8 + size, '\0');
+      ++stats.allocations;
+      std::memcpy(frame.data(), &size, 8);
+      if (!read_full(fds[0], frame.data() + 8, size, stats.read_calls)) break;
+      if (glz::read_zmem(obj, frame)) break;
+      stats.checksum += obj.fixed_object.int_array.size();
+      ++stats.messages;
+   }
+   stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+   producer.join();
+   ::close(fds[0]);
+   ::close(fds[1]);
+   return stats;
+}
+
+// Coroutine reader: decoded values (async_read<T>) or zero-copy views (async_read_message)
+stream_stats run_coroutine(const std::string& message, size_t count, bool decode) {
+   stream_stats stats;
+   int fds[2];
+   if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) return stats;
+   std::thread producer = start_producer(fds[1], message, count);
+
+   zmem::buffer_pool pool;
+   zmem::event_loop loop;
+   zmem::fd_stream stream{loop, fds[0], pool};
+
+   auto reader = [&]() -> zmem::task<void> {
+      while (true) {
+         if (decode) {
+            auto obj = co_await zmem::async_read<TestObj>(stream);
+            if (!obj) break;
+            stats.checksum += obj.value.fixed_object.int_array.size();
+         }
+         else {
+            auto frame = co_await zmem::async_read_message(stream);
+            if (!frame) break;
+            glz::lazy_zmem_view<TestObj> view{frame.value.view()};
+            stats.checksum += static_cast<uint64_t>(view.get<5>());
+         }
+         ++stats.messages;
+      }
+   };
+
+   const auto start = std::chrono::steady_clock::now();
+   loop.spawn(reader());
+   loop.run();
+   stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+   producer.join();
+   stats.read_calls = stream.read_calls();
+   stats.wakeups = loop.wakeups();
+   stats.allocations = pool.allocations();
+   ::close(fds[1]);
+   return stats;
+}
+
+// Coroutine writer and reader on the same loop (async_write + async_read)
+stream_stats run_loopback(const TestObj& obj, size_t count) {
+   stream_stats stats;
+   zmem::buffer_pool pool;
+   zmem::event_loop loop;
+   auto pair = zmem::make_socketpair(loop, pool);
+   if (!pair) return stats;
+   auto& [reader_end, writer_end] = *pair;
+
+   auto writer = [&]() -> zmem::task<void> {
+      for (size_t i = 0; i < count; ++i) {
+         if (co_await zmem::async_write(writer_end, obj) != zmem::stream_error::none) break;
+      }
+      writer_end.shutdown_write();
+   };
+   auto reader = [&]() -> zmem::task<void> {
+      while (true) {
+         auto value = co_await zmem::async_read<TestObj>(reader_end);
+         if (!value) break;
+         stats.checksum += value.value.fixed_object.int_array.size();
+         ++stats.messages;
+      }
+   };
+
+   const auto start = std::chrono::steady_clock::now();
+   loop.spawn(reader());
+   loop.spawn(writer());
+   loop.run();
+   stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   stats.read_calls = reader_end.read_calls();
+   stats.wakeups = loop.wakeups();
+   stats.allocations = pool.allocations();
+   return stats;
+}
+
+void print_row(const char* reader, const stream_stats& s, size_t message_size) {
+   const double messages = static_cast<double>(s.messages);
+   std::cout << "| " << reader << " | " << messages / s.seconds / 1e6 << " | "
+             << messages * static_cast<double>(message_size) / s.seconds / 1e6 << " | "
+             << static_cast<double>(s.read_calls) / messages << " | ";
+   if (s.wakeups) {
+      std::cout << messages / static_cast<double>(s.wakeups);
+   }
+   else {
+      std::cout << "-";
+   }
+   std::cout << " | " << s.allocations << " |\n";
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+   const TestObj obj = create_test_data();
+   std::string message;
+   if (auto ec = glz::write_zmem(obj, message); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, message) << "\n";
+      return 1;
+   }
+
+   std::cout << "ZMEM Stream Benchmark\n";
+   std::cout << "=====================\n\n";
+   std::cout << "Messages: " << count << " x " << message.size() << " bytes over a socketpair\n\n";
+
+   const stream_stats blocking = run_blocking(message, count);
+   const stream_stats decoded = run_coroutine(message, count, true);
+   const stream_stats viewed = run_coroutine(message, count, false);
+   const stream_stats loopback = run_loopback(obj, count);
+
+   std::cout << std::fixed << std::setprecision(2);
+   std::cout << "| Reader | M msgs/s | MB/s | read() per msg | Msgs per wakeup | Buffer allocations |\n";
+   std::cout << "|--------|----------|------|----------------|-----------------|--------------------|\n";
+   print_row("Blocking hand-written framing", blocking, message.size());
+   print_row("co_await async_read<TestObj>", decoded, message.size());
+   print_row("co_await async_read_message + lazy view", viewed, message.size());
+   print_row("async_write -> async_read<TestObj> (one loop)", loopback, message.size());
+
+   for (const auto* s : {&blocking, &decoded, &viewed, &loopback}) {
+      if (s->messages != count) {
+         std::cerr << "Received " << s->messages << " of " << count << " messages\n";
+         return 1;
+      }
+   }
+
+   std::cout << "\nChecksum: " << blocking.checksum + decoded.checksum + viewed.checksum + loopback.checksum << "\n";
+   return 0;
+}
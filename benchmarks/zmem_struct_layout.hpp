@@ -0,0 +1,373 @@
+// ZMEM Struct Layout
+// Compile-time inline layout of native aggregates, following "Alignment Rules" and
+// "Inline Section Layout": where each field sits in a variable struct's inline section
+// and the wire size and alignment of fixed structs. Used by readers that locate fields
+// themselves (projected and columnar decode) instead of going through glz::read_zmem.
+//
+// Fields are found with aggregate structured bindings, so structs must be plain
+// aggregates of at most 16 fields without base classes. Supported field types are
+// arithmetic types and enums, std::array and std::optional of fixed types, nested
+// aggregates, std::string, std::vector and std::map / std::unordered_map; anything else
+// (e.g. std::variant) is reported as unsupported.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace zmem {
+
+namespace detail {
+
+// ----------------------------------------------------------------------------
+// Aggregate Fields
+// ----------------------------------------------------------------------------
+
+// Converts to any field type in aggregate initialization (never evaluated)
+struct any_field {
+   template <class U>
+   operator U&() const noexcept;
+};
+
+template <class T, class... Fields>
+constexpr size_t field_count_of() noexcept {
+   if constexpr (requires { T{Fields{}..., any_field{}}; }) {
+      return field_count_of<T, Fields..., any_field>();
+   }
+   else {
+      return sizeof...(Fields);
+   }
+}
+
+template <class T>
+   requires std::is_aggregate_v<T>
+inline constexpr size_t field_count = field_count_of<T>();
+
+// Tuple of references to the fields of `value`, in declaration order
+template <class T>
+constexpr auto tie_fields(T& value) noexcept {
+   constexpr size_t n = field_count<std::remove_cv_t<T>>;
+   static_assert(n >= 1 && n <= 16, "tie_fields supports aggregates of 1 to 16 fields");
+   if constexpr (n == 1) {
+      auto& [f0] = value;
+      return std::tie(f0);
+   }
+   else if constexpr (n == 2) {
+      auto& [f0, f1] = value;
+      return std::tie(f0, f1);
+   }
+   else if constexpr (n == 3) {
+      auto& [f0, f1, f2] = value;
+      return std::tie(f0, f1, f2);
+   }
+   else if constexpr (n == 4) {
+      auto& [f0, f1, f2, f3] = value;
+      return std::tie(f0, f1, f2, f3);
+   }
+   else if constexpr (n == 5) {
+      auto& [f0, f1, f2, f3, f4] = value;
+      return std::tie(f0, f1, f2, f3, f4);
+   }
+   else if constexpr (n == 6) {
+      auto& [f0, f1, f2, f3, f4, f5] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5);
+   }
+   else if constexpr (n == 7) {
+      auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6);
+   }
+   else if constexpr (n == 8) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+   }
+   else if constexpr (n == 9) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+   }
+   else if constexpr (n == 10) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+   }
+   else if constexpr (n == 11) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+   }
+   else if constexpr (n == 12) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+   }
+   else if constexpr (n == 13) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+   }
+   else if constexpr (n == 14) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+   }
+   else if constexpr (n == 15) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+   }
+   else if constexpr (n == 16) {
+      auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = value;
+      return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+   }
+}
+
+template <class T, size_t I>
+using field_type = std::remove_cvref_t<std::tuple_element_t<I, decltype(tie_fields(std::declval<T&>()))>>;
+
+template <size_t I, class T>
+constexpr auto& field(T& value) noexcept {
+   return std::get<I>(tie_fields(value));
+}
+
+// ----------------------------------------------------------------------------
+// Type Classification
+// ----------------------------------------------------------------------------
+
+template <class T, template <class...> class Template>
+inline constexpr bool is_specialization_v = false;
+
+template <template <class...> class Template, class... Args>
+inline constexpr bool is_specialization_v<Template<Args...>, Template> = true;
+
+template <class T>
+inline constexpr bool is_std_array_v = false;
+
+template <class E, size_t N>
+inline constexpr bool is_std_array_v<std::array<E, N>> = true;
+
+template <class T>
+inline constexpr bool is_string_v = is_specialization_v<T, std::basic_string>;
+
+template <class T>
+inline constexpr bool is_vector_v = is_specialization_v<T, std::vector>;
+
+template <class T>
+inline constexpr bool is_map_v = is_specialization_v<T, std::map> || is_specialization_v<T, std::unordered_map>;
+
+template <class T>
+inline constexpr bool is_optional_v = is_specialization_v<T, std::optional>;
+
+template <class T>
+inline constexpr bool is_struct_v = std::is_class_v<T> && std::is_aggregate_v<T> && !is_std_array_v<T>;
+
+constexpr size_t align_up(size_t n, size_t align) noexcept { return (n + align - 1) / align * align; }
+
+} // namespace detail
+
+// ============================================================================
+// Wire Layout
+// ============================================================================
+
+// Size and alignment of a field in an inline section (or of an array element)
+struct wire_layout {
+   size_t size{};
+   size_t align{1};
+   bool variable{}; // Stored as a reference into the variable section
+   bool supported{true};
+};
+
+template <class T>
+struct struct_layout;
+
+template <class T>
+constexpr wire_layout inline_layout() noexcept {
+   if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+      return {sizeof(T), alignof(T)};
+   }
+   else if constexpr (detail::is_std_array_v<T>) {
+      constexpr wire_layout element = inline_layout<typename T::value_type>();
+      return {element.size * std::tuple_size_v<T>, element.align, false, element.supported && !element.variable};
+   }
+   else if constexpr (detail::is_optional_v<T>) {
+      // [present:1][padding to alignof(T)][value]
+      constexpr wire_layout value = inline_layout<typename T::value_type>();
+      return {value.align + value.size, value.align, false, value.supported && !value.variable};
+   }
+   else if constexpr (detail::is_string_v<T> || detail::is_vector_v<T> || detail::is_map_v<T>) {
+      return {16, 8, true}; // {offset, count}
+   }
+   else if constexpr (detail::is_struct_v<T>) {
+      using layout = struct_layout<T>;
+      if constexpr (layout::variable) {
+         return {8, 8, true, layout::supported}; // {offset} of a self-contained message
+      }
+      else {
+         return {layout::fixed_size, layout::max_align, false, layout::supported};
+      }
+   }
+   else {
+      return {0, 1, false, false};
+   }
+}
+
+// Inline section of an aggregate: field offsets relative to the inline base (variable
+// structs) or to the start of the struct (fixed structs)
+template <class T>
+struct struct_layout {
+   static constexpr size_t count = detail::field_count<T>;
+
+   static constexpr std::array<wire_layout, count> fields = [] {
+      std::array<wire_layout, count> result{};
+      [&]<size_t... I>(std::index_sequence<I...>) {
+         ((result[I] = inline_layout<detail::field_type<T, I>>()), ...);
+      }(std::make_index_sequence<count>{});
+      return result;
+   }();
+
+   static constexpr std::array<size_t, count> offsets = [] {
+      std::array<size_t, count> result{};
+      size_t at = 0;
+      for (size_t i = 0; i < count; ++i) {
+         at = detail::align_up(at, fields[i].align);
+         result[i] = at;
+         at += fields[i].size;
+      }
+      return result;
+   }();
+
+   static constexpr size_t inline_size = count ? offsets[count - 1] + fields[count - 1].size : 0;
+
+   static constexpr size_t max_align = [] {
+      size_t result = 1;
+      for (const wire_layout& f : fields) result = f.align > result ? f.align : result;
+      return result;
+   }();
+
+   static constexpr bool variable = [] {
+      for (const wire_layout& f : fields) {
+         if (f.variable) return true;
+      }
+      return false;
+   }();
+
+   static constexpr bool supported = [] {
+      for (const wire_layout& f : fields) {
+         if (!f.supported) return false;
+      }
+      return true;
+   }();
+
+   // Fixed structs embedded in a struct or an array: the inline size padded to max_align
+   // ("Layout Algorithm"), which is sizeof(T) for a native layout. Nested fixed structs
+   // are embedded directly and array elements have no per-element padding.
+   static constexpr size_t fixed_size = detail::align_up(inline_size ? inline_size : 1, max_align);
+
+   // Fixed structs as a top-level message: fixed_size padded to a multiple of 8
+   static constexpr size_t message_size = detail::align_up(fixed_size, 8);
+
+   // Variable structs: byte 8, or max_align when a field needs more ("Alignment padding
+   // after headers")
+   static constexpr size_t inline_base = max_align > 8 ? max_align : 8;
+};
+
+template <class T>
+constexpr bool is_variable_struct() noexcept {
+   if constexpr (detail::is_struct_v<T>) {
+      return struct_layout<T>::variable;
+   }
+   else {
+      return false;
+   }
+}
+
+// True when the native object representation of a fixed type is its wire layout apart
+// from tail padding, so it can be copied with memcpy. Arrays of it additionally need
+// sizeof(T) == inline_layout<T>().size (see native_wire_stride).
+template <class T>
+constexpr bool native_wire_layout() noexcept;
+
+template <class T>
+constexpr bool native_wire_stride() noexcept {
+   return native_wire_layout<T>() && sizeof(T) == inline_layout<T>().size && alignof(T) == inline_layout<T>().align;
+}
+
+template <class T>
+constexpr bool native_wire_layout() noexcept {
+   if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+      return true;
+   }
+   else if constexpr (detail::is_std_array_v<T>) {
+      return native_wire_stride<typename T::value_type>();
+   }
+   else if constexpr (detail::is_struct_v<T>) {
+      using layout = struct_layout<T>;
+      if constexpr (layout::variable || !layout::supported || !std::is_trivially_copyable_v<T>) {
+         return false;
+      }
+      else {
+         return [&]<size_t... I>(std::index_sequence<I...>) {
+            return (native_wire_stride<detail::field_type<T, I>>() && ...);
+         }(std::make_index_sequence<layout::count>{});
+      }
+   }
+   else {
+      return false;
+   }
+}
+
+namespace detail {
+
+// Sets the value bytes of a T at `at` in `mask`; padding bytes are left alone
+template <class T, size_t N>
+constexpr void mark_value_bytes(std::array<uint8_t, N>& mask, size_t at) noexcept {
+   if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+      for (size_t i = 0; i < sizeof(T); ++i) mask[at + i] = 0xFF;
+   }
+   else if constexpr (is_std_array_v<T>) {
+      using E = typename T::value_type;
+      for (size_t i = 0; i < std::tuple_size_v<T>; ++i) mark_value_bytes<E>(mask, at + i * sizeof(E));
+   }
+   else {
+      [&]<size_t... I>(std::index_sequence<I...>) {
+         (mark_value_bytes<field_type<T, I>>(mask, at + struct_layout<T>::offsets[I]), ...);
+      }(std::make_index_sequence<struct_layout<T>::count>{});
+   }
+}
+
+} // namespace detail
+
+// For fixed types whose native layout is the wire layout (native_wire_stride): 0xFF over
+// value bytes and 0x00 over internal and tail padding, so `native bytes & mask` is the
+// wire encoding ("Zero-Padding Rule")
+template <class T>
+constexpr std::array<uint8_t, sizeof(T)> padding_mask() noexcept {
+   static_assert(native_wire_stride<T>(), "padding_mask needs the native layout to match the wire layout");
+   std::array<uint8_t, sizeof(T)> mask{};
+   detail::mark_value_bytes<T>(mask, 0);
+   return mask;
+}
+
+// True when a fixed type's wire bytes hold no padding, so a memcpy of its native bytes
+// is exactly its wire encoding
+template <class T>
+constexpr bool padding_free() noexcept {
+   if constexpr (!native_wire_stride<T>()) {
+      return false;
+   }
+   else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+      return true;
+   }
+   else if constexpr (detail::is_std_array_v<T>) {
+      return padding_free<typename T::value_type>();
+   }
+   else {
+      for (const uint8_t byte : padding_mask<T>()) {
+         if (byte != 0xFF) return false;
+      }
+      return true;
+   }
+}
+
+} // namespace zmem
@@ -0,0 +1,216 @@
+// ZMEM Payload-Size Sweep
+// Write, read and zero-copy throughput from 64 B to 1 GB messages across shapes
+// (zmem_fixtures.hpp "Synthetic Shapes"). One bencher stage per shape and operation,
+// charted with the sizes on the x axis.
+//
+// Usage: zmem_sweep_bench [max_size_mb=1024]
+//
+// Peak memory is roughly 4x the largest message (source object, buffer, decoded copy).
+
+#include "bencher/bencher.hpp"
+#include "bencher/diagnostics.hpp"
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_fixtures.hpp"
+#include "zmem_layout.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Zero-Copy Accessors
+// ============================================================================
+
+// Each reads one randomly chosen element in place, selected by `r`
+
+constexpr zmem::vector_field ticks_field{0, sizeof(Tick)};
+constexpr zmem::vector_field doubles_field{0, sizeof(double)};
+constexpr zmem::vector_field strings_field{0, 0};
+constexpr zmem::vector_field groups_field{0, 0};
+constexpr zmem::vector_field leaves_field{0, 0}; // Within a DeepGroup element
+constexpr zmem::vector_field values_field{8, sizeof(double)}; // Within a DeepLeaf element
+constexpr zmem::vector_field map_entries_field{0, 16}; // map<u64, f64> entries: {key, value}
+constexpr zmem::vector_field records_field{8, 0};
+
+uint64_t vector_count(std::string_view message, const zmem::vector_field& field) {
+   zmem::vector_ref ref;
+   return zmem::read_vector_ref(message, field, ref) ? ref.count : 0;
+}
+
+uint64_t load_at(std::string_view bytes, size_t offset) {
+   return bytes.size() >= offset + 8 ? zmem::detail::load_u64(bytes.data() + offset) : 0;
+}
+
+uint64_t access_fixed(std::string_view message, uint64_t r) {
+   const uint64_t count = vector_count(message, ticks_field);
+   return count ? load_at(zmem::element(message, ticks_field, r % count), 0) : 0;
+}
+
+uint64_t access_vector(std::string_view message, uint64_t r) {
+   const uint64_t count = vector_count(message, doubles_field);
+   return count ? load_at(zmem::element(message, doubles_field, r % count), 0) : 0;
+}
+
+uint64_t access_string(std::string_view message, uint64_t r) {
+   const uint64_t count = vector_count(message, strings_field);
+   return count ? zmem::element(message, strings_field, r % count).size() : 0;
+}
+
+// Three offset table lookups: group, leaf, value
+uint64_t access_deep(std::string_view message, uint64_t r) {
+   const uint64_t groups = vector_count(message, groups_field);
+   if (!groups) return 0;
+   const std::string_view group = zmem::element(message, groups_field, r % groups);
+   const uint64_t leaves = vector_count(group, leaves_field);
+   if (!leaves) return 0;
+   const std::string_view leaf = zmem::element(group, leaves_field, (r >> 20) % leaves);
+   const uint64_t values = vector_count(leaf, values_field);
+   return values ? load_at(zmem::element(leaf, values_field, (r >> 40) % values), 0) : 0;
+}
+
+// Binary search over the sorted entries of a fixed map
+uint64_t access_map(std::string_view message, uint64_t r) {
+   const uint64_t count = vector_count(message, map_entries_field);
+   if (!count) return 0;
+   const uint64_t key = (r % count) * 2;
+   uint64_t lo = 0;
+   uint64_t hi = count;
+   while (lo < hi) {
+      const uint64_t mid = lo + (hi - lo) / 2;
+      if (load_at(zmem::element(message, map_entries_field, mid), 0) < key) {
+         lo = mid + 1;
+      }
+      else {
+         hi = mid;
+      }
+   }
+   return lo < count ? load_at(zmem::element(message, map_entries_field, lo), 8) : 0;
+}
+
+uint64_t access_dataset(std::string_view message, uint64_t r) {
+   const uint64_t count = vector_count(message, records_field);
+   if (!count) return 0;
+   const std::string_view record = zmem::element(message, records_field, r % count);
+   if (record.empty()) return 0;
+   glz::lazy_zmem_view<Record> view{record};
+   return static_cast<uint64_t>(view.get<0>());
+}
+
+// ============================================================================
+// Sweep
+// ============================================================================
+
+std::string size_label(size_t bytes) {
+   if (bytes >= (size_t(1) << 30)) return std::to_string(bytes >> 30) + " GB";
+   if (bytes >= (size_t(1) << 20)) return std::to_string(bytes >> 20) + " MB";
+   if (bytes >= (size_t(1) << 10)) return std::to_string(bytes >> 10) + " KB";
+   return std::to_string(bytes) + " B";
+}
+
+void save_stage(bencher::stage& stage, const std::string& file_stem, std::string& markdown) {
+   bencher::print_results(stage);
+   markdown += bencher::to_markdown(stage);
+   markdown += "\n";
+
+   chart_config cfg;
+   cfg.margin_bottom = 100;
+   cfg.font_size_bar_label = 14.0;
+   cfg.y_axis_label = stage.throughput_units_label;
+   bencher::save_file(bencher::bar_chart(stage, cfg), file_stem + ".svg");
+}
+
+// Runs every size of one shape. Small messages are processed in batches of ~1 MB so
+// each measurement is long enough to time.
+template <class T, class Make>
+bool sweep_shape(const std::string& shape, const std::string& file_stem, Make&& make,
+                 uint64_t (*access)(std::string_view, uint64_t), const std::vector<size_t>& sizes,
+                 std::string& markdown) {
+   bencher::stage write_stage{shape + ": write_zmem"};
+   bencher::stage read_stage{shape + ": read_zmem"};
+   bencher::stage view_stage{shape + ": zero-copy element access"};
+   view_stage.throughput_units_divisor = 1e3;
+   view_stage.throughput_units_label = "Kops/s";
+   view_stage.processed_units_label = "Ops";
+   view_stage.cold_cache = false;
+
+   std::cout << "\n" << shape << "\n";
+   for (const size_t target : sizes) {
+      const std::string label = size_label(target);
+      T value = make(target);
+      std::string buffer;
+      if (auto ec = glz::write_zmem(value, buffer); ec) {
+         std::cerr << "ZMEM write error: " << glz::format_error(ec, buffer) << "\n";
+         return false;
+      }
+      std::cout << "  " << label << ": " << buffer.size() << " bytes\n";
+      const size_t batch = std::max<size_t>(1, (size_t(1) << 20) / std::max<size_t>(1, buffer.size()));
+
+      std::string write_buffer;
+      write_buffer.reserve(buffer.size());
+      write_stage.run(label, [&] {
+         for (size_t i = 0; i < batch; ++i) {
+            (void)glz::write_zmem(value, write_buffer);
+            bencher::do_not_optimize(write_buffer);
+         }
+         return batch * write_buffer.size();
+      });
+
+      T decoded{};
+      read_stage.run(label, [&] {
+         for (size_t i = 0; i < batch; ++i) {
+            (void)glz::read_zmem(decoded, buffer);
+            bencher::do_not_optimize(decoded);
+         }
+         return batch * buffer.size();
+      });
+
+      constexpr size_t view_batch = 16 * 1024;
+      view_stage.run(label, [&] {
+         uint64_t state = 0x9E3779B97F4A7C15ull;
+         for (size_t i = 0; i < view_batch; ++i) state = mix(state + access(buffer, state));
+         volatile uint64_t sink = state;
+         bencher::do_not_optimize(sink);
+         return view_batch;
+      });
+   }
+
+   save_stage(write_stage, "sweep_" + file_stem + "_write", markdown);
+   save_stage(read_stage, "sweep_" + file_stem + "_read", markdown);
+   save_stage(view_stage, "sweep_" + file_stem + "_zero_copy", markdown);
+   return true;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t max_mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+
+   // 64 B to max_size_mb in steps of 4x
+   std::vector<size_t> sizes;
+   for (size_t bytes = 64; bytes <= (max_mb << 20); bytes *= 4) sizes.push_back(bytes);
+   if (sizes.empty() || sizes.back() != (max_mb << 20)) sizes.push_back(max_mb << 20);
+
+   std::cout << "ZMEM Payload-Size Sweep\n";
+   std::cout << "=======================\n";
+
+   std::string markdown;
+   const bool ok =
+      sweep_shape<FixedShape>("Fixed structs [Tick]", "fixed", make_fixed_shape, access_fixed, sizes, markdown) &&
+      sweep_shape<VectorShape>("Vector-heavy", "vector", make_vector_shape, access_vector, sizes, markdown) &&
+      sweep_shape<StringShape>("String-heavy [string]", "string", make_string_shape, access_string, sizes,
+                               markdown) &&
+      sweep_shape<DeepShape>("Deep nesting (3 levels)", "deep", make_deep_shape, access_deep, sizes, markdown) &&
+      sweep_shape<MapShape>("map<u64, f64>", "map", make_map_shape, access_map, sizes, markdown) &&
+      sweep_shape<Dataset>("[VariableStruct] (Record)", "records", make_dataset, access_dataset, sizes, markdown);
+   if (!ok) return 1;
+
+   bencher::save_file(markdown, "sweep_results.md");
+   return 0;
+}
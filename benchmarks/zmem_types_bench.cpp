@@ -0,0 +1,404 @@
+// ZMEM Map, Union, Optional and Enum Benchmark
+// Encode/decode cost of the non-struct types: std::map and std::unordered_map as ZMEM
+// maps (including the sort an unordered source needs), zero-copy map lookup by binary
+// search, std::variant unions, std::optional / glz::zmem::optional fields and enums.
+//
+// Usage: zmem_types_bench [elements=10000] [iterations=200]
+
+#include "glaze/zmem.hpp"
+
+#include "zmem_alloc_counter.hpp"
+#include "zmem_layout.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// ============================================================================
+// Test Data Structures
+// ============================================================================
+
+// map<u64, f64> from either source container; both write the same sorted entries
+struct OrderedMapMessage {
+   std::map<uint64_t, double> values{};
+};
+
+struct HashMapMessage {
+   std::unordered_map<uint64_t, double> values{};
+};
+
+// map<u32, string>: variable map, entries {key, pad, offset, count}
+struct StringMapMessage {
+   std::map<uint32_t, std::string> names{};
+};
+
+// Unions: a fixed union (no vectors in any variant) and a variable one
+struct Fill {
+   uint64_t order_id{};
+   int64_t price{};
+   uint32_t quantity{};
+};
+
+struct Cancel {
+   uint64_t order_id{};
+};
+
+struct Reject {
+   uint64_t order_id{};
+   int32_t code{};
+   std::string reason{};
+};
+
+struct FixedEventLog {
+   std::vector<std::variant<Fill, Cancel>> events{};
+};
+
+struct EventLog {
+   std::vector<std::variant<Fill, Cancel, Reject>> events{};
+};
+
+// Optionals: the same reading with plain, std::optional and ZMEM optional fields
+struct PlainReading {
+   uint64_t id{};
+   double value{};
+   uint32_t quality{};
+   int64_t offset_ns{};
+};
+
+struct StdOptionalReading {
+   uint64_t id{};
+   std::optional<double> value{};
+   std::optional<uint32_t> quality{};
+   std::optional<int64_t> offset_ns{};
+};
+
+struct ZmemOptionalReading {
+   uint64_t id{};
+   glz::zmem::optional<double> value{};
+   glz::zmem::optional<uint32_t> quality{};
+   glz::zmem::optional<int64_t> offset_ns{};
+};
+
+template <class Reading>
+struct ReadingLog {
+   std::vector<Reading> readings{};
+};
+
+// Enums inside a fixed struct
+enum class Side : uint8_t { buy = 0, sell = 1 };
+
+enum class OrderStatus : uint8_t { open = 0, partially_filled = 1, filled = 2, cancelled = 3, rejected = 4 };
+
+struct Order {
+   uint64_t id{};
+   int64_t price{};
+   uint32_t quantity{};
+   Side side{};
+   OrderStatus status{};
+};
+
+struct OrderLog {
+   std::vector<Order> orders{};
+};
+
+// ============================================================================
+// Test Data Initialization
+// ============================================================================
+
+// Odd keys only, so lookups of even keys miss
+inline uint64_t map_key(size_t i) { return i * 2 + 1; }
+
+OrderedMapMessage make_ordered_map(size_t n) {
+   OrderedMapMessage m;
+   for (size_t i = 0; i < n; ++i) m.values.emplace(map_key(i), static_cast<double>(i) * 0.5);
+   return m;
+}
+
+HashMapMessage make_hash_map(size_t n) {
+   HashMapMessage m;
+   m.values.reserve(n);
+   for (size_t i = 0; i < n; ++i) m.values.emplace(map_key(i), static_cast<double>(i) * 0.5);
+   return m;
+}
+
+StringMapMessage make_string_map(size_t n) {
+   StringMapMessage m;
+   for (size_t i = 0; i < n; ++i) m.names.emplace(uint32_t(map_key(i)), "symbol-" + std::to_string(i));
+   return m;
+}
+
+// 70% fills, 25% cancels, 5% rejects (cancels in the fixed log)
+template <class Log>
+Log make_event_log(size_t n) {
+   constexpr bool rejects = std::is_same_v<Log, EventLog>;
+   Log log;
+   log.events.reserve(n);
+   std::mt19937_64 rng{42};
+   for (size_t i = 0; i < n; ++i) {
+      const uint64_t r = rng() % 100;
+      if (r < 70) {
+         log.events.emplace_back(Fill{i, int64_t(1'000'000 + rng() % 1000), uint32_t(1 + rng() % 500)});
+      }
+      else if constexpr (rejects) {
+         if (r < 95) {
+            log.events.emplace_back(Cancel{i});
+         }
+         else {
+            log.events.emplace_back(Reject{i, int32_t(r), "price outside collar"});
+         }
+      }
+      else {
+         log.events.emplace_back(Cancel{i});
+      }
+   }
+   return log;
+}
+
+// Each optional field present with probability `present_percent`
+template <class Reading>
+ReadingLog<Reading> make_readings(size_t n, uint32_t present_percent) {
+   ReadingLog<Reading> log;
+   log.readings.resize(n);
+   std::mt19937_64 rng{42};
+   for (size_t i = 0; i < n; ++i) {
+      Reading& r = log.readings[i];
+      r.id = i;
+      const double value = static_cast<double>(rng() % 10000) * 0.01;
+      const uint32_t quality = uint32_t(rng() % 100);
+      const int64_t offset_ns = int64_t(rng() % 2000) - 1000;
+      if constexpr (std::is_same_v<Reading, PlainReading>) {
+         r.value = value;
+         r.quality = quality;
+         r.offset_ns = offset_ns;
+      }
+      else {
+         if (rng() % 100 < present_percent) r.value = value;
+         if (rng() % 100 < present_percent) r.quality = quality;
+         if (rng() % 100 < present_percent) r.offset_ns = offset_ns;
+      }
+   }
+   return log;
+}
+
+OrderLog make_orders(size_t n) {
+   OrderLog log;
+   log.orders.resize(n);
+   std::mt19937_64 rng{42};
+   for (size_t i = 0; i < n; ++i) {
+      log.orders[i] = {i, int64_t(1'000'000 + rng() % 1000), uint32_t(1 + rng() % 500), Side(rng() % 2),
+                       OrderStatus(rng() % 5)};
+   }
+   return log;
+}
+
+// ============================================================================
+// Benchmark Utilities
+// ============================================================================
+
+struct bench_result {
+   double ns{};
+   double allocations{}; // Operator new calls per operation, after warmup
+};
+
+template <typename Func>
+bench_result benchmark(Func&& func, size_t iterations) {
+   // Warmup
+   for (size_t i = 0; i < iterations / 10 + 1; ++i) {
+      func();
+   }
+
+   const zmem::allocation_stats before = zmem::thread_allocations();
+   auto start = std::chrono::high_resolution_clock::now();
+   for (size_t i = 0; i < iterations; ++i) {
+      func();
+   }
+   auto end = std::chrono::high_resolution_clock::now();
+   const zmem::allocation_stats allocated = zmem::thread_allocations() - before;
+
+   auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+   return {static_cast<double>(duration.count()) / static_cast<double>(iterations),
+           static_cast<double>(allocated.allocations) / static_cast<double>(iterations)};
+}
+
+void print_row(const char* type, const char* operation, size_t elements, size_t bytes, const bench_result& r) {
+   std::cout << "| " << type << " | " << operation << " | " << elements << " | " << bytes << " | " << r.ns << " | "
+             << r.ns / static_cast<double>(elements) << " | " << r.allocations << " |\n";
+}
+
+template <class T>
+bool serialize(const T& value, std::string& buffer) {
+   if (auto ec = glz::write_zmem(value, buffer); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, buffer) << "\n";
+      return false;
+   }
+   return true;
+}
+
+// Write into a reused buffer and read into a reused object
+template <class T>
+bool run_write_read(const char* type, const T& value, size_t elements, size_t iterations) {
+   std::string buffer;
+   if (!serialize(value, buffer)) return false;
+   std::string write_buffer;
+   print_row(type, "Write", elements, buffer.size(),
+             benchmark([&] { (void)glz::write_zmem(value, write_buffer); }, iterations));
+   T decoded{};
+   print_row(type, "Read", elements, buffer.size(),
+             benchmark([&] { (void)glz::read_zmem(decoded, buffer); }, iterations));
+   return true;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+   const size_t elements = std::max<size_t>(1, argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000);
+   const size_t iterations = std::max<size_t>(1, argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200);
+   constexpr size_t lookups = 1024; // Per timed operation
+
+   std::cout << "ZMEM Map, Union, Optional and Enum Benchmark\n";
+   std::cout << "============================================\n\n";
+   std::cout << "Elements: " << elements << ", iterations: " << iterations << "\n\n";
+
+   std::cout << std::fixed << std::setprecision(1);
+   std::cout << "| Type | Operation | Elements | Wire size (bytes) | Time (ns) | ns/element | Allocs/op |\n";
+   std::cout << "|------|-----------|----------|-------------------|-----------|------------|-----------|\n";
+
+   // --------------------------------------------------------------------------
+   // Maps
+   // --------------------------------------------------------------------------
+
+   const OrderedMapMessage ordered = make_ordered_map(elements);
+   const HashMapMessage hashed = make_hash_map(elements);
+   const StringMapMessage names = make_string_map(elements);
+
+   std::string map_buffer;
+   std::string hash_buffer;
+   if (!serialize(ordered, map_buffer) || !serialize(hashed, hash_buffer)) return 1;
+   if (hash_buffer != map_buffer) {
+      std::cerr << "std::unordered_map did not serialize to the sorted map<u64, f64> layout\n";
+      return 1;
+   }
+
+   std::string write_buffer;
+   print_row("map<u64, f64>", "Write from std::map", elements, map_buffer.size(),
+             benchmark([&] { (void)glz::write_zmem(ordered, write_buffer); }, iterations));
+   print_row("map<u64, f64>", "Write from std::unordered_map", elements, map_buffer.size(),
+             benchmark([&] { (void)glz::write_zmem(hashed, write_buffer); }, iterations));
+
+   // The part of the unordered write that a sorted source does not pay
+   std::vector<std::pair<uint64_t, double>> sorted;
+   sorted.reserve(elements);
+   print_row("map<u64, f64>", "Sort unordered entries only", elements, map_buffer.size(), benchmark([&] {
+                sorted.assign(hashed.values.begin(), hashed.values.end());
+                std::sort(sorted.begin(), sorted.end());
+             }, iterations));
+
+   OrderedMapMessage ordered_decoded;
+   print_row("map<u64, f64>", "Read into std::map", elements, map_buffer.size(),
+             benchmark([&] { (void)glz::read_zmem(ordered_decoded, map_buffer); }, iterations));
+   HashMapMessage hash_decoded;
+   print_row("map<u64, f64>", "Read into std::unordered_map", elements, map_buffer.size(),
+             benchmark([&] { (void)glz::read_zmem(hash_decoded, map_buffer); }, iterations));
+
+   if (!run_write_read("map<u32, string>", names, elements, iterations)) return 1;
+
+   // Lookups: half hit (odd keys), half miss; rows report time per lookup
+   std::vector<uint64_t> keys(lookups);
+   std::mt19937_64 rng{7};
+   for (auto& k : keys) k = rng() % (elements * 2);
+
+   constexpr zmem::vector_field map_field{0, 16}; // {key:8, value:8}
+   constexpr zmem::vector_field names_field{0, 24}; // {key:4, pad:4, offset:8, count:8}
+   std::string names_buffer;
+   if (!serialize(names, names_buffer)) return 1;
+
+   double sum = 0.0;
+   size_t hits = 0;
+   print_row("map<u64, f64>", "Zero-copy lookup (binary search)", lookups, map_buffer.size(), benchmark([&] {
+                for (const uint64_t k : keys) {
+                   const std::string_view entry = zmem::find_map_entry(map_buffer, map_field, k);
+                   if (!entry.empty()) {
+                      double v;
+                      std::memcpy(&v, entry.data() + 8, 8);
+                      sum += v;
+                   }
+                }
+             }, iterations));
+   print_row("map<u64, f64>", "std::map::find (decoded)", lookups, map_buffer.size(), benchmark([&] {
+                for (const uint64_t k : keys) {
+                   if (auto it = ordered_decoded.values.find(k); it != ordered_decoded.values.end()) sum += it->second;
+                }
+             }, iterations));
+   print_row("map<u64, f64>", "std::unordered_map::find (decoded)", lookups, map_buffer.size(), benchmark([&] {
+                for (const uint64_t k : keys) {
+                   if (auto it = hash_decoded.values.find(k); it != hash_decoded.values.end()) sum += it->second;
+                }
+             }, iterations));
+   print_row("map<u32, string>", "Zero-copy lookup (binary search)", lookups, names_buffer.size(), benchmark([&] {
+                for (const uint64_t k : keys) {
+                   const std::string_view entry = zmem::find_map_entry(names_buffer, names_field, uint32_t(k));
+                   hits += zmem::map_vector_value<uint32_t>(names_buffer, names_field, entry).size();
+                }
+             }, iterations));
+
+   // --------------------------------------------------------------------------
+   // Unions
+   // --------------------------------------------------------------------------
+
+   const auto fixed_events = make_event_log<FixedEventLog>(elements);
+   const auto events = make_event_log<EventLog>(elements);
+   if (!run_write_read("[union Fill|Cancel] (fixed)", fixed_events, elements, iterations)) return 1;
+   if (!run_write_read("[union Fill|Cancel|Reject] (variable)", events, elements, iterations)) return 1;
+
+   // --------------------------------------------------------------------------
+   // Optionals (half of the optional fields present)
+   // --------------------------------------------------------------------------
+
+   if (!run_write_read("[Reading] plain fields", make_readings<PlainReading>(elements, 100), elements, iterations)) {
+      return 1;
+   }
+   if (!run_write_read("[Reading] std::optional fields", make_readings<StdOptionalReading>(elements, 50), elements,
+                       iterations)) {
+      return 1;
+   }
+   if (!run_write_read("[Reading] glz::zmem::optional fields", make_readings<ZmemOptionalReading>(elements, 50),
+                       elements, iterations)) {
+      return 1;
+   }
+
+   // --------------------------------------------------------------------------
+   // Enums
+   // --------------------------------------------------------------------------
+
+   // The spec leaves out-of-range enum values to the reader; checking them is a pass
+   // over the decoded orders
+   const OrderLog orders = make_orders(elements);
+   if (!run_write_read("[Order] with u8 enums", orders, elements, iterations)) return 1;
+   std::string orders_buffer;
+   if (!serialize(orders, orders_buffer)) return 1;
+   OrderLog orders_decoded;
+   print_row("[Order] with u8 enums", "Read + validate", elements, orders_buffer.size(), benchmark([&] {
+                (void)glz::read_zmem(orders_decoded, orders_buffer);
+                for (const Order& o : orders_decoded.orders) {
+                   hits += uint8_t(o.side) > uint8_t(Side::sell) || uint8_t(o.status) > uint8_t(OrderStatus::rejected);
+                }
+             }, iterations));
+
+   std::cout << "\nChecksum: " << static_cast<uint64_t>(sum) + hits << "\n";
+   return 0;
+}
@@ -0,0 +1,779 @@
+// ZMEM vs Cap'n Proto vs FlatBuffers on Realistic Workloads
+// Write, read (decode into native structs) and zero-copy access for the fixtures in
+// zmem_workloads.hpp: an L2 order book update, a game world snapshot and an ML batch.
+// One bencher stage per workload and operation class; results_workload_*.md/.svg.
+//
+// Usage: zmem_workload_bench
+
+#include "bencher/bencher.hpp"
+#include "bencher/diagnostics.hpp"
+
+#include "glaze/zmem.hpp"
+
+// Cap'n Proto
+#include "workloads.capnp.h"
+#include <capnp/message.h>
+#include <capnp/serialize.h>
+#include <kj/io.h>
+
+// FlatBuffers
+#include "workloads_generated.h"
+
+#include "zmem_half.hpp"
+#include "zmem_layout.hpp"
+#include "zmem_workloads.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+inline uint32_t mix_u32(uint32_t x) noexcept {
+   x ^= x << 13;
+   x ^= x >> 17;
+   x ^= x << 5;
+   return x;
+}
+
+// Zero-copy loops make many accesses through one reader; the default traversal limit
+// (64 MB of reads per reader) would stop them partway
+::capnp::ReaderOptions unlimited_reader_options() {
+   ::capnp::ReaderOptions options;
+   options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+   return options;
+}
+
+float bf16_sum(const uint16_t* bits, size_t count) noexcept {
+   float sum = 0.0f;
+   for (size_t i = 0; i < count; ++i) sum += zmem::bf16_to_f32(bits[i]);
+   return sum;
+}
+} // namespace
+
+// ============================================================================
+// ZMEM Layout
+// ============================================================================
+
+// Byte positions from workloads.zmem, for the elements lazy_zmem_view does not index
+
+constexpr zmem::vector_field entities_field{16, 0}; // WorldSnapshot: tick, server_time_ns, entities
+constexpr zmem::vector_field tensors_field{16, 0}; // MlBatch: step, batch_size (+4 padding), tensors
+constexpr zmem::vector_field metadata_field{32, 24}; // map<u32, string> entries: {key, pad, offset, count}
+
+uint64_t vector_count(std::string_view message, const zmem::vector_field& field) {
+   zmem::vector_ref ref;
+   return zmem::read_vector_ref(message, field, ref) ? ref.count : 0;
+}
+
+// ============================================================================
+// L2 Order Book Update
+// ============================================================================
+
+// Access: book imbalance over the top 1..depth levels plus the sequence number
+
+struct order_book_workload {
+   using native = workloads::OrderBookUpdate;
+   using capnp_root = ::OrderBookUpdate;
+   using flatbuffer_root = workloads_fb::OrderBookUpdate;
+   static constexpr const char* name = "Order Book Update";
+   static constexpr const char* file = "order_book";
+
+   static size_t access_zmem(std::string_view buffer, uint32_t selector) {
+      glz::lazy_zmem_view<native> view{buffer};
+      const auto header = view.get<0>();
+      auto bids = view.get<1>();
+      auto asks = view.get<2>();
+      const size_t levels = std::min<size_t>(bids.size(), asks.size());
+      if (levels == 0) return header.sequence;
+      const size_t depth = 1 + selector % levels;
+      int64_t imbalance = 0;
+      for (size_t i = 0; i < depth; ++i) {
+         imbalance += int64_t(bids[i].quantity) - int64_t(asks[i].quantity);
+      }
+      return header.sequence + size_t(imbalance) + size_t(bids[0].price + asks[0].price);
+   }
+
+   static void populate_capnp(::capnp::MessageBuilder& message, const native& value) {
+      auto root = message.initRoot<capnp_root>();
+      auto header = root.initHeader();
+      header.setInstrumentId(value.header.instrument_id);
+      header.setVenue(value.header.venue);
+      header.setFlags(value.header.flags);
+      header.setSequence(value.header.sequence);
+      header.setExchangeTsNs(value.header.exchange_ts_ns);
+      header.setReceiveTsNs(value.header.receive_ts_ns);
+      auto set_levels = [](auto list, const std::vector<workloads::Level>& levels) {
+         for (size_t i = 0; i < levels.size(); ++i) {
+            list[i].setPrice(levels[i].price);
+            list[i].setQuantity(levels[i].quantity);
+            list[i].setOrderCount(levels[i].order_count);
+         }
+      };
+      set_levels(root.initBids(value.bids.size()), value.bids);
+      set_levels(root.initAsks(value.asks.size()), value.asks);
+   }
+
+   static native read_capnp(::capnp::MessageReader& message) {
+      auto root = message.getRoot<capnp_root>();
+      native value;
+      auto header = root.getHeader();
+      value.header = {header.getInstrumentId(), header.getVenue(),        header.getFlags(),
+                      header.getSequence(),     header.getExchangeTsNs(), header.getReceiveTsNs()};
+      auto get_levels = [](auto list, std::vector<workloads::Level>& levels) {
+         levels.resize(list.size());
+         for (size_t i = 0; i < levels.size(); ++i) {
+            levels[i] = {list[i].getPrice(), list[i].getQuantity(), list[i].getOrderCount()};
+         }
+      };
+      get_levels(root.getBids(), value.bids);
+      get_levels(root.getAsks(), value.asks);
+      return value;
+   }
+
+   static size_t access_capnp(::capnp::MessageReader& message, uint32_t selector) {
+      auto root = message.getRoot<capnp_root>();
+      const size_t sequence = root.getHeader().getSequence();
+      auto bids = root.getBids();
+      auto asks = root.getAsks();
+      const size_t levels = std::min<size_t>(bids.size(), asks.size());
+      if (levels == 0) return sequence;
+      const size_t depth = 1 + selector % levels;
+      int64_t imbalance = 0;
+      for (size_t i = 0; i < depth; ++i) {
+         imbalance += int64_t(bids[i].getQuantity()) - int64_t(asks[i].getQuantity());
+      }
+      return sequence + size_t(imbalance) + size_t(bids[0].getPrice() + asks[0].getPrice());
+   }
+
+   static flatbuffers::Offset<flatbuffer_root> build_flatbuffer(flatbuffers::FlatBufferBuilder& builder,
+                                                                const native& value) {
+      auto levels = [&](const std::vector<workloads::Level>& source) {
+         workloads_fb::Level* out = nullptr;
+         auto offset = builder.CreateUninitializedVectorOfStructs(source.size(), &out);
+         for (size_t i = 0; i < source.size(); ++i) {
+            out[i] = workloads_fb::Level(source[i].price, source[i].quantity, source[i].order_count);
+         }
+         return offset;
+      };
+      auto bids = levels(value.bids);
+      auto asks = levels(value.asks);
+      const workloads_fb::BookHeader header(value.header.instrument_id, value.header.venue, value.header.flags,
+                                            value.header.sequence, value.header.exchange_ts_ns,
+                                            value.header.receive_ts_ns);
+      return workloads_fb::CreateOrderBookUpdate(builder, &header, bids, asks);
+   }
+
+   static native read_flatbuffer(const flatbuffer_root* fb) {
+      native value;
+      if (auto header = fb->header()) {
+         value.header = {header->instrument_id(), header->venue(),          header->flags(),
+                         header->sequence(),      header->exchange_ts_ns(), header->receive_ts_ns()};
+      }
+      auto get_levels = [](auto list, std::vector<workloads::Level>& levels) {
+         if (!list) return;
+         levels.reserve(list->size());
+         for (const auto* level : *list) levels.push_back({level->price(), level->quantity(), level->order_count()});
+      };
+      get_levels(fb->bids(), value.bids);
+      get_levels(fb->asks(), value.asks);
+      return value;
+   }
+
+   static size_t access_flatbuffer(const flatbuffer_root* fb, uint32_t selector) {
+      const size_t sequence = fb->header() ? fb->header()->sequence() : 0;
+      auto bids = fb->bids();
+      auto asks = fb->asks();
+      if (!bids || !asks) return sequence;
+      const size_t levels = std::min<size_t>(bids->size(), asks->size());
+      if (levels == 0) return sequence;
+      const size_t depth = 1 + selector % levels;
+      int64_t imbalance = 0;
+      for (size_t i = 0; i < depth; ++i) {
+         imbalance += int64_t(bids->Get(i)->quantity()) - int64_t(asks->Get(i)->quantity());
+      }
+      return sequence + size_t(imbalance) + size_t(bids->Get(0)->price() + asks->Get(0)->price());
+   }
+};
+
+// ============================================================================
+// Game World Snapshot
+// ============================================================================
+
+// Access: one random entity's position and health, distance to one of its waypoints,
+// and the sizes of its name and inventory
+
+struct world_snapshot_workload {
+   using native = workloads::WorldSnapshot;
+   using capnp_root = ::WorldSnapshot;
+   using flatbuffer_root = workloads_fb::WorldSnapshot;
+   static constexpr const char* name = "World Snapshot";
+   static constexpr const char* file = "world_snapshot";
+
+   static size_t access_zmem(std::string_view buffer, uint32_t selector) {
+      const uint64_t count = vector_count(buffer, entities_field);
+      if (count == 0) return 0;
+      const std::string_view element = zmem::element(buffer, entities_field, selector % count);
+      if (element.empty()) return 0;
+      glz::lazy_zmem_view<workloads::Entity> entity{element};
+      const auto transform = entity.get<5>();
+      float distance = entity.get<4>();
+      auto waypoints = entity.get<8>();
+      if (waypoints.size() > 0) {
+         const auto w = waypoints[(selector >> 8) % waypoints.size()];
+         distance += std::abs(w.x - transform.position.x) + std::abs(w.y - transform.position.y);
+      }
+      return size_t(distance) + entity.get<7>().size() + entity.get<9>().size();
+   }
+
+   static void populate_capnp(::capnp::MessageBuilder& message, const native& value) {
+      auto root = message.initRoot<capnp_root>();
+      root.setTick(value.tick);
+      root.setServerTimeNs(value.server_time_ns);
+      auto entities = root.initEntities(value.entities.size());
+      for (size_t i = 0; i < value.entities.size(); ++i) {
+         const workloads::Entity& source = value.entities[i];
+         auto e = entities[i];
+         e.setId(source.id);
+         e.setKind(source.kind);
+         e.setTeam(source.team);
+         e.setFlags(source.flags);
+         e.setHealth(source.health);
+         auto transform = e.initTransform();
+         auto position = transform.initPosition();
+         position.setX(source.transform.position.x);
+         position.setY(source.transform.position.y);
+         position.setZ(source.transform.position.z);
+         auto rotation = transform.initRotation();
+         rotation.setX(source.transform.rotation.x);
+         rotation.setY(source.transform.rotation.y);
+         rotation.setZ(source.transform.rotation.z);
+         rotation.setW(source.transform.rotation.w);
+         auto velocity = e.initVelocity();
+         velocity.setX(source.velocity.x);
+         velocity.setY(source.velocity.y);
+         velocity.setZ(source.velocity.z);
+         e.setName(source.name);
+         auto waypoints = e.initWaypoints(source.waypoints.size());
+         for (size_t k = 0; k < source.waypoints.size(); ++k) {
+            waypoints[k].setX(source.waypoints[k].x);
+            waypoints[k].setY(source.waypoints[k].y);
+            waypoints[k].setZ(source.waypoints[k].z);
+         }
+         auto inventory = e.initInventory(source.inventory.size());
+         for (size_t k = 0; k < source.inventory.size(); ++k) {
+            inventory[k].setItemId(source.inventory[k].item_id);
+            inventory[k].setCount(source.inventory[k].count);
+            inventory[k].setDurability(source.inventory[k].durability);
+         }
+      }
+   }
+
+   static native read_capnp(::capnp::MessageReader& message) {
+      auto root = message.getRoot<capnp_root>();
+      native value;
+      value.tick = root.getTick();
+      value.server_time_ns = root.getServerTimeNs();
+      auto entities = root.getEntities();
+      value.entities.resize(entities.size());
+      for (size_t i = 0; i < entities.size(); ++i) {
+         auto e = entities[i];
+         workloads::Entity& out = value.entities[i];
+         out.id = e.getId();
+         out.kind = e.getKind();
+         out.team = e.getTeam();
+         out.flags = e.getFlags();
+         out.health = e.getHealth();
+         auto position = e.getTransform().getPosition();
+         auto rotation = e.getTransform().getRotation();
+         out.transform = {{position.getX(), position.getY(), position.getZ()},
+                          {rotation.getX(), rotation.getY(), rotation.getZ(), rotation.getW()}};
+         auto velocity = e.getVelocity();
+         out.velocity = {velocity.getX(), velocity.getY(), velocity.getZ()};
+         out.name = std::string(e.getName());
+         for (auto w : e.getWaypoints()) out.waypoints.push_back({w.getX(), w.getY(), w.getZ()});
+         for (auto item : e.getInventory()) {
+            out.inventory.push_back({item.getItemId(), item.getCount(), item.getDurability()});
+         }
+      }
+      return value;
+   }
+
+   static size_t access_capnp(::capnp::MessageReader& message, uint32_t selector) {
+      auto entities = message.getRoot<capnp_root>().getEntities();
+      if (entities.size() == 0) return 0;
+      auto entity = entities[selector % entities.size()];
+      auto position = entity.getTransform().getPosition();
+      float distance = entity.getHealth();
+      auto waypoints = entity.getWaypoints();
+      if (waypoints.size() > 0) {
+         auto w = waypoints[(selector >> 8) % waypoints.size()];
+         distance += std::abs(w.getX() - position.getX()) + std::abs(w.getY() - position.getY());
+      }
+      return size_t(distance) + entity.getName().size() + entity.getInventory().size();
+   }
+
+   static flatbuffers::Offset<flatbuffer_root> build_flatbuffer(flatbuffers::FlatBufferBuilder& builder,
+                                                                const native& value) {
+      std::vector<flatbuffers::Offset<workloads_fb::Entity>> entities;
+      entities.reserve(value.entities.size());
+      for (const workloads::Entity& source : value.entities) {
+         auto name = builder.CreateString(source.name);
+         workloads_fb::Vec3* waypoint_data = nullptr;
+         auto waypoints = builder.CreateUninitializedVectorOfStructs(source.waypoints.size(), &waypoint_data);
+         for (size_t k = 0; k < source.waypoints.size(); ++k) {
+            const workloads::Vec3& w = source.waypoints[k];
+            waypoint_data[k] = workloads_fb::Vec3(w.x, w.y, w.z);
+         }
+         workloads_fb::Item* item_data = nullptr;
+         auto inventory = builder.CreateUninitializedVectorOfStructs(source.inventory.size(), &item_data);
+         for (size_t k = 0; k < source.inventory.size(); ++k) {
+            const workloads::Item& item = source.inventory[k];
+            item_data[k] = workloads_fb::Item(item.item_id, item.count, item.durability);
+         }
+         const auto& p = source.transform.position;
+         const auto& r = source.transform.rotation;
+         const workloads_fb::Transform transform(workloads_fb::Vec3(p.x, p.y, p.z),
+                                                 workloads_fb::Quat(r.x, r.y, r.z, r.w));
+         const workloads_fb::Vec3 velocity(source.velocity.x, source.velocity.y, source.velocity.z);
+         entities.push_back(workloads_fb::CreateEntity(builder, source.id, source.kind, source.team, source.flags,
+                                                       source.health, &transform, &velocity, name, waypoints,
+                                                       inventory));
+      }
+      auto entity_vector = builder.CreateVector(entities);
+      return workloads_fb::CreateWorldSnapshot(builder, value.tick, value.server_time_ns, entity_vector);
+   }
+
+   static native read_flatbuffer(const flatbuffer_root* fb) {
+      native value;
+      value.tick = fb->tick();
+      value.server_time_ns = fb->server_time_ns();
+      auto entities = fb->entities();
+      if (!entities) return value;
+      value.entities.resize(entities->size());
+      for (size_t i = 0; i < entities->size(); ++i) {
+         const auto* e = entities->Get(i);
+         workloads::Entity& out = value.entities[i];
+         out.id = e->id();
+         out.kind = e->kind();
+         out.team = e->team();
+         out.flags = e->flags();
+         out.health = e->health();
+         if (const auto* t = e->transform()) {
+            const auto& p = t->position();
+            const auto& r = t->rotation();
+            out.transform = {{p.x(), p.y(), p.z()}, {r.x(), r.y(), r.z(), r.w()}};
+         }
+         if (const auto* v = e->velocity()) out.velocity = {v->x(), v->y(), v->z()};
+         if (e->name()) out.name = e->name()->str();
+         if (auto waypoints = e->waypoints()) {
+            for (const auto* w : *waypoints) out.waypoints.push_back({w->x(), w->y(), w->z()});
+         }
+         if (auto inventory = e->inventory()) {
+            for (const auto* item : *inventory) {
+               out.inventory.push_back({item->item_id(), item->count(), item->durability()});
+            }
+         }
+      }
+      return value;
+   }
+
+   static size_t access_flatbuffer(const flatbuffer_root* fb, uint32_t selector) {
+      auto entities = fb->entities();
+      if (!entities || entities->size() == 0) return 0;
+      const auto* entity = entities->Get(selector % entities->size());
+      float distance = entity->health();
+      const auto* transform = entity->transform();
+      auto waypoints = entity->waypoints();
+      if (transform && waypoints && waypoints->size() > 0) {
+         const auto* w = waypoints->Get((selector >> 8) % waypoints->size());
+         distance += std::abs(w->x() - transform->position().x()) + std::abs(w->y() - transform->position().y());
+      }
+      size_t checksum = size_t(distance);
+      if (entity->name()) checksum += entity->name()->size();
+      if (entity->inventory()) checksum += entity->inventory()->size();
+      return checksum;
+   }
+};
+
+// ============================================================================
+// ML Batch
+// ============================================================================
+
+// Access: widen one row of a random tensor from bf16 and sum it, then look up one
+// metadata string by key
+
+struct ml_batch_workload {
+   using native = workloads::MlBatch;
+   using capnp_root = ::MlBatch;
+   using flatbuffer_root = workloads_fb::MlBatch;
+   static constexpr const char* name = "ML Batch";
+   static constexpr const char* file = "ml_batch";
+
+   // Keys written by make_ml_batch are i * 7 + 1
+   static uint32_t metadata_key(uint32_t selector) noexcept { return ((selector >> 12) % 16) * 7 + 1; }
+
+   static size_t access_zmem(std::string_view buffer, uint32_t selector) {
+      size_t checksum = 0;
+      const uint64_t count = vector_count(buffer, tensors_field);
+      if (count > 0) {
+         const std::string_view element = zmem::element(buffer, tensors_field, selector % count);
+         if (!element.empty()) {
+            glz::lazy_zmem_view<workloads::Tensor> tensor{element};
+            auto shape = tensor.get<1>();
+            auto values = tensor.get<2>();
+            const size_t rows = shape.size() > 0 && shape[0] > 0 ? shape[0] : 1;
+            const size_t row_size = values.size() / rows;
+            const size_t row = (selector >> 4) % rows;
+            checksum += size_t(std::abs(bf16_sum(values.data() + row * row_size, row_size)));
+         }
+      }
+      const std::string_view entry = zmem::find_map_entry(buffer, metadata_field, metadata_key(selector));
+      const std::string_view text = zmem::map_vector_value<uint32_t>(buffer, metadata_field, entry);
+      checksum += text.size();
+      if (!text.empty()) checksum += static_cast<unsigned char>(text[selector % text.size()]);
+      return checksum;
+   }
+
+   static void populate_capnp(::capnp::MessageBuilder& message, const native& value) {
+      auto root = message.initRoot<capnp_root>();
+      root.setStep(value.step);
+      root.setBatchSize(value.batch_size);
+      auto tensors = root.initTensors(value.tensors.size());
+      for (size_t i = 0; i < value.tensors.size(); ++i) {
+         const workloads::Tensor& source = value.tensors[i];
+         auto t = tensors[i];
+         t.setName(source.name);
+         auto shape = t.initShape(source.shape.size());
+         for (size_t k = 0; k < source.shape.size(); ++k) shape.set(k, source.shape[k]);
+         auto values = t.initValues(source.values.size());
+         for (size_t k = 0; k < source.values.size(); ++k) values.set(k, source.values[k]);
+      }
+      auto metadata = root.initMetadata(value.metadata.size());
+      size_t i = 0;
+      for (const auto& [key, text] : value.metadata) {
+         metadata[i].setKey(key);
+         metadata[i].setValue(text);
+         ++i;
+      }
+   }
+
+   static native read_capnp(::capnp::MessageReader& message) {
+      auto root = message.getRoot<capnp_root>();
+      native value;
+      value.step = root.getStep();
+      value.batch_size = root.getBatchSize();
+      auto tensors = root.getTensors();
+      value.tensors.resize(tensors.size());
+      for (size_t i = 0; i < tensors.size(); ++i) {
+         auto t = tensors[i];
+         workloads::Tensor& out = value.tensors[i];
+         out.name = std::string(t.getName());
+         auto shape = t.getShape();
+         out.shape.resize(shape.size());
+         for (size_t k = 0; k < shape.size(); ++k) out.shape[k] = shape[k];
+         auto values = t.getValues();
+         out.values.resize(values.size());
+         for (size_t k = 0; k < values.size(); ++k) out.values[k] = values[k];
+      }
+      for (auto entry : root.getMetadata()) {
+         value.metadata.emplace_hint(value.metadata.end(), entry.getKey(), std::string(entry.getValue()));
+      }
+      return value;
+   }
+
+   static size_t access_capnp(::capnp::MessageReader& message, uint32_t selector) {
+      auto root = message.getRoot<capnp_root>();
+      size_t checksum = 0;
+      auto tensors = root.getTensors();
+      if (tensors.size() > 0) {
+         auto tensor = tensors[selector % tensors.size()];
+         auto shape = tensor.getShape();
+         auto values = tensor.getValues();
+         const size_t rows = shape.size() > 0 && shape[0] > 0 ? shape[0] : 1;
+         const size_t row_size = values.size() / rows;
+         const size_t row = (selector >> 4) % rows;
+         float sum = 0.0f;
+         for (size_t k = 0; k < row_size; ++k) sum += zmem::bf16_to_f32(values[row * row_size + k]);
+         checksum += size_t(std::abs(sum));
+      }
+      // Binary search over the sorted entry list
+      auto metadata = root.getMetadata();
+      const uint32_t key = metadata_key(selector);
+      size_t lo = 0;
+      size_t hi = metadata.size();
+      while (lo < hi) {
+         const size_t mid = lo + (hi - lo) / 2;
+         if (metadata[mid].getKey() < key) {
+            lo = mid + 1;
+         }
+         else {
+            hi = mid;
+         }
+      }
+      if (lo < metadata.size() && metadata[lo].getKey() == key) {
+         kj::StringPtr text = metadata[lo].getValue();
+         checksum += text.size();
+         if (text.size() > 0) checksum += static_cast<unsigned char>(text.cStr()[selector % text.size()]);
+      }
+      return checksum;
+   }
+
+   static flatbuffers::Offset<flatbuffer_root> build_flatbuffer(flatbuffers::FlatBufferBuilder& builder,
+                                                                const native& value) {
+      std::vector<flatbuffers::Offset<workloads_fb::Tensor>> tensors;
+      tensors.reserve(value.tensors.size());
+      for (const workloads::Tensor& source : value.tensors) {
+         auto name = builder.CreateString(source.name);
+         auto shape = builder.CreateVector(source.shape);
+         auto values = builder.CreateVector(source.values);
+         tensors.push_back(workloads_fb::CreateTensor(builder, name, shape, values));
+      }
+      // std::map iterates in key order, which LookupByKey requires
+      std::vector<flatbuffers::Offset<workloads_fb::MetadataEntry>> metadata;
+      metadata.reserve(value.metadata.size());
+      for (const auto& [key, text] : value.metadata) {
+         metadata.push_back(workloads_fb::CreateMetadataEntry(builder, key, builder.CreateString(text)));
+      }
+      auto tensor_vector = builder.CreateVector(tensors);
+      auto metadata_vector = builder.CreateVector(metadata);
+      return workloads_fb::CreateMlBatch(builder, value.step, value.batch_size, tensor_vector, metadata_vector);
+   }
+
+   static native read_flatbuffer(const flatbuffer_root* fb) {
+      native value;
+      value.step = fb->step();
+      value.batch_size = fb->batch_size();
+      if (auto tensors = fb->tensors()) {
+         value.tensors.resize(tensors->size());
+         for (size_t i = 0; i < tensors->size(); ++i) {
+            const auto* t = tensors->Get(i);
+            workloads::Tensor& out = value.tensors[i];
+            if (t->name()) out.name = t->name()->str();
+            if (auto shape = t->shape()) out.shape.assign(shape->begin(), shape->end());
+            if (auto values = t->values()) out.values.assign(values->data(), values->data() + values->size());
+         }
+      }
+      if (auto metadata = fb->metadata()) {
+         for (const auto* entry : *metadata) {
+            value.metadata.emplace_hint(value.metadata.end(), entry->key(),
+                                        entry->value() ? entry->value()->str() : std::string{});
+         }
+      }
+      return value;
+   }
+
+   static size_t access_flatbuffer(const flatbuffer_root* fb, uint32_t selector) {
+      size_t checksum = 0;
+      auto tensors = fb->tensors();
+      if (tensors && tensors->size() > 0) {
+         const auto* tensor = tensors->Get(selector % tensors->size());
+         auto shape = tensor->shape();
+         auto values = tensor->values();
+         if (values) {
+            const size_t rows = shape && shape->size() > 0 && shape->Get(0) > 0 ? shape->Get(0) : 1;
+            const size_t row_size = values->size() / rows;
+            const size_t row = (selector >> 4) % rows;
+            checksum += size_t(std::abs(bf16_sum(values->data() + row * row_size, row_size)));
+         }
+      }
+      if (auto metadata = fb->metadata()) {
+         if (const auto* entry = metadata->LookupByKey(metadata_key(selector)); entry && entry->value()) {
+            const auto* text = entry->value();
+            checksum += text->size();
+            if (text->size() > 0) checksum += static_cast<unsigned char>(text->c_str()[selector % text->size()]);
+         }
+      }
+      return checksum;
+   }
+};
+
+// ============================================================================
+// Benchmark Driver
+// ============================================================================
+
+template <class Workload>
+bool run_workload(const typename Workload::native& value) {
+   using native = typename Workload::native;
+
+   std::string zmem_buffer;
+   if (auto ec = glz::write_zmem(value, zmem_buffer); ec) {
+      std::cerr << "ZMEM write error: " << glz::format_error(ec, zmem_buffer) << "\n";
+      return false;
+   }
+   // The decode timed below must reproduce the source
+   {
+      native decoded{};
+      if (auto ec = glz::read_zmem(decoded, zmem_buffer); ec) {
+         std::cerr << "ZMEM read error: " << glz::format_error(ec, zmem_buffer) << "\n";
+         return false;
+      }
+      if (!(decoded == value)) {
+         std::cerr << Workload::name << ": ZMEM decode differs from the source\n";
+         return false;
+      }
+   }
+
+   std::vector<kj::byte> capnp_buffer;
+   {
+      ::capnp::MallocMessageBuilder message;
+      Workload::populate_capnp(message, value);
+      auto array = messageToFlatArray(message);
+      auto bytes = array.asBytes();
+      capnp_buffer.assign(bytes.begin(), bytes.end());
+   }
+   const kj::ArrayPtr<const capnp::word> capnp_words(reinterpret_cast<const capnp::word*>(capnp_buffer.data()),
+                                                     capnp_buffer.size() / sizeof(capnp::word));
+
+   std::vector<uint8_t> flatbuf_buffer;
+   {
+      flatbuffers::FlatBufferBuilder builder(1024);
+      builder.Finish(Workload::build_flatbuffer(builder, value));
+      flatbuf_buffer.assign(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+   }
+
+   std::cout << "\n" << Workload::name << "\n";
+   std::cout << "ZMEM serialized size:        " << zmem_buffer.size() << " bytes\n";
+   std::cout << "Cap'n Proto serialized size: " << capnp_buffer.size() << " bytes\n";
+   std::cout << "FlatBuffers serialized size: " << flatbuf_buffer.size() << " bytes\n\n";
+
+   // --------------------------------------------------------------------------
+   // Write and Read
+   // --------------------------------------------------------------------------
+
+   bencher::stage stage{std::string(Workload::name)};
+   stage.baseline = "FlatBuffers Write";
+
+   std::string zmem_write_buffer;
+   zmem_write_buffer.reserve(zmem_buffer.size() * 2);
+   stage.run("ZMEM Write", [&] {
+      zmem_write_buffer.clear();
+      (void)glz::write_zmem(value, zmem_write_buffer);
+      bencher::do_not_optimize(zmem_write_buffer);
+      return zmem_write_buffer.size();
+   });
+
+   stage.run("Cap'n Proto Write", [&] {
+      ::capnp::MallocMessageBuilder message;
+      Workload::populate_capnp(message, value);
+      auto array = messageToFlatArray(message);
+      bencher::do_not_optimize(array);
+      return array.asBytes().size();
+   });
+
+   flatbuffers::FlatBufferBuilder fb_builder(1024);
+   stage.run("FlatBuffers Write", [&] {
+      fb_builder.Clear();
+      fb_builder.Finish(Workload::build_flatbuffer(fb_builder, value));
+      bencher::do_not_optimize(fb_builder.GetBufferPointer());
+      return fb_builder.GetSize();
+   });
+
+   native zmem_result;
+   stage.run("ZMEM Read", [&] {
+      (void)glz::read_zmem(zmem_result, zmem_buffer);
+      bencher::do_not_optimize(zmem_result);
+      return zmem_buffer.size();
+   });
+
+   stage.run("Cap'n Proto Read", [&] {
+      ::capnp::FlatArrayMessageReader message(capnp_words);
+      auto result = Workload::read_capnp(message);
+      bencher::do_not_optimize(result);
+      return capnp_buffer.size();
+   });
+
+   stage.run("FlatBuffers Read", [&] {
+      auto result = Workload::read_flatbuffer(flatbuffers::GetRoot<typename Workload::flatbuffer_root>(
+         flatbuf_buffer.data()));
+      bencher::do_not_optimize(result);
+      return flatbuf_buffer.size();
+   });
+
+   bencher::print_results(stage);
+
+   const std::string file = std::string("results_workload_") + Workload::file;
+   bencher::save_file(bencher::to_markdown(stage), file + ".md");
+
+   chart_config chart_cfg;
+   chart_cfg.margin_bottom = 140;
+   chart_cfg.font_size_bar_label = 16.0;
+   bencher::save_file(bencher::bar_chart(stage, chart_cfg), file + ".svg");
+
+   // --------------------------------------------------------------------------
+   // Zero-Copy Access
+   // --------------------------------------------------------------------------
+
+   bencher::stage zero_copy_stage{std::string("Zero-Copy Access (") + Workload::name + ")"};
+   zero_copy_stage.baseline = "FlatBuffers";
+   zero_copy_stage.throughput_units_divisor = 1e3;
+   zero_copy_stage.throughput_units_label = "Kops/s";
+   zero_copy_stage.processed_units_label = "Ops";
+   zero_copy_stage.cold_cache = false;
+
+   constexpr size_t zero_copy_batch = 16 * 1024;
+
+   zero_copy_stage.run("ZMEM", [&] {
+      uint32_t state = 0x12345678u;
+      size_t checksum = 0;
+      for (size_t i = 0; i < zero_copy_batch; ++i) {
+         state = mix_u32(state + static_cast<uint32_t>(checksum));
+         checksum += Workload::access_zmem(zmem_buffer, state);
+      }
+      volatile size_t sink = checksum;
+      bencher::do_not_optimize(sink);
+      return zero_copy_batch;
+   });
+
+   zero_copy_stage.run("Cap'n Proto", [&] {
+      ::capnp::FlatArrayMessageReader message(capnp_words, unlimited_reader_options());
+      uint32_t state = 0x87654321u;
+      size_t checksum = 0;
+      for (size_t i = 0; i < zero_copy_batch; ++i) {
+         state = mix_u32(state + static_cast<uint32_t>(checksum));
+         checksum += Workload::access_capnp(message, state);
+      }
+      volatile size_t sink = checksum;
+      bencher::do_not_optimize(sink);
+      return zero_copy_batch;
+   });
+
+   zero_copy_stage.run("FlatBuffers", [&] {
+      auto fb = flatbuffers::GetRoot<typename Workload::flatbuffer_root>(flatbuf_buffer.data());
+      uint32_t state = 0x13572468u;
+      size_t checksum = 0;
+      for (size_t i = 0; i < zero_copy_batch; ++i) {
+         state = mix_u32(state + static_cast<uint32_t>(checksum));
+         checksum += Workload::access_flatbuffer(fb, state);
+      }
+      volatile size_t sink = checksum;
+      bencher::do_not_optimize(sink);
+      return zero_copy_batch;
+   });
+
+   bencher::print_results(zero_copy_stage);
+
+   bencher::save_file(bencher::to_markdown(zero_copy_stage), file + "_zero_copy.md");
+
+   chart_config zero_copy_cfg;
+   zero_copy_cfg.margin_bottom = 100;
+   zero_copy_cfg.font_size_bar_label = 20.0;
+   zero_copy_cfg.y_axis_label = zero_copy_stage.throughput_units_label;
+   bencher::save_file(bencher::bar_chart(zero_copy_stage, zero_copy_cfg), file + "_zero_copy.svg");
+   return true;
+}
+
+// ============================================================================
+// Main Benchmark
+// ============================================================================
+
+int main() {
+   const bool ok = run_workload<order_book_workload>(workloads::make_order_book_update()) &&
+                   run_workload<world_snapshot_workload>(workloads::make_world_snapshot()) &&
+                   run_workload<ml_batch_workload>(workloads::make_ml_batch());
+   return ok ? 0 : 1;
+}
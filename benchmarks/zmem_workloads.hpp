@@ -0,0 +1,200 @@
+// ZMEM Workload Fixtures
+// Realistic messages for format comparisons: an L2 order book update, a game world
+// snapshot and an ML training batch. The schemas are in benchmarks/workloads.zmem
+// (and workloads.capnp / workloads.fbs for the other formats).
+
+#pragma once
+
+#include "zmem_half.hpp"
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace workloads {
+
+// ============================================================================
+// L2 Order Book Update
+// ============================================================================
+
+struct BookHeader {
+   uint32_t instrument_id{};
+   uint16_t venue{};
+   uint16_t flags{};
+   uint64_t sequence{};
+   uint64_t exchange_ts_ns{};
+   uint64_t receive_ts_ns{};
+
+   bool operator==(const BookHeader&) const = default;
+};
+
+struct Level {
+   int64_t price{}; // Ticks
+   uint32_t quantity{};
+   uint32_t order_count{};
+
+   bool operator==(const Level&) const = default;
+};
+
+struct OrderBookUpdate {
+   BookHeader header{};
+   std::vector<Level> bids{}; // Best first
+   std::vector<Level> asks{}; // Best first
+
+   bool operator==(const OrderBookUpdate&) const = default;
+};
+
+// ============================================================================
+// Game World Snapshot
+// ============================================================================
+
+struct Vec3 {
+   float x{};
+   float y{};
+   float z{};
+
+   bool operator==(const Vec3&) const = default;
+};
+
+struct Quat {
+   float x{};
+   float y{};
+   float z{};
+   float w{1.0f};
+
+   bool operator==(const Quat&) const = default;
+};
+
+struct Transform {
+   Vec3 position{};
+   Quat rotation{};
+
+   bool operator==(const Transform&) const = default;
+};
+
+struct Item {
+   uint32_t item_id{};
+   uint16_t count{};
+   uint16_t durability{};
+
+   bool operator==(const Item&) const = default;
+};
+
+struct Entity {
+   uint64_t id{};
+   uint16_t kind{};
+   uint8_t team{};
+   uint8_t flags{};
+   float health{};
+   Transform transform{};
+   Vec3 velocity{};
+   std::string name{};
+   std::vector<Vec3> waypoints{};
+   std::vector<Item> inventory{};
+
+   bool operator==(const Entity&) const = default;
+};
+
+struct WorldSnapshot {
+   uint64_t tick{};
+   uint64_t server_time_ns{};
+   std::vector<Entity> entities{};
+
+   bool operator==(const WorldSnapshot&) const = default;
+};
+
+// ============================================================================
+// ML Batch
+// ============================================================================
+
+struct Tensor {
+   std::string name{};
+   std::vector<uint32_t> shape{};
+   std::vector<uint16_t> values{}; // `[bf16]`, row-major
+
+   bool operator==(const Tensor&) const = default;
+};
+
+struct MlBatch {
+   uint64_t step{};
+   uint32_t batch_size{};
+   std::vector<Tensor> tensors{};
+   std::map<uint32_t, std::string> metadata{};
+
+   bool operator==(const MlBatch&) const = default;
+};
+
+// ============================================================================
+// Generators
+// ============================================================================
+
+// Both sides of a book `depth` levels deep around a mid price, one tick apart
+inline OrderBookUpdate make_order_book_update(size_t depth = 20) {
+   std::mt19937_64 rng{42};
+   OrderBookUpdate update;
+   update.header = {7203, 3, 0x1, 918'273'645, 1'700'000'000'000'000'000ull, 1'700'000'000'000'042'500ull};
+   const int64_t mid = 1'000'000;
+   update.bids.resize(depth);
+   update.asks.resize(depth);
+   for (size_t i = 0; i < depth; ++i) {
+      update.bids[i] = {mid - 1 - int64_t(i), uint32_t(100 + rng() % 5000), uint32_t(1 + rng() % 40)};
+      update.asks[i] = {mid + 1 + int64_t(i), uint32_t(100 + rng() % 5000), uint32_t(1 + rng() % 40)};
+   }
+   return update;
+}
+
+// Entities with 0-15 waypoints and 0-11 inventory items each
+inline WorldSnapshot make_world_snapshot(size_t entities = 256) {
+   std::mt19937_64 rng{42};
+   std::uniform_real_distribution<float> coord{-500.0f, 500.0f};
+   WorldSnapshot snapshot{48'213, 1'700'000'000'000'000'000ull, {}};
+   snapshot.entities.resize(entities);
+   for (size_t i = 0; i < entities; ++i) {
+      Entity& e = snapshot.entities[i];
+      e.id = 1'000'000 + i;
+      e.kind = uint16_t(rng() % 12);
+      e.team = uint8_t(rng() % 4);
+      e.flags = uint8_t(rng() % 256);
+      e.health = float(rng() % 1000) * 0.1f;
+      e.transform.position = {coord(rng), coord(rng), coord(rng) * 0.1f};
+      e.transform.rotation = {0.0f, 0.0f, 0.3826834f, 0.9238795f};
+      e.velocity = {coord(rng) * 0.01f, coord(rng) * 0.01f, 0.0f};
+      e.name = (e.kind == 0 ? "player-" : "npc-") + std::to_string(e.id);
+      e.waypoints.resize(rng() % 16);
+      for (auto& w : e.waypoints) w = {coord(rng), coord(rng), 0.0f};
+      e.inventory.resize(rng() % 12);
+      for (auto& item : e.inventory) {
+         item = {uint32_t(rng() % 5000), uint16_t(1 + rng() % 99), uint16_t(rng() % 1000)};
+      }
+   }
+   return snapshot;
+}
+
+// Dense features, embeddings and labels for `batch_size` rows, quantized to bf16,
+// plus string metadata keyed by u32 ids
+inline MlBatch make_ml_batch(uint32_t batch_size = 32, uint32_t features = 256, uint32_t embedding_dim = 64) {
+   std::mt19937_64 rng{42};
+   std::normal_distribution<float> normal{0.0f, 1.0f};
+   auto tensor = [&](std::string name, std::vector<uint32_t> shape) {
+      size_t count = 1;
+      for (uint32_t d : shape) count *= d;
+      std::vector<float> values(count);
+      for (auto& v : values) v = normal(rng);
+      Tensor t{std::move(name), std::move(shape), {}};
+      zmem::quantize_bf16(values, t.values);
+      return t;
+   };
+
+   MlBatch batch{120'000, batch_size, {}, {}};
+   batch.tensors.push_back(tensor("features", {batch_size, features}));
+   batch.tensors.push_back(tensor("embeddings", {batch_size, embedding_dim}));
+   batch.tensors.push_back(tensor("labels", {batch_size}));
+   for (uint32_t i = 0; i < 16; ++i) {
+      batch.metadata.emplace(i * 7 + 1, "shard-" + std::to_string(i) + "/part-" + std::to_string(rng() % 10000));
+   }
+   return batch;
+}
+
+} // namespace workloads